@@ -0,0 +1,36 @@
+# Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License").
+# You may not use this file except in compliance with the License.
+# A copy of the License is located at
+#
+#  http://aws.amazon.com/apache2.0
+#
+# or in the "license" file accompanying this file. This file is distributed
+# on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+# express or implied. See the License for the specific language governing
+# permissions and limitations under the License.
+
+include(AwsCFlags)
+include(AwsSanitizers)
+
+option(ENABLE_BENCHMARKS "Build micro-benchmark executables" OFF)
+
+# Adds one standalone executable per benchmark file. Benchmarks are not registered with ctest, since
+# their run time and output depend on the machine; run them by hand.
+# Options:
+#  benchmark_files: The list of benchmark source files, each providing its own main()
+#  other_files: Other files to link into each benchmark
+function(aws_add_benchmarks benchmark_files other_files)
+    if(ENABLE_BENCHMARKS)
+        foreach(benchmark_file ${benchmark_files})
+            get_filename_component(BENCHMARK_FILE_NAME ${benchmark_file} NAME_WE)
+
+            set(BENCHMARK_BINARY_NAME ${CMAKE_PROJECT_NAME}-benchmark-${BENCHMARK_FILE_NAME})
+            add_executable(${BENCHMARK_BINARY_NAME} ${benchmark_file} ${other_files})
+            target_link_libraries(${BENCHMARK_BINARY_NAME} PRIVATE ${CMAKE_PROJECT_NAME})
+            aws_set_common_properties(${BENCHMARK_BINARY_NAME} NO_WEXTRA NO_PEDANTIC)
+            target_include_directories(${BENCHMARK_BINARY_NAME} PRIVATE ${CMAKE_CURRENT_LIST_DIR})
+        endforeach()
+    endif()
+endfunction()
@@ -0,0 +1,79 @@
+#ifndef AWS_COMMON_ADAPTIVE_MUTEX_H
+#define AWS_COMMON_ADAPTIVE_MUTEX_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/atomics.h>
+#include <aws/common/common.h>
+
+#if !defined(__linux__)
+#    include <aws/common/condition_variable.h>
+#    include <aws/common/mutex.h>
+#endif
+
+/**
+ * Non-recursive mutex for short critical sections. An uncontended lock or unlock is a single atomic operation. Under
+ * contention, a locker first spins for a bounded time with an exponential pause backoff, on the assumption that the
+ * holder will release the lock soon, and only then parks in the kernel (a futex on Linux, a condition variable
+ * elsewhere). Unlock only enters the kernel when a thread may be parked.
+ *
+ * Prefer aws_mutex for critical sections that can block or run long: spinning then only burns CPU.
+ */
+struct aws_adaptive_mutex {
+    /* 0: unlocked, 1: locked, 2: locked and a thread may be parked */
+    struct aws_atomic_var state;
+    /* number of spin iterations before parking; 0 on single-CPU machines */
+    size_t spin_limit;
+#if !defined(__linux__)
+    struct aws_mutex park_mutex;
+    struct aws_condition_variable park_signal;
+#endif
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Initializes the mutex.
+ */
+AWS_COMMON_API
+int aws_adaptive_mutex_init(struct aws_adaptive_mutex *mutex);
+
+/**
+ * Cleans up internal resources. The mutex must be unlocked.
+ */
+AWS_COMMON_API
+void aws_adaptive_mutex_clean_up(struct aws_adaptive_mutex *mutex);
+
+/**
+ * Blocks until it acquires the lock, spinning briefly before sleeping. The mutex is not reentrant.
+ */
+AWS_COMMON_API
+int aws_adaptive_mutex_lock(struct aws_adaptive_mutex *mutex);
+
+/**
+ * Attempts to acquire the lock but returns immediately if it can not, raising AWS_ERROR_MUTEX_TIMEOUT.
+ */
+AWS_COMMON_API
+int aws_adaptive_mutex_try_lock(struct aws_adaptive_mutex *mutex);
+
+/**
+ * Releases the lock, waking one parked thread if there is one.
+ */
+AWS_COMMON_API
+int aws_adaptive_mutex_unlock(struct aws_adaptive_mutex *mutex);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_COMMON_ADAPTIVE_MUTEX_H */
@@ -368,6 +368,14 @@ size_t aws_atomic_fetch_xor(volatile struct aws_atomic_var *var, size_t n) {
 AWS_STATIC_IMPL
 void aws_atomic_thread_fence(enum aws_memory_order order);
 
+/**
+ * Hints to the processor that the calling thread is busy-waiting, e.g. in a spin lock. On x86 this issues PAUSE and on
+ * ARM it issues YIELD, which reduces power use and frees resources for a sibling hyperthread. It has no memory
+ * ordering effects beyond a compiler barrier.
+ */
+AWS_STATIC_IMPL
+void aws_atomic_spin_hint(void);
+
 #include <aws/common/atomics_fallback.inl>
 
 #endif
@@ -266,4 +266,15 @@ void aws_atomic_thread_fence(enum aws_memory_order order) {
     __sync_synchronize();
 }
 
+AWS_STATIC_IMPL
+void aws_atomic_spin_hint(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __asm__ __volatile__("pause" ::: "memory");
+#elif defined(__aarch64__) || (defined(__arm__) && defined(__ARM_ARCH) && __ARM_ARCH >= 7)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
 #define AWS_ATOMICS_HAVE_THREAD_FENCE
@@ -355,4 +355,14 @@ void aws_atomic_thread_fence(enum aws_memory_order order) {
     }
 }
 
+AWS_STATIC_IMPL
+void aws_atomic_spin_hint(void) {
+#if defined(_M_IX86) || defined(_M_X64)
+    _mm_pause();
+#elif defined(_M_ARM) || defined(_M_ARM64)
+    __yield();
+#endif
+    _ReadWriteBarrier();
+}
+
 #define AWS_ATOMICS_HAVE_THREAD_FENCE
@@ -65,11 +65,27 @@ struct aws_byte_cursor {
  */
 #define AWS_BYTE_BUF_PRI(B) ((int)(B).len < 0 ? 0 : (int)(B).len), (const char *)(B).buffer
 
+/**
+ * The maximum number of bytes in an unsigned LEB128 encoding of a 64-bit value.
+ */
+#define AWS_VARINT_U64_MAX_LEN 10
+
 /**
  * Signature for function argument to trim APIs
  */
 typedef bool (*aws_byte_predicate_fn)(uint8_t value);
 
+/**
+ * A set of byte values, stored as a 256-bit membership mask (bit n set means byte value n is a member).
+ *
+ * The *_class trim and scan APIs test membership with a table lookup per byte, instead of making an indirect call
+ * per byte through an aws_byte_predicate_fn. Use the predefined classes below, or build one with
+ * aws_byte_class_init / aws_byte_class_init_from_pred.
+ */
+struct aws_byte_class {
+    uint64_t mask[4];
+};
+
 AWS_EXTERN_C_BEGIN
 
 AWS_COMMON_API
@@ -185,6 +201,44 @@ int aws_byte_cursor_split_on_char_n(
     size_t n,
     struct aws_array_list *AWS_RESTRICT output);
 
+/**
+ * No copies, no buffer allocations. Searches input_str for the first instance of value.
+ *
+ * If found, returns true and sets result to the remainder of input_str, beginning at the match.
+ * Otherwise, returns false and result is zeroed.
+ */
+AWS_COMMON_API
+bool aws_byte_cursor_find_byte(
+    const struct aws_byte_cursor *AWS_RESTRICT input_str,
+    uint8_t value,
+    struct aws_byte_cursor *AWS_RESTRICT result);
+
+/**
+ * No copies, no buffer allocations. Searches input_str for the first byte that appears anywhere in byte_set.
+ * Small sets (the common case of a handful of delimiters) are matched with SIMD when the CPU supports it.
+ *
+ * If found, returns true and sets result to the remainder of input_str, beginning at the match.
+ * Otherwise (including when byte_set is empty), returns false and result is zeroed.
+ */
+AWS_COMMON_API
+bool aws_byte_cursor_find_any_of(
+    const struct aws_byte_cursor *AWS_RESTRICT input_str,
+    const struct aws_byte_cursor *AWS_RESTRICT byte_set,
+    struct aws_byte_cursor *AWS_RESTRICT result);
+
+/**
+ * No copies, no buffer allocations. Searches input_str for the first instance of to_find.
+ * An empty to_find matches at the beginning of input_str.
+ *
+ * If found, returns true and sets result to the remainder of input_str, beginning at the match.
+ * Otherwise, returns false and result is zeroed.
+ */
+AWS_COMMON_API
+bool aws_byte_cursor_find_substring(
+    const struct aws_byte_cursor *AWS_RESTRICT input_str,
+    const struct aws_byte_cursor *AWS_RESTRICT to_find,
+    struct aws_byte_cursor *AWS_RESTRICT result);
+
 /**
  *
  * Shrinks a byte cursor from the right for as long as the supplied predicate is true
@@ -214,6 +268,69 @@ struct aws_byte_cursor aws_byte_cursor_trim_pred(const struct aws_byte_cursor *s
 AWS_COMMON_API
 bool aws_byte_cursor_satisfies_pred(const struct aws_byte_cursor *source, aws_byte_predicate_fn predicate);
 
+/**
+ * Whitespace, as defined by isspace() in the "C" locale: space, \t, \n, \v, \f and \r.
+ */
+AWS_COMMON_API extern const struct aws_byte_class aws_byte_class_whitespace;
+
+/**
+ * The ASCII decimal digits 0-9.
+ */
+AWS_COMMON_API extern const struct aws_byte_class aws_byte_class_digit;
+
+/**
+ * The ASCII letters and decimal digits.
+ */
+AWS_COMMON_API extern const struct aws_byte_class aws_byte_class_alnum;
+
+/**
+ * HTTP token characters (tchar in RFC 7230 section 3.2.6): ASCII letters, digits and !#$%&'*+-.^_`|~
+ */
+AWS_COMMON_API extern const struct aws_byte_class aws_byte_class_token;
+
+/**
+ * Initializes byte_class to contain exactly the bytes in members.
+ */
+AWS_COMMON_API
+void aws_byte_class_init(struct aws_byte_class *byte_class, const struct aws_byte_cursor *members);
+
+/**
+ * Initializes byte_class to contain exactly the byte values for which predicate returns true.
+ * The predicate is called once for each of the 256 byte values, so this is meant to be done once up front.
+ */
+AWS_COMMON_API
+void aws_byte_class_init_from_pred(struct aws_byte_class *byte_class, aws_byte_predicate_fn predicate);
+
+/**
+ * Shrinks a byte cursor from the right for as long as its bytes are members of byte_class
+ */
+AWS_COMMON_API
+struct aws_byte_cursor aws_byte_cursor_right_trim_class(
+    const struct aws_byte_cursor *source,
+    const struct aws_byte_class *byte_class);
+
+/**
+ * Shrinks a byte cursor from the left for as long as its bytes are members of byte_class
+ */
+AWS_COMMON_API
+struct aws_byte_cursor aws_byte_cursor_left_trim_class(
+    const struct aws_byte_cursor *source,
+    const struct aws_byte_class *byte_class);
+
+/**
+ * Shrinks a byte cursor from both sides for as long as its bytes are members of byte_class
+ */
+AWS_COMMON_API
+struct aws_byte_cursor aws_byte_cursor_trim_class(
+    const struct aws_byte_cursor *source,
+    const struct aws_byte_class *byte_class);
+
+/**
+ * Returns true if every byte in the byte cursor's range is a member of byte_class
+ */
+AWS_COMMON_API
+bool aws_byte_cursor_satisfies_class(const struct aws_byte_cursor *source, const struct aws_byte_class *byte_class);
+
 /**
  * Copies from to to. If to is too small, AWS_ERROR_DEST_COPY_TOO_SMALL will be
  * returned. dest->len will contain the amount of data actually copied to dest.
@@ -264,8 +381,29 @@ uint64_t aws_hash_byte_cursor_ptr_case_insensitive(const void *item);
 AWS_COMMON_API
 bool aws_byte_cursor_eq_byte_buf(const struct aws_byte_cursor *a, const struct aws_byte_buf *b);
 
+/**
+ * Reads up to count unsigned LEB128 varints from cur into out, as if by repeated calls to
+ * aws_byte_cursor_read_varint_u64(). Runs of single byte values, which dominate most real data, are decoded eight at a
+ * time.
+ *
+ * Returns the number of values read. Reading stops early at the end of the cursor or at a truncated or malformed
+ * value. cur is advanced past the values that were read.
+ */
+AWS_COMMON_API
+size_t aws_byte_cursor_read_varint_u64_n(
+    struct aws_byte_cursor *AWS_RESTRICT cur,
+    uint64_t *AWS_RESTRICT out,
+    size_t count);
+
 AWS_EXTERN_C_END
 
+/**
+ * Returns true if value is a member of byte_class.
+ */
+AWS_STATIC_IMPL bool aws_byte_class_contains(const struct aws_byte_class *byte_class, uint8_t value) {
+    return (byte_class->mask[value >> 6] >> (value & 63)) & 1;
+}
+
 /**
  * For creating a byte buffer from a null-terminated string literal.
  */
@@ -561,6 +699,194 @@ AWS_STATIC_IMPL bool aws_byte_cursor_read_be64(struct aws_byte_cursor *cur, uint
     return rv;
 }
 
+/**
+ * Reads a 24-bit value in network byte order from cur, and places it in host
+ * byte order into the low 24 bits of var.
+ *
+ * On success, returns true and updates the cursor pointer/length accordingly.
+ * If there is insufficient space in the cursor, returns false, leaving the
+ * cursor unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_cursor_read_be24(struct aws_byte_cursor *cur, uint32_t *var) {
+    uint8_t bytes[3];
+    bool rv = aws_byte_cursor_read(cur, bytes, sizeof(bytes));
+
+    if (AWS_LIKELY(rv)) {
+        *var = ((uint32_t)bytes[0] << 16) | ((uint32_t)bytes[1] << 8) | bytes[2];
+    }
+
+    return rv;
+}
+
+/**
+ * Reads a 16-bit value in little endian byte order from cur, and places it in host
+ * byte order into var.
+ *
+ * On success, returns true and updates the cursor pointer/length accordingly.
+ * If there is insufficient space in the cursor, returns false, leaving the
+ * cursor unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_cursor_read_le16(struct aws_byte_cursor *cur, uint16_t *var) {
+    bool rv = aws_byte_cursor_read(cur, var, 2);
+
+    if (AWS_LIKELY(rv)) {
+        *var = aws_letoh16(*var);
+    }
+
+    return rv;
+}
+
+/**
+ * Reads a 32-bit value in little endian byte order from cur, and places it in host
+ * byte order into var.
+ *
+ * On success, returns true and updates the cursor pointer/length accordingly.
+ * If there is insufficient space in the cursor, returns false, leaving the
+ * cursor unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_cursor_read_le32(struct aws_byte_cursor *cur, uint32_t *var) {
+    bool rv = aws_byte_cursor_read(cur, var, 4);
+
+    if (AWS_LIKELY(rv)) {
+        *var = aws_letoh32(*var);
+    }
+
+    return rv;
+}
+
+/**
+ * Reads a 64-bit value in little endian byte order from cur, and places it in host
+ * byte order into var.
+ *
+ * On success, returns true and updates the cursor pointer/length accordingly.
+ * If there is insufficient space in the cursor, returns false, leaving the
+ * cursor unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_cursor_read_le64(struct aws_byte_cursor *cur, uint64_t *var) {
+    bool rv = aws_byte_cursor_read(cur, var, sizeof(*var));
+
+    if (AWS_LIKELY(rv)) {
+        *var = aws_letoh64(*var);
+    }
+
+    return rv;
+}
+
+/**
+ * Reads a 32-bit IEEE 754 float in network byte order from cur, and places it into var.
+ *
+ * On success, returns true and updates the cursor pointer/length accordingly.
+ * If there is insufficient space in the cursor, returns false, leaving the
+ * cursor unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_cursor_read_float_be32(struct aws_byte_cursor *cur, float *var) {
+    uint32_t bits;
+    bool rv = aws_byte_cursor_read_be32(cur, &bits);
+
+    if (AWS_LIKELY(rv)) {
+        memcpy(var, &bits, sizeof(*var));
+    }
+
+    return rv;
+}
+
+/**
+ * Reads a 64-bit IEEE 754 double in network byte order from cur, and places it into var.
+ *
+ * On success, returns true and updates the cursor pointer/length accordingly.
+ * If there is insufficient space in the cursor, returns false, leaving the
+ * cursor unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_cursor_read_float_be64(struct aws_byte_cursor *cur, double *var) {
+    uint64_t bits;
+    bool rv = aws_byte_cursor_read_be64(cur, &bits);
+
+    if (AWS_LIKELY(rv)) {
+        memcpy(var, &bits, sizeof(*var));
+    }
+
+    return rv;
+}
+
+/**
+ * Reads a 32-bit IEEE 754 float in little endian byte order from cur, and places it into var.
+ *
+ * On success, returns true and updates the cursor pointer/length accordingly.
+ * If there is insufficient space in the cursor, returns false, leaving the
+ * cursor unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_cursor_read_float_le32(struct aws_byte_cursor *cur, float *var) {
+    uint32_t bits;
+    bool rv = aws_byte_cursor_read_le32(cur, &bits);
+
+    if (AWS_LIKELY(rv)) {
+        memcpy(var, &bits, sizeof(*var));
+    }
+
+    return rv;
+}
+
+/**
+ * Reads a 64-bit IEEE 754 double in little endian byte order from cur, and places it into var.
+ *
+ * On success, returns true and updates the cursor pointer/length accordingly.
+ * If there is insufficient space in the cursor, returns false, leaving the
+ * cursor unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_cursor_read_float_le64(struct aws_byte_cursor *cur, double *var) {
+    uint64_t bits;
+    bool rv = aws_byte_cursor_read_le64(cur, &bits);
+
+    if (AWS_LIKELY(rv)) {
+        memcpy(var, &bits, sizeof(*var));
+    }
+
+    return rv;
+}
+
+/**
+ * Reads an unsigned LEB128 variable-length integer (the varint encoding used by protobuf, among others) from cur,
+ * and places it into var. At most AWS_VARINT_U64_MAX_LEN bytes are consumed; longer encodings, and encodings of
+ * values that don't fit in 64 bits, are rejected.
+ *
+ * The input is bounds checked once up front rather than per byte.
+ *
+ * On success, returns true and updates the cursor pointer/length accordingly.
+ * If the cursor ends before the varint does, or the varint is malformed, returns false, leaving the
+ * cursor unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_cursor_read_varint_u64(
+    struct aws_byte_cursor *AWS_RESTRICT cur,
+    uint64_t *AWS_RESTRICT var) {
+
+    /* Single byte values are by far the most common, so get them out of the way before the loop. */
+    if (AWS_LIKELY(cur->len > 0) && !(cur->ptr[0] & 0x80)) {
+        *var = cur->ptr[0];
+        aws_byte_cursor_advance(cur, 1);
+        return true;
+    }
+
+    size_t max_len = cur->len < AWS_VARINT_U64_MAX_LEN ? cur->len : AWS_VARINT_U64_MAX_LEN;
+    uint64_t value = 0;
+    for (size_t i = 0; i < max_len; ++i) {
+        uint8_t byte = cur->ptr[i];
+        value |= (uint64_t)(byte & 0x7f) << (7 * i);
+
+        if (!(byte & 0x80)) {
+            /* The last possible byte only has room for the top bit of a 64-bit value */
+            if (AWS_UNLIKELY(i == AWS_VARINT_U64_MAX_LEN - 1 && byte > 1)) {
+                return false;
+            }
+
+            *var = value;
+            aws_byte_cursor_advance(cur, i + 1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /**
  * Appends a sub-buffer to the specified buffer.
  *
@@ -684,4 +1010,128 @@ AWS_STATIC_IMPL bool aws_byte_buf_write_be64(struct aws_byte_buf *buf, uint64_t
     return aws_byte_buf_write(buf, (uint8_t *)&x, 8);
 }
 
+/**
+ * Writes the low 24 bits of x in network byte order (big endian) to buffer.
+ *
+ * On success, returns true and updates the buffer /length accordingly.
+ * If x doesn't fit in 24 bits, or there is insufficient space in the buffer,
+ * returns false, leaving the buffer unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_buf_write_be24(struct aws_byte_buf *buf, uint32_t x) {
+    if (x > 0xffffff) {
+        return false;
+    }
+
+    uint8_t bytes[3] = {(uint8_t)(x >> 16), (uint8_t)(x >> 8), (uint8_t)x};
+    return aws_byte_buf_write(buf, bytes, sizeof(bytes));
+}
+
+/**
+ * Writes a 16-bit integer in little endian byte order to buffer.
+ *
+ * On success, returns true and updates the buffer /length accordingly.
+ * If there is insufficient space in the buffer, returns false, leaving the
+ * buffer unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_buf_write_le16(struct aws_byte_buf *buf, uint16_t x) {
+    x = aws_htole16(x);
+    return aws_byte_buf_write(buf, (uint8_t *)&x, 2);
+}
+
+/**
+ * Writes a 32-bit integer in little endian byte order to buffer.
+ *
+ * On success, returns true and updates the buffer /length accordingly.
+ * If there is insufficient space in the buffer, returns false, leaving the
+ * buffer unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_buf_write_le32(struct aws_byte_buf *buf, uint32_t x) {
+    x = aws_htole32(x);
+    return aws_byte_buf_write(buf, (uint8_t *)&x, 4);
+}
+
+/**
+ * Writes a 64-bit integer in little endian byte order to buffer.
+ *
+ * On success, returns true and updates the buffer /length accordingly.
+ * If there is insufficient space in the buffer, returns false, leaving the
+ * buffer unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_buf_write_le64(struct aws_byte_buf *buf, uint64_t x) {
+    x = aws_htole64(x);
+    return aws_byte_buf_write(buf, (uint8_t *)&x, 8);
+}
+
+/**
+ * Writes a 32-bit IEEE 754 float in network byte order (big endian) to buffer.
+ *
+ * On success, returns true and updates the buffer /length accordingly.
+ * If there is insufficient space in the buffer, returns false, leaving the
+ * buffer unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_buf_write_float_be32(struct aws_byte_buf *buf, float x) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return aws_byte_buf_write_be32(buf, bits);
+}
+
+/**
+ * Writes a 64-bit IEEE 754 double in network byte order (big endian) to buffer.
+ *
+ * On success, returns true and updates the buffer /length accordingly.
+ * If there is insufficient space in the buffer, returns false, leaving the
+ * buffer unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_buf_write_float_be64(struct aws_byte_buf *buf, double x) {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return aws_byte_buf_write_be64(buf, bits);
+}
+
+/**
+ * Writes a 32-bit IEEE 754 float in little endian byte order to buffer.
+ *
+ * On success, returns true and updates the buffer /length accordingly.
+ * If there is insufficient space in the buffer, returns false, leaving the
+ * buffer unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_buf_write_float_le32(struct aws_byte_buf *buf, float x) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return aws_byte_buf_write_le32(buf, bits);
+}
+
+/**
+ * Writes a 64-bit IEEE 754 double in little endian byte order to buffer.
+ *
+ * On success, returns true and updates the buffer /length accordingly.
+ * If there is insufficient space in the buffer, returns false, leaving the
+ * buffer unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_buf_write_float_le64(struct aws_byte_buf *buf, double x) {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return aws_byte_buf_write_le64(buf, bits);
+}
+
+/**
+ * Writes x to buffer as an unsigned LEB128 variable-length integer (1 to AWS_VARINT_U64_MAX_LEN bytes).
+ *
+ * On success, returns true and updates the buffer /length accordingly.
+ * If there is insufficient space in the buffer, returns false, leaving the
+ * buffer unchanged.
+ */
+AWS_STATIC_IMPL bool aws_byte_buf_write_varint_u64(struct aws_byte_buf *AWS_RESTRICT buf, uint64_t x) {
+    uint8_t encoded[AWS_VARINT_U64_MAX_LEN];
+    size_t len = 0;
+
+    while (x >= 0x80) {
+        encoded[len++] = (uint8_t)(x | 0x80);
+        x >>= 7;
+    }
+    encoded[len++] = (uint8_t)x;
+
+    return aws_byte_buf_write(buf, encoded, len);
+}
+
 #endif /* AWS_COMMON_BYTE_BUF_H */
@@ -106,4 +106,60 @@ AWS_STATIC_IMPL uint16_t aws_ntoh16(uint16_t x) {
 #endif
 }
 
+/*
+ * Little endian conversions. These are no-ops on little endian hosts, where the aws_is_big_endian() check is
+ * optimized out.
+ */
+
+/**
+ * Convert 16 bit integer from host to little endian byte order.
+ */
+AWS_STATIC_IMPL uint16_t aws_htole16(uint16_t x) {
+    if (!aws_is_big_endian()) {
+        return x;
+    }
+    return (uint16_t)((x >> 8) | (x << 8));
+}
+
+/**
+ * Convert 16 bit integer from little endian to host byte order.
+ */
+AWS_STATIC_IMPL uint16_t aws_letoh16(uint16_t x) {
+    return aws_htole16(x);
+}
+
+/**
+ * Convert 32 bit integer from host to little endian byte order.
+ */
+AWS_STATIC_IMPL uint32_t aws_htole32(uint32_t x) {
+    if (!aws_is_big_endian()) {
+        return x;
+    }
+    return (x >> 24) | ((x >> 8) & 0xff00) | ((x << 8) & 0xff0000) | (x << 24);
+}
+
+/**
+ * Convert 32 bit integer from little endian to host byte order.
+ */
+AWS_STATIC_IMPL uint32_t aws_letoh32(uint32_t x) {
+    return aws_htole32(x);
+}
+
+/**
+ * Convert 64 bit integer from host to little endian byte order.
+ */
+AWS_STATIC_IMPL uint64_t aws_htole64(uint64_t x) {
+    if (!aws_is_big_endian()) {
+        return x;
+    }
+    return ((uint64_t)aws_htole32((uint32_t)x) << 32) | aws_htole32((uint32_t)(x >> 32));
+}
+
+/**
+ * Convert 64 bit integer from little endian to host byte order.
+ */
+AWS_STATIC_IMPL uint64_t aws_letoh64(uint64_t x) {
+    return aws_htole64(x);
+}
+
 #endif /* AWS_COMMON_BYTE_ORDER_H */
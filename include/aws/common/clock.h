@@ -72,6 +72,63 @@ int aws_high_res_clock_get_ticks(uint64_t *timestamp);
 AWS_COMMON_API
 int aws_sys_clock_get_ticks(uint64_t *timestamp);
 
+/**
+ * Like aws_sys_clock_get_ticks(), but only accurate to a few milliseconds: it reads the kernel's per-tick copy of the
+ * time (CLOCK_REALTIME_COARSE on Linux), which never needs a syscall or a hardware counter read. Falls back to
+ * aws_sys_clock_get_ticks() where no coarse clock exists.
+ */
+AWS_COMMON_API
+int aws_sys_clock_get_ticks_coarse(uint64_t *timestamp);
+
+/**
+ * Stores the current system time in a per-thread cache read by aws_sys_clock_get_ticks_cached(). Event loops call this
+ * once per iteration, so that everything run by the iteration sees the same timestamp without reading the clock.
+ */
+AWS_COMMON_API
+int aws_sys_clock_cache_refresh(void);
+
+/**
+ * Stops the calling thread from using its cached time, e.g. when an event loop stops running on it.
+ */
+AWS_COMMON_API
+void aws_sys_clock_cache_clear(void);
+
+/**
+ * Returns the calling thread's cached system time if it has one, and otherwise reads aws_sys_clock_get_ticks_coarse().
+ * The cached time is as stale as the last aws_sys_clock_cache_refresh() on this thread, so this is only for timestamps
+ * that need millisecond precision at best, such as log lines, request dates and cache expiry.
+ */
+AWS_COMMON_API
+int aws_sys_clock_get_ticks_cached(uint64_t *timestamp);
+
+/**
+ * Reads a cheap monotonic tick counter, for timing hot paths where even a vDSO clock read is too expensive. On x86-64
+ * with an invariant TSC this is rdtsc, and on aarch64 the virtual counter; elsewhere it falls back to the high
+ * resolution clock in nanoseconds. Ticks are only meaningful relative to each other and must be converted with
+ * aws_fast_clock_ticks_to_ns(). The first call may take a few milliseconds to calibrate the counter.
+ */
+AWS_COMMON_API
+uint64_t aws_fast_clock_get_ticks(void);
+
+/**
+ * Converts a number of ticks returned by aws_fast_clock_get_ticks(), usually the difference of two readings, to
+ * nanoseconds.
+ */
+AWS_COMMON_API
+uint64_t aws_fast_clock_ticks_to_ns(uint64_t ticks);
+
+/**
+ * Returns the number of fast clock ticks per second.
+ */
+AWS_COMMON_API
+uint64_t aws_fast_clock_get_frequency(void);
+
+/**
+ * Returns true if the fast clock reads a hardware counter, false if it falls back to the high resolution clock.
+ */
+AWS_COMMON_API
+bool aws_fast_clock_is_hardware_counter(void);
+
 AWS_EXTERN_C_END
 
 #endif /* AWS_COMMON_CLOCK_H */
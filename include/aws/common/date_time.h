@@ -21,11 +21,16 @@
 #define AWS_DATE_TIME_STR_MAX_LEN 100
 
 struct aws_byte_buf;
+struct aws_byte_cursor;
 
 enum aws_date_format {
+    /* RFC 822 with a four digit year, i.e. RFC 1123 and the HTTP Date format: Thu, 01 Jan 1970 00:00:00 GMT */
     AWS_DATE_FORMAT_RFC822,
+    /* ISO 8601 extended format: 1970-01-01T00:00:00Z */
     AWS_DATE_FORMAT_ISO_8601,
     AWS_DATE_FORMAT_AUTO_DETECT,
+    /* ISO 8601 basic format, as in x-amz-date: 19700101T000000Z */
+    AWS_DATE_FORMAT_ISO_8601_BASIC,
 };
 
 enum aws_date_month {
@@ -54,11 +59,28 @@ enum aws_date_day_of_week {
 };
 
 struct aws_date_time {
+    /* whole seconds since the unix epoch, rounded down */
     time_t timestamp;
+    /* the sub-second part of the time, 0 to 999999999 */
+    uint32_t nanoseconds;
     char tz[6];
     struct tm gmt_time;
+    /* only valid if local_time_set; the accessors compute local time on demand otherwise */
     struct tm local_time;
     bool utc_assumed;
+    bool local_time_set;
+};
+
+/**
+ * Remembers the last string formatted for one format, so that a thread stamping many requests or log lines with the
+ * current time only formats it once per second. Not thread safe: use one cache per thread or connection.
+ */
+struct aws_date_time_str_cache {
+    enum aws_date_format fmt;
+    bool short_form;
+    time_t timestamp;
+    size_t len;
+    uint8_t str[AWS_DATE_TIME_STR_MAX_LEN];
 };
 
 AWS_EXTERN_C_BEGIN
@@ -68,13 +90,25 @@ AWS_EXTERN_C_BEGIN
  */
 AWS_COMMON_API void aws_date_time_init_now(struct aws_date_time *dt);
 
+/**
+ * Initializes dt to the calling thread's cached system time, see aws_sys_clock_get_ticks_cached(). This avoids reading
+ * the clock on per-request paths where a timestamp as of the current event loop iteration is good enough.
+ */
+AWS_COMMON_API void aws_date_time_init_now_cached(struct aws_date_time *dt);
+
+/**
+ * Initializes dt to be the time represented in nanoseconds since unix epoch.
+ */
+AWS_COMMON_API void aws_date_time_init_epoch_nanos(struct aws_date_time *dt, uint64_t ns_since_epoch);
+
 /**
  * Initializes dt to be the time represented in milliseconds since unix epoch.
  */
 AWS_COMMON_API void aws_date_time_init_epoch_millis(struct aws_date_time *dt, uint64_t ms_since_epoch);
 
 /**
- * Initializes dt to be the time represented in seconds.millis since unix epoch.
+ * Initializes dt to be the time represented in seconds since unix epoch. The fraction is kept to the precision of a
+ * double, about a microsecond for current dates.
  */
 AWS_COMMON_API void aws_date_time_init_epoch_secs(struct aws_date_time *dt, double sec_ms);
 
@@ -89,12 +123,21 @@ AWS_COMMON_API void aws_date_time_init_epoch_secs(struct aws_date_time *dt, doub
  * from UTC (e.g. +0100, -0700), parsing will fail.
  *
  * Really, it's just better if you always use Universal Time.
+ *
+ * Fractional seconds in the ISO 8601 formats (e.g. 2002-10-02T08:05:09.123Z) are kept to nanosecond precision; digits
+ * past the ninth are ignored.
  */
 AWS_COMMON_API int aws_date_time_init_from_str(
     struct aws_date_time *dt,
     const struct aws_byte_buf *date_str,
     enum aws_date_format fmt);
 
+/**
+ * Computes and stores dt's local time. Initialization only computes GMT, and accessors asking for local time otherwise
+ * compute it on every call, which takes a libc lock; call this first when reading several local time fields.
+ */
+AWS_COMMON_API void aws_date_time_compute_local_time(struct aws_date_time *dt);
+
 /**
  * Copies the current time as a formatted date string in local time into output_buf. If buffer is too small, it will
  * return AWS_OP_ERR. A good size suggestion is AWS_DATE_TIME_STR_MAX_LEN bytes. AWS_DATE_FORMAT_AUTO_DETECT is not
@@ -115,6 +158,17 @@ AWS_COMMON_API int aws_date_time_to_utc_time_str(
     enum aws_date_format fmt,
     struct aws_byte_buf *output_buf);
 
+/**
+ * Like aws_date_time_to_utc_time_str(), but writes the seconds with fraction_digits (1 to 9) digits of fraction, e.g.
+ * 2002-10-02T08:05:09.123Z for 3. The fraction is truncated, not rounded. Only the ISO 8601 formats have fractional
+ * seconds; with AWS_DATE_FORMAT_RFC822 or fraction_digits outside 1 to 9 it raises AWS_ERROR_INVALID_ARGUMENT.
+ */
+AWS_COMMON_API int aws_date_time_to_utc_time_str_with_fraction(
+    const struct aws_date_time *dt,
+    enum aws_date_format fmt,
+    uint8_t fraction_digits,
+    struct aws_byte_buf *output_buf);
+
 /**
  * Copies the current time as a formatted short date string in local time into output_buf. If buffer is too small, it
  * will return AWS_OP_ERR. A good size suggestion is AWS_DATE_TIME_STR_MAX_LEN bytes. AWS_DATE_FORMAT_AUTO_DETECT is not
@@ -135,8 +189,27 @@ AWS_COMMON_API int aws_date_time_to_utc_time_short_str(
     enum aws_date_format fmt,
     struct aws_byte_buf *output_buf);
 
+/**
+ * Initializes a cache of UTC strings in format fmt, or its short (date only) form if short_form is set.
+ * AWS_DATE_FORMAT_AUTO_DETECT is not allowed.
+ */
+AWS_COMMON_API void aws_date_time_str_cache_init(
+    struct aws_date_time_str_cache *cache,
+    enum aws_date_format fmt,
+    bool short_form);
+
+/**
+ * Points output at dt formatted as a UTC string, reusing the cached string if dt falls in the same second as the last
+ * call. output stays valid until the next call with this cache.
+ */
+AWS_COMMON_API int aws_date_time_str_cache_get_utc(
+    struct aws_date_time_str_cache *cache,
+    const struct aws_date_time *dt,
+    struct aws_byte_cursor *output);
+
 AWS_COMMON_API double aws_date_time_as_epoch_secs(const struct aws_date_time *dt);
 AWS_COMMON_API uint64_t aws_date_time_as_nanos(const struct aws_date_time *dt);
+AWS_COMMON_API uint64_t aws_date_time_as_micros(const struct aws_date_time *dt);
 AWS_COMMON_API uint64_t aws_date_time_as_millis(const struct aws_date_time *dt);
 AWS_COMMON_API uint16_t aws_date_time_year(const struct aws_date_time *dt, bool local_time);
 AWS_COMMON_API enum aws_date_month aws_date_time_month(const struct aws_date_time *dt, bool local_time);
@@ -145,6 +218,10 @@ AWS_COMMON_API enum aws_date_day_of_week aws_date_time_day_of_week(const struct
 AWS_COMMON_API uint8_t aws_date_time_hour(const struct aws_date_time *dt, bool local_time);
 AWS_COMMON_API uint8_t aws_date_time_minute(const struct aws_date_time *dt, bool local_time);
 AWS_COMMON_API uint8_t aws_date_time_second(const struct aws_date_time *dt, bool local_time);
+/**
+ * Returns the sub-second part of the time in nanoseconds, which is the same in local time and UTC.
+ */
+AWS_COMMON_API uint32_t aws_date_time_nanosecond(const struct aws_date_time *dt);
 AWS_COMMON_API bool aws_date_time_dst(const struct aws_date_time *dt, bool local_time);
 
 /**
@@ -152,6 +229,11 @@ AWS_COMMON_API bool aws_date_time_dst(const struct aws_date_time *dt, bool local
  */
 AWS_COMMON_API time_t aws_date_time_diff(const struct aws_date_time *a, const struct aws_date_time *b);
 
+/**
+ * returns the difference of a and b (a - b) in nanoseconds.
+ */
+AWS_COMMON_API int64_t aws_date_time_diff_nanos(const struct aws_date_time *a, const struct aws_date_time *b);
+
 AWS_EXTERN_C_END
 
 #endif /* AWS_COMMON_DATE_TIME_H */
@@ -18,14 +18,42 @@
 
 struct aws_byte_buf;
 
+/*
+ * Cryptographically secure random bytes from the operating system: getrandom() on Linux when the kernel has it,
+ * /dev/urandom on other POSIX systems, and BCryptGenRandom on Windows. Everything in this header is safe to use for
+ * keys, nonces and tokens, in either mode below.
+ *
+ * By default every call goes to the operating system, which is a system call per request on POSIX. After
+ * aws_device_random_set_buffered(true), requests of up to 256 bytes are served from a per-thread buffer refilled
+ * AWS_DEVICE_RANDOM_BUFFER_SIZE bytes at a time. The buffer is allocated on a thread's first buffered request, and
+ * wiped and freed when the thread exits or, once buffered mode is turned off, on the thread's next request. The bytes
+ * are the same quality. Bytes are wiped from the buffer as they are handed out, and a forked child never reuses its
+ * parent's buffer. The cost is that the next few KB of a thread's random output sit in process memory until used, so
+ * anything that can read the process's memory can predict them.
+ *
+ * For jitter, sampling and other uses that don't need unpredictability, see aws/common/prng.h, which is much faster.
+ */
+
+/* The size of the per-thread buffer used in buffered mode. */
+#define AWS_DEVICE_RANDOM_BUFFER_SIZE 4096
+
 AWS_EXTERN_C_BEGIN
 
 AWS_COMMON_API int aws_device_random_u64(uint64_t *output);
 AWS_COMMON_API int aws_device_random_u32(uint32_t *output);
 AWS_COMMON_API int aws_device_random_u16(uint16_t *output);
 AWS_COMMON_API int aws_device_random_u8(uint8_t *output);
+
+/**
+ * Fills the rest of output's capacity with random bytes.
+ */
 AWS_COMMON_API int aws_device_random_buffer(struct aws_byte_buf *output);
 
+/**
+ * Turns buffered mode, described above, on or off for every thread. Off by default.
+ */
+AWS_COMMON_API void aws_device_random_set_buffered(bool buffered);
+
 AWS_EXTERN_C_END
 
 #endif /* AWS_COMMON_DEVICE_RANDOM_H */
@@ -0,0 +1,145 @@
+#ifndef AWS_COMMON_EPOCH_H
+#define AWS_COMMON_EPOCH_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/array_list.h>
+#include <aws/common/atomics.h>
+#include <aws/common/common.h>
+#include <aws/common/linked_list.h>
+#include <aws/common/mutex.h>
+
+/*
+ * Epoch-based memory reclamation, for lock-free structures whose readers may still be looking at a node after another
+ * thread has unlinked it.
+ *
+ * Every thread touching the structure registers an aws_epoch_participant with the structure's aws_epoch_domain, and
+ * brackets each access with aws_epoch_enter() and aws_epoch_exit(). A node that has been unlinked is handed to
+ * aws_epoch_defer_free() instead of being freed. The domain keeps a global epoch that only advances once every thread
+ * inside a critical section has observed the current one; memory deferred in epoch e is freed once the global epoch
+ * reaches e + 2, at which point no critical section that could have seen it is still running.
+ *
+ *     aws_epoch_enter(&participant);
+ *     struct node *top = aws_atomic_load_ptr(&stack->top);
+ *     ... unlink top with a compare-exchange ...
+ *     aws_epoch_exit(&participant);
+ *     aws_epoch_defer_free(&participant, allocator, top);
+ *
+ * Reclamation is amortized over aws_epoch_defer_free() calls, and can be forced with aws_epoch_collect(). A thread
+ * that stays inside a critical section holds back reclamation for everyone, so critical sections should be short.
+ */
+
+#define AWS_EPOCH_BUCKET_COUNT 3
+
+struct aws_epoch_domain {
+    struct aws_allocator *allocator;
+    struct aws_atomic_var global_epoch;
+    /* guards participants and orphans */
+    struct aws_mutex lock;
+    struct aws_linked_list participants;
+    /* memory deferred by participants that unregistered before it could be freed */
+    struct aws_array_list orphans;
+};
+
+/* Deferred frees in one epoch. */
+struct aws_epoch_bucket {
+    size_t epoch;
+    struct aws_array_list items;
+};
+
+/**
+ * Per-thread registration with a domain. A participant may be used by only one thread at a time.
+ */
+struct aws_epoch_participant {
+    struct aws_epoch_domain *domain;
+    struct aws_linked_list_node node;
+    /* twice the epoch observed on entry, plus one while inside a critical section */
+    struct aws_atomic_var local_epoch;
+    size_t nesting;
+    struct aws_epoch_bucket buckets[AWS_EPOCH_BUCKET_COUNT];
+    size_t pending_count;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Initializes a domain. allocator is used for the domain's own bookkeeping.
+ */
+AWS_COMMON_API
+int aws_epoch_domain_init(struct aws_epoch_domain *domain, struct aws_allocator *allocator);
+
+/**
+ * Frees everything still deferred and cleans up the domain. Every participant must have unregistered.
+ */
+AWS_COMMON_API
+void aws_epoch_domain_clean_up(struct aws_epoch_domain *domain);
+
+/**
+ * Registers a participant with the domain. The participant's memory is owned by the caller.
+ */
+AWS_COMMON_API
+int aws_epoch_participant_register(struct aws_epoch_domain *domain, struct aws_epoch_participant *participant);
+
+/**
+ * Unregisters a participant, which must be outside any critical section. Memory it deferred that can't be freed yet
+ * is handed to the domain. If the domain can't take it, the participant stays registered and AWS_OP_ERR is returned.
+ */
+AWS_COMMON_API
+int aws_epoch_participant_unregister(struct aws_epoch_participant *participant);
+
+/**
+ * Enters a critical section. Nodes reachable from the structure at any point during it stay valid until the matching
+ * aws_epoch_exit(). Critical sections nest.
+ */
+AWS_COMMON_API
+void aws_epoch_enter(struct aws_epoch_participant *participant);
+
+/**
+ * Leaves a critical section.
+ */
+AWS_COMMON_API
+void aws_epoch_exit(struct aws_epoch_participant *participant);
+
+/**
+ * Frees ptr with aws_mem_release(allocator, ptr) once no critical section can still be looking at it. ptr must already
+ * be unreachable for threads entering a critical section from now on. On failure to record the free, returns AWS_OP_ERR
+ * and ptr is left to the caller.
+ */
+AWS_COMMON_API
+int aws_epoch_defer_free(struct aws_epoch_participant *participant, struct aws_allocator *allocator, void *ptr);
+
+/**
+ * Like aws_epoch_defer_free(), but calls destroy_fn(ptr) instead of releasing ptr to an allocator. destroy_fn must not
+ * call into the epoch domain.
+ */
+AWS_COMMON_API
+int aws_epoch_defer_destroy(struct aws_epoch_participant *participant, void (*destroy_fn)(void *), void *ptr);
+
+/**
+ * Tries to advance the global epoch, then frees whatever this participant, or the domain's orphans, deferred long
+ * enough ago.
+ */
+AWS_COMMON_API
+void aws_epoch_collect(struct aws_epoch_participant *participant);
+
+/**
+ * Returns the number of frees deferred through this participant that have not run yet.
+ */
+AWS_COMMON_API
+size_t aws_epoch_participant_get_pending_count(const struct aws_epoch_participant *participant);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_COMMON_EPOCH_H */
@@ -0,0 +1,59 @@
+#ifndef AWS_COMMON_LOCK_STATS_H
+#define AWS_COMMON_LOCK_STATS_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/common.h>
+
+/*
+ * Opt-in contention profiling for aws_mutex and aws_rw_lock. A lock is profiled once
+ * aws_mutex_enable_profiling() / aws_rw_lock_enable_profiling() has been called on it; locks that are not profiled
+ * pay a single predictable branch per operation. A profiled lock reads aws_high_res_clock_get_ticks() once per
+ * exclusive acquisition and release, and only when it actually has to wait for a shared acquisition.
+ *
+ * Profiled locks may be given a name. Statistics for all locks sharing a name, including ones already cleaned up,
+ * can be queried with aws_lock_stats_get_by_name().
+ */
+
+/* Longest lock name accepted, not counting the terminating null. */
+#define AWS_LOCK_STATS_MAX_NAME_LEN 63
+/* Number of distinct lock names a process can register. */
+#define AWS_LOCK_STATS_MAX_NAMES 64
+
+struct aws_lock_profile;
+
+struct aws_lock_stats {
+    /* successful acquisitions, shared and exclusive, including successful try-locks */
+    uint64_t acquisitions;
+    /* acquisitions that found the lock held and had to wait */
+    uint64_t contended_acquisitions;
+    /* total time spent waiting in contended acquisitions, in nanoseconds */
+    uint64_t total_wait_ns;
+    /* longest time the lock was held exclusively, in nanoseconds */
+    uint64_t max_hold_ns;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Fills stats with the totals of every lock that has been profiled under name; max_hold_ns is the maximum over those
+ * locks. Raises AWS_ERROR_INVALID_ARGUMENT if no lock was ever profiled under name.
+ */
+AWS_COMMON_API
+int aws_lock_stats_get_by_name(const char *name, struct aws_lock_stats *stats);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_COMMON_LOCK_STATS_H */
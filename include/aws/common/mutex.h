@@ -17,6 +17,7 @@
  */
 
 #include <aws/common/common.h>
+#include <aws/common/lock_stats.h>
 #ifdef _WIN32
 /* NOTE: Do not use this macro before including Windows.h */
 #    define AWSMUTEX_TO_WINDOWS(pCV) (PSRWLOCK) pCV
@@ -30,6 +31,8 @@ struct aws_mutex {
 #else
     pthread_mutex_t mutex_handle;
 #endif
+    /* NULL unless profiling was enabled with aws_mutex_enable_profiling() */
+    struct aws_lock_profile *profile;
 };
 
 #ifdef _WIN32
@@ -76,6 +79,21 @@ int aws_mutex_try_lock(struct aws_mutex *mutex);
 AWS_COMMON_API
 int aws_mutex_unlock(struct aws_mutex *mutex);
 
+/**
+ * Starts recording contention statistics for this mutex, see aws/common/lock_stats.h. If name is not NULL, the
+ * statistics are also aggregated with those of every other lock profiled under the same name. Must be called before
+ * the mutex is shared with other threads. The profile is freed by aws_mutex_clean_up().
+ */
+AWS_COMMON_API
+int aws_mutex_enable_profiling(struct aws_mutex *mutex, struct aws_allocator *allocator, const char *name);
+
+/**
+ * Fills stats with the statistics recorded for this mutex so far. Raises AWS_ERROR_INVALID_STATE if profiling was not
+ * enabled.
+ */
+AWS_COMMON_API
+int aws_mutex_get_lock_stats(const struct aws_mutex *mutex, struct aws_lock_stats *stats);
+
 AWS_EXTERN_C_END
 
 #endif /* AWS_COMMON_MUTEX_H */
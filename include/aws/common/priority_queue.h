@@ -120,6 +120,16 @@ int aws_priority_queue_push_ref(
     void *item,
     struct aws_priority_queue_node *backpointer);
 
+/**
+ * Copies count items, stored contiguously at items, into the queue. Complexity: O(n + count) when count is at least
+ * the current size n, in which case the whole queue is rebuilt bottom-up; otherwise each item is sifted into place.
+ * Calling this on an empty queue is therefore an O(n) bulk build from an array.
+ *
+ * Items pushed this way have no backpointer. Either all items are pushed or, on failure, the queue is left unchanged.
+ */
+AWS_COMMON_API
+int aws_priority_queue_push_batch(struct aws_priority_queue *queue, const void *items, size_t count);
+
 /**
  * Copies the element of the highest priority, and removes it from the queue.. Complexity: O(log(n)).
  * If queue is empty, AWS_ERROR_PRIORITY_QUEUE_EMPTY will be raised.
@@ -127,6 +137,17 @@ int aws_priority_queue_push_ref(
 AWS_COMMON_API
 int aws_priority_queue_pop(struct aws_priority_queue *queue, void *item);
 
+/**
+ * Pops every element that does not have a lower priority than threshold, appending them to out in the order they
+ * would have been returned by aws_priority_queue_pop. For a min-heap of timestamps this drains every element less than
+ * or equal to threshold in one call. out must hold items of the same size as the queue.
+ *
+ * If appending to out fails, AWS_OP_ERR is returned; elements already appended have been removed from the queue, and
+ * the remaining elements are left in place.
+ */
+AWS_COMMON_API
+int aws_priority_queue_pop_up_to(struct aws_priority_queue *queue, const void *threshold, struct aws_array_list *out);
+
 /**
  * Removes a specific node from the priority queue. Complexity: O(log(n))
  * After removing a node (using either _remove or _pop), the backpointer set at push_ref time is set
@@ -0,0 +1,45 @@
+#ifndef AWS_COMMON_PRIVATE_CPU_TOPOLOGY_H
+#define AWS_COMMON_PRIVATE_CPU_TOPOLOGY_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/system_info.h>
+
+AWS_EXTERN_C_BEGIN
+
+/*
+ * Parses a Linux sysfs cpu or node list such as "0-3,8,10-11\n", calling on_id once for each id in it, in order.
+ * Returns false if the list is malformed, in which case on_id may already have been called for a prefix of it.
+ */
+bool aws_cpu_list_private_parse(const char *list, void (*on_id)(size_t id, void *user_data), void *user_data);
+
+/*
+ * Reads the first line of a small sysfs file into buffer. Returns false if the file can't be read.
+ */
+bool aws_cpu_list_private_read_file(const char *path, char *buffer, size_t buffer_size);
+
+/*
+ * The fallback for platforms that don't expose their topology: every online processor is a core of its own.
+ */
+int aws_cpu_topology_private_init_flat(struct aws_cpu_topology *topology);
+
+/*
+ * Fills in the counts of a topology from its cpus array. Platform code only has to discover the cpus.
+ */
+void aws_cpu_topology_private_summarize(struct aws_cpu_topology *topology);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_COMMON_PRIVATE_CPU_TOPOLOGY_H */
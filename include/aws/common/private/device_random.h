@@ -0,0 +1,46 @@
+#ifndef AWS_COMMON_PRIVATE_DEVICE_RANDOM_H
+#define AWS_COMMON_PRIVATE_DEVICE_RANDOM_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/common.h>
+
+AWS_EXTERN_C_BEGIN
+
+/*
+ * Fills len bytes at dest from the operating system's random number generator. Implemented per platform.
+ */
+int aws_device_random_private_fill(uint8_t *dest, size_t len);
+
+/*
+ * Changes in the child whenever the process forks. Per-thread state derived from random bytes must be thrown away when
+ * this changes, or parent and child would hand out the same values.
+ */
+size_t aws_device_random_private_fork_generation(void);
+
+/*
+ * Arranges for aws_device_random_private_release_thread_buffer(buffer) to run when the calling thread exits, replacing
+ * any buffer registered before; NULL cancels it. Implemented per platform. Returns false if it can't be arranged.
+ */
+bool aws_device_random_private_watch_thread_exit(void *buffer);
+
+/*
+ * Wipes and frees a thread's buffered-mode buffer. Called on the thread that owns it.
+ */
+void aws_device_random_private_release_thread_buffer(void *buffer);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_COMMON_PRIVATE_DEVICE_RANDOM_H */
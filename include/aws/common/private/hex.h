@@ -0,0 +1,35 @@
+#ifndef AWS_COMMON_PRIVATE_HEX_H
+#define AWS_COMMON_PRIVATE_HEX_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/common.h>
+
+AWS_EXTERN_C_BEGIN
+
+/*
+ * Writes len bytes from in to out as 2 * len lowercase hex characters, with no terminator.
+ */
+void aws_hex_private_encode_bytes(const uint8_t *in, size_t len, uint8_t *out);
+
+/*
+ * Decodes 2 * len hex characters of either case from in into len bytes at out. Returns false if any of them isn't a
+ * hex digit, in which case out may have been partly written.
+ */
+bool aws_hex_private_decode_bytes(const uint8_t *in, size_t len, uint8_t *out);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_COMMON_PRIVATE_HEX_H */
@@ -0,0 +1,56 @@
+#ifndef AWS_COMMON_PRIVATE_LOCK_PROFILE_H
+#define AWS_COMMON_PRIVATE_LOCK_PROFILE_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/lock_stats.h>
+
+/*
+ * Hooks the platform mutex and rw_lock implementations call on profiled locks. Exclusive hooks must be called while
+ * the lock is held exclusively: the lock itself serializes their updates.
+ */
+
+AWS_EXTERN_C_BEGIN
+
+/* lock is only used to identify the lock in AWS_TRACE_EVENT_LOCK_WAIT events. */
+struct aws_lock_profile *aws_lock_profile_private_new(
+    struct aws_allocator *allocator,
+    const void *lock,
+    const char *name);
+
+/* Folds the profile's counters into its name's totals and frees it. */
+void aws_lock_profile_private_destroy(struct aws_lock_profile *profile);
+
+/* Timestamp to pass as wait_start when an acquisition is about to block. */
+uint64_t aws_lock_profile_private_now(void);
+
+/* Records an acquisition. wait_start is only read when contended is true. */
+void aws_lock_profile_private_acquired(
+    struct aws_lock_profile *profile,
+    bool exclusive,
+    bool contended,
+    uint64_t wait_start);
+
+/* Records the end of an exclusive hold. Call before releasing the lock. */
+void aws_lock_profile_private_released(struct aws_lock_profile *profile);
+
+/* Restarts the exclusive hold timer after a condition variable wait gave the lock back to us. */
+void aws_lock_profile_private_reacquired(struct aws_lock_profile *profile);
+
+void aws_lock_profile_private_get_stats(struct aws_lock_profile *profile, struct aws_lock_stats *stats);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_COMMON_PRIVATE_LOCK_PROFILE_H */
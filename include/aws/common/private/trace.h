@@ -0,0 +1,35 @@
+#ifndef AWS_COMMON_PRIVATE_TRACE_H
+#define AWS_COMMON_PRIVATE_TRACE_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/common.h>
+
+AWS_EXTERN_C_BEGIN
+
+/*
+ * Arranges for aws_trace_private_retire_thread_ring(ring) to run when the calling thread exits, replacing any ring
+ * registered before. Implemented per platform. Returns false if it can't be arranged.
+ */
+bool aws_trace_private_watch_thread_exit(void *ring);
+
+/*
+ * Moves the calling thread's ring from the running threads to the exited ones, kept until the next dump.
+ */
+void aws_trace_private_retire_thread_ring(void *ring);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_COMMON_PRIVATE_TRACE_H */
@@ -0,0 +1,102 @@
+#ifndef AWS_COMMON_PRNG_H
+#define AWS_COMMON_PRNG_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/common.h>
+
+/*
+ * A fast pseudo-random number generator (xoshiro256**) for retry jitter, sampling, load balancing and tests.
+ *
+ * This is NOT cryptographically secure: anyone who sees a few outputs can compute every later one. Use
+ * aws/common/device_random.h for keys, nonces, tokens, and anything else an attacker must not be able to guess.
+ *
+ * A generator is a few words of state and is not thread safe. Either give each thread or connection its own, or use
+ * the calling thread's generator from aws_prng_thread_local().
+ */
+struct aws_prng {
+    uint64_t state[4];
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Seeds prng from the operating system's random number generator.
+ */
+AWS_COMMON_API int aws_prng_init(struct aws_prng *prng);
+
+/**
+ * Seeds prng deterministically, so that a run can be reproduced. Every seed, including 0, is valid.
+ */
+AWS_COMMON_API void aws_prng_init_from_seed(struct aws_prng *prng, uint64_t seed);
+
+/**
+ * Returns the calling thread's generator, seeded from the operating system on first use and reseeded in a forked
+ * child. It must not be handed to other threads.
+ */
+AWS_COMMON_API struct aws_prng *aws_prng_thread_local(void);
+
+/**
+ * Returns 64 random bits.
+ */
+AWS_STATIC_IMPL uint64_t aws_prng_next_u64(struct aws_prng *prng) {
+    uint64_t *s = prng->state;
+    uint64_t scrambled = s[1] * 5;
+    uint64_t result = ((scrambled << 7) | (scrambled >> 57)) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+
+    return result;
+}
+
+/**
+ * Returns 32 random bits.
+ */
+AWS_STATIC_IMPL uint32_t aws_prng_next_u32(struct aws_prng *prng) {
+    /* the high bits are the better ones */
+    return (uint32_t)(aws_prng_next_u64(prng) >> 32);
+}
+
+/**
+ * Returns a uniformly distributed value in [0, bound). bound must not be 0.
+ */
+AWS_STATIC_IMPL uint64_t aws_prng_next_bounded(struct aws_prng *prng, uint64_t bound) {
+    /* values below threshold would make the low results slightly more likely than the high ones */
+    uint64_t threshold = (0 - bound) % bound;
+    uint64_t value;
+    do {
+        value = aws_prng_next_u64(prng);
+    } while (value < threshold);
+
+    return value % bound;
+}
+
+/**
+ * Returns a uniformly distributed double in [0, 1).
+ */
+AWS_STATIC_IMPL double aws_prng_next_double(struct aws_prng *prng) {
+    /* 53 bits fill the mantissa exactly */
+    return (double)(aws_prng_next_u64(prng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_COMMON_PRNG_H */
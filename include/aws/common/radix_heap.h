@@ -0,0 +1,104 @@
+#ifndef AWS_COMMON_RADIX_HEAP_H
+#define AWS_COMMON_RADIX_HEAP_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/common.h>
+#include <aws/common/linked_list.h>
+
+/*
+ * Monotone min-priority queue keyed by uint64_t, such as timer deadlines that are never earlier than the current time.
+ *
+ * Keys are kept in 65 buckets according to the highest bit in which they differ from aws_radix_heap_min_key(). Pushing
+ * and removing are O(1); popping is amortized O(1) per element, because an element only ever moves to a strictly
+ * lower bucket. The price is monotonicity: a key may not be pushed if it is smaller than the smallest key the heap
+ * has reported so far through aws_radix_heap_pop or aws_radix_heap_top.
+ *
+ * The heap is intrusive and never allocates: embed a struct aws_radix_heap_node in your own structure and use
+ * AWS_CONTAINER_OF to get back to it. The heap holds pointers to its own list heads, so it must not be moved or
+ * copied once initialized.
+ */
+
+#define AWS_RADIX_HEAP_BUCKET_COUNT 65
+
+struct aws_radix_heap_node {
+    /* Bucket membership; next and prev are NULL when the node is not in a heap. */
+    struct aws_linked_list_node node;
+    uint64_t key;
+};
+
+struct aws_radix_heap {
+    struct aws_linked_list buckets[AWS_RADIX_HEAP_BUCKET_COUNT];
+    /* bit (n - 1) is set when bucket n is non-empty, for n in [1, 64]. Bucket 0 is checked directly. */
+    uint64_t occupied;
+    uint64_t last_key;
+    size_t size;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Initializes an empty heap. Keys smaller than min_key will be rejected.
+ */
+AWS_COMMON_API
+void aws_radix_heap_init(struct aws_radix_heap *heap, uint64_t min_key);
+
+/**
+ * Inserts node with the given key. Complexity: O(1).
+ * Raises AWS_ERROR_INVALID_ARGUMENT if key is smaller than aws_radix_heap_min_key().
+ */
+AWS_COMMON_API
+int aws_radix_heap_push(struct aws_radix_heap *heap, struct aws_radix_heap_node *node, uint64_t key);
+
+/**
+ * Removes the node with the smallest key and stores it in *node. Complexity: amortized O(1).
+ * Nodes with equal keys are popped in no particular order.
+ * If the heap is empty, AWS_ERROR_PRIORITY_QUEUE_EMPTY will be raised.
+ */
+AWS_COMMON_API
+int aws_radix_heap_pop(struct aws_radix_heap *heap, struct aws_radix_heap_node **node);
+
+/**
+ * Stores the node with the smallest key in *node without removing it. Complexity: amortized O(1).
+ * Like pop, this raises aws_radix_heap_min_key() to that node's key.
+ * If the heap is empty, AWS_ERROR_PRIORITY_QUEUE_EMPTY will be raised.
+ */
+AWS_COMMON_API
+int aws_radix_heap_top(struct aws_radix_heap *heap, struct aws_radix_heap_node **node);
+
+/**
+ * Removes a specific node from the heap. Complexity: O(1).
+ * Raises AWS_ERROR_PRIORITY_QUEUE_BAD_NODE if the node has already been popped or removed. Passing a node that was
+ * never pushed, or that belongs to a different heap, results in undefined behavior.
+ */
+AWS_COMMON_API
+int aws_radix_heap_remove(struct aws_radix_heap *heap, struct aws_radix_heap_node *node);
+
+/**
+ * Current number of nodes in the heap.
+ */
+AWS_COMMON_API
+size_t aws_radix_heap_size(const struct aws_radix_heap *heap);
+
+/**
+ * Smallest key that may currently be pushed: the key of the last node returned by pop or top, or the min_key passed to
+ * aws_radix_heap_init if there has been none yet.
+ */
+AWS_COMMON_API
+uint64_t aws_radix_heap_min_key(const struct aws_radix_heap *heap);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_COMMON_RADIX_HEAP_H */
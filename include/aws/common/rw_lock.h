@@ -17,6 +17,7 @@
  */
 
 #include <aws/common/common.h>
+#include <aws/common/lock_stats.h>
 #ifdef _WIN32
 /* NOTE: Do not use this macro before including Windows.h */
 #    define AWSSRW_TO_WINDOWS(pCV) (PSRWLOCK) pCV
@@ -30,6 +31,8 @@ struct aws_rw_lock {
 #else
     pthread_rwlock_t lock_handle;
 #endif
+    /* NULL unless profiling was enabled with aws_rw_lock_enable_profiling() */
+    struct aws_lock_profile *profile;
 };
 
 #ifdef _WIN32
@@ -74,6 +77,23 @@ AWS_COMMON_API int aws_rw_lock_try_wlock(struct aws_rw_lock *lock);
 AWS_COMMON_API int aws_rw_lock_runlock(struct aws_rw_lock *lock);
 AWS_COMMON_API int aws_rw_lock_wunlock(struct aws_rw_lock *lock);
 
+/**
+ * Starts recording contention statistics for this lock, see aws/common/lock_stats.h. Shared and exclusive
+ * acquisitions are counted together; max_hold_ns only covers exclusive holds. If name is not NULL, the statistics are
+ * also aggregated with those of every other lock profiled under the same name. Must be called before the lock is
+ * shared with other threads. The profile is freed by aws_rw_lock_clean_up().
+ */
+AWS_COMMON_API int aws_rw_lock_enable_profiling(
+    struct aws_rw_lock *lock,
+    struct aws_allocator *allocator,
+    const char *name);
+
+/**
+ * Fills stats with the statistics recorded for this lock so far. Raises AWS_ERROR_INVALID_STATE if profiling was not
+ * enabled.
+ */
+AWS_COMMON_API int aws_rw_lock_get_lock_stats(const struct aws_rw_lock *lock, struct aws_lock_stats *stats);
+
 AWS_EXTERN_C_END
 
 #endif /* AWS_COMMON_RW_LOCK_H */
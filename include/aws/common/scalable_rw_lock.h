@@ -0,0 +1,102 @@
+#ifndef AWS_COMMON_SCALABLE_RW_LOCK_H
+#define AWS_COMMON_SCALABLE_RW_LOCK_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/atomics.h>
+#include <aws/common/common.h>
+#include <aws/common/mutex.h>
+
+struct aws_scalable_rw_lock_slot;
+
+/**
+ * Reader-writer lock for read-mostly data. Instead of one shared reader count, readers announce themselves in one of
+ * several cache-line sized slots, picked per thread, so readers on different cores don't write to the same cache line.
+ * A read lock or unlock with no writer around is one atomic increment or decrement of the thread's own slot and a
+ * load of a line that only writers write.
+ *
+ * Writers are expensive in exchange: they serialize on a mutex, then wait for every slot to drain. Writers are
+ * preferred: once a writer is waiting, new readers block until it is done, so a steady stream of readers can not
+ * starve it.
+ *
+ * Read locks must be released by the thread that took them, and, as with any writer-preferring lock, a thread must not
+ * take a second read lock while holding one, since a writer may have arrived in between.
+ */
+struct aws_scalable_rw_lock {
+    struct aws_allocator *allocator;
+    /* slot_mask + 1 reader indicators, each on its own cache line */
+    struct aws_scalable_rw_lock_slot *slots;
+    void *slots_allocation;
+    size_t slot_mask;
+    /* nonzero while a writer holds or waits for the lock */
+    struct aws_atomic_var writer_active;
+    /* serializes writers; readers that find writer_active set wait on it */
+    struct aws_mutex writer_mutex;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Initializes the lock, sizing the reader slots to the number of processors.
+ */
+AWS_COMMON_API
+int aws_scalable_rw_lock_init(struct aws_scalable_rw_lock *lock, struct aws_allocator *allocator);
+
+/**
+ * Cleans up internal resources. The lock must not be held.
+ */
+AWS_COMMON_API
+void aws_scalable_rw_lock_clean_up(struct aws_scalable_rw_lock *lock);
+
+/**
+ * Blocks until a shared lock is acquired.
+ */
+AWS_COMMON_API
+int aws_scalable_rw_lock_rlock(struct aws_scalable_rw_lock *lock);
+
+/**
+ * Blocks until an exclusive lock is acquired.
+ */
+AWS_COMMON_API
+int aws_scalable_rw_lock_wlock(struct aws_scalable_rw_lock *lock);
+
+/**
+ * Attempts to acquire a shared lock but returns immediately, raising AWS_ERROR_MUTEX_TIMEOUT, if a writer holds or
+ * waits for the lock.
+ */
+AWS_COMMON_API
+int aws_scalable_rw_lock_try_rlock(struct aws_scalable_rw_lock *lock);
+
+/**
+ * Attempts to acquire an exclusive lock but returns immediately, raising AWS_ERROR_MUTEX_TIMEOUT, if the lock is held.
+ */
+AWS_COMMON_API
+int aws_scalable_rw_lock_try_wlock(struct aws_scalable_rw_lock *lock);
+
+/**
+ * Releases a shared lock taken by the calling thread.
+ */
+AWS_COMMON_API
+int aws_scalable_rw_lock_runlock(struct aws_scalable_rw_lock *lock);
+
+/**
+ * Releases an exclusive lock.
+ */
+AWS_COMMON_API
+int aws_scalable_rw_lock_wunlock(struct aws_scalable_rw_lock *lock);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_COMMON_SCALABLE_RW_LOCK_H */
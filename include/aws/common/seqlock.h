@@ -0,0 +1,102 @@
+#ifndef AWS_COMMON_SEQLOCK_H
+#define AWS_COMMON_SEQLOCK_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/atomics.h>
+#include <aws/common/common.h>
+#include <aws/common/mutex.h>
+
+/**
+ * Sequence lock for small, frequently read, rarely written data such as a snapshot of credentials or a clock offset.
+ * Readers never write shared memory: they read the sequence number, copy the data, and retry if a writer ran in the
+ * meantime. Writers serialize on a mutex and bump the sequence number to odd before writing and back to even after.
+ *
+ * A reader may see a half-written copy before it retries, so it must not follow pointers or act on the data until
+ * aws_seqlock_read_retry() returns false. aws_seqlock_read_copy() wraps the whole protocol for plain structs:
+ *
+ *     struct config snapshot;
+ *     aws_seqlock_read_copy(&lock, &snapshot, &shared_config, sizeof(snapshot));
+ */
+struct aws_seqlock {
+    /* odd while a writer is writing */
+    struct aws_atomic_var sequence;
+    struct aws_mutex write_lock;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Initializes the seqlock.
+ */
+AWS_COMMON_API
+int aws_seqlock_init(struct aws_seqlock *lock);
+
+/**
+ * Cleans up internal resources. No writer may be active.
+ */
+AWS_COMMON_API
+void aws_seqlock_clean_up(struct aws_seqlock *lock);
+
+/**
+ * Starts a read, waiting out any write in progress. Returns the sequence number to pass to aws_seqlock_read_retry().
+ */
+AWS_STATIC_IMPL
+size_t aws_seqlock_read_begin(const struct aws_seqlock *lock) {
+    size_t sequence;
+    while ((sequence = aws_atomic_load_int_explicit(&lock->sequence, aws_memory_order_acquire)) & 1) {
+        aws_atomic_spin_hint();
+    }
+    return sequence;
+}
+
+/**
+ * Ends a read. Returns true if a writer ran since aws_seqlock_read_begin() returned sequence, in which case everything
+ * read must be discarded and the read started over.
+ */
+AWS_STATIC_IMPL
+bool aws_seqlock_read_retry(const struct aws_seqlock *lock, size_t sequence) {
+    /* keeps the data reads from moving below the sequence check */
+    aws_atomic_thread_fence(aws_memory_order_acquire);
+    return aws_atomic_load_int_explicit(&lock->sequence, aws_memory_order_relaxed) != sequence;
+}
+
+/**
+ * Takes the write side, blocking other writers and making readers retry until aws_seqlock_write_unlock().
+ */
+AWS_COMMON_API
+int aws_seqlock_write_lock(struct aws_seqlock *lock);
+
+/**
+ * Releases the write side.
+ */
+AWS_COMMON_API
+int aws_seqlock_write_unlock(struct aws_seqlock *lock);
+
+/**
+ * Copies size bytes from src, which is protected by lock, to dest, retrying until the copy is consistent.
+ */
+AWS_COMMON_API
+void aws_seqlock_read_copy(const struct aws_seqlock *lock, void *dest, const void *src, size_t size);
+
+/**
+ * Copies size bytes from src to dest, which is protected by lock, as a single write.
+ */
+AWS_COMMON_API
+int aws_seqlock_write_copy(struct aws_seqlock *lock, void *dest, const void *src, size_t size);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_COMMON_SEQLOCK_H */
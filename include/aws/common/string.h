@@ -115,7 +115,8 @@ void aws_string_destroy(struct aws_string *str);
 
 /**
  * Zeroes out the data bytes of string and then deallocates the memory.
- * Not safe to run on a string created with AWS_STATIC_STRING_FROM_LITERAL.
+ * Strings without an allocator, such as those created with AWS_STATIC_STRING_FROM_LITERAL
+ * or interned in an aws_string_pool, are left untouched.
  */
 AWS_COMMON_API
 void aws_string_destroy_secure(struct aws_string *str);
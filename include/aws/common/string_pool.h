@@ -0,0 +1,116 @@
+#ifndef AWS_COMMON_STRING_POOL_H
+#define AWS_COMMON_STRING_POOL_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <aws/common/hash_table.h>
+#include <aws/common/mutex.h>
+#include <aws/common/string.h>
+
+/**
+ * Interning pool for aws_string. Interning the same bytes twice returns the same
+ * pointer, so two strings handed out by the same pool are equal if and only if
+ * they are the same pointer.
+ *
+ * Interned strings are owned by the pool: their allocator field is NULL, so
+ * calling aws_string_destroy() or aws_string_destroy_secure() on one is a
+ * harmless no-op; in particular, the shared bytes are not wiped. Each string is either
+ * reference counted (aws_string_pool_intern / aws_string_pool_acquire /
+ * aws_string_pool_release) and freed once its last reference is released, or
+ * immortal (aws_string_pool_intern_immortal) and kept until the pool is cleaned
+ * up. Once a string has been made immortal, acquire and release on it are no-ops.
+ *
+ * All operations are safe to call concurrently from multiple threads.
+ */
+struct aws_string_pool {
+    struct aws_allocator *allocator;
+    struct aws_hash_table table;
+    struct aws_mutex lock;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Initializes an empty pool. `initial_size` is a sizing hint for the underlying hash table.
+ */
+AWS_COMMON_API
+int aws_string_pool_init(struct aws_string_pool *pool, struct aws_allocator *allocator, size_t initial_size);
+
+/**
+ * Frees every string in the pool, regardless of any outstanding references. No string
+ * handed out by the pool may be used after this call.
+ */
+AWS_COMMON_API
+void aws_string_pool_clean_up(struct aws_string_pool *pool);
+
+/**
+ * Returns the interned string with the same bytes as `cursor`, creating it if needed, and
+ * takes a reference on it. The reference must be dropped with aws_string_pool_release().
+ * Returns NULL and raises an error on allocation failure.
+ */
+AWS_COMMON_API
+const struct aws_string *aws_string_pool_intern(struct aws_string_pool *pool, struct aws_byte_cursor cursor);
+
+/**
+ * Same as aws_string_pool_intern() for a null-terminated C-string.
+ */
+AWS_COMMON_API
+const struct aws_string *aws_string_pool_intern_c_str(struct aws_string_pool *pool, const char *c_str);
+
+/**
+ * Returns the interned string with the same bytes as `cursor`, creating it if needed, and
+ * pins it for the lifetime of the pool. The result never needs to be released.
+ * Returns NULL and raises an error on allocation failure.
+ */
+AWS_COMMON_API
+const struct aws_string *aws_string_pool_intern_immortal(struct aws_string_pool *pool, struct aws_byte_cursor cursor);
+
+/**
+ * Takes an additional reference on a string previously returned by this pool. Returns `str`.
+ */
+AWS_COMMON_API
+const struct aws_string *aws_string_pool_acquire(struct aws_string_pool *pool, const struct aws_string *str);
+
+/**
+ * Drops a reference on a string previously returned by this pool. The string is freed when
+ * its last reference is dropped, unless it is immortal. NULL is ignored.
+ */
+AWS_COMMON_API
+void aws_string_pool_release(struct aws_string_pool *pool, const struct aws_string *str);
+
+/**
+ * Returns the number of distinct strings currently held by the pool.
+ */
+AWS_COMMON_API
+size_t aws_string_pool_get_entry_count(struct aws_string_pool *pool);
+
+/**
+ * Hash function for interned strings, for use as the hash_fn of an aws_hash_table whose keys are
+ * strings from an aws_string_pool. Returns the content hash computed once when the string was
+ * interned, so it costs a single load regardless of string length. Must not be passed strings
+ * that did not come from a pool.
+ */
+AWS_COMMON_API
+uint64_t aws_hash_interned_string(const void *item);
+
+/**
+ * Equality function for interned strings, for use alongside aws_hash_interned_string.
+ * Strings from the same pool are equal exactly when they are the same pointer.
+ */
+AWS_COMMON_API
+bool aws_hash_callback_interned_string_eq(const void *a, const void *b);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_COMMON_STRING_POOL_H */
@@ -24,6 +24,59 @@ AWS_EXTERN_C_BEGIN
 AWS_COMMON_API
 size_t aws_system_info_processor_count(void);
 
+/* Where a logical CPU sits in the machine. */
+struct aws_cpu_info {
+    /* id the operating system uses for the CPU, e.g. in aws_thread_options.cpu_affinity */
+    uint32_t cpu_id;
+    /* dense index of the physical core; SMT siblings share it */
+    uint32_t core_index;
+    uint32_t package_id;
+    uint32_t numa_node;
+};
+
+/* One level of the cache hierarchy, as seen from the first CPU. Zero sizes mean unknown or absent. */
+struct aws_cache_info {
+    size_t size;
+    size_t line_size;
+    /* number of logical CPUs sharing one instance of this cache */
+    size_t shared_cpu_count;
+};
+
+/**
+ * Snapshot of the CPU topology, for sizing shards and per-CPU caches. Where the platform doesn't expose the topology,
+ * every online processor is reported as its own core on NUMA node 0, with unknown cache sizes.
+ */
+struct aws_cpu_topology {
+    struct aws_allocator *allocator;
+    /* online logical CPUs, ordered by cpu_id */
+    struct aws_cpu_info *cpus;
+    size_t logical_cpu_count;
+    size_t physical_core_count;
+    size_t package_count;
+    size_t numa_node_count;
+    /* largest number of SMT siblings on one core, 1 without SMT */
+    size_t max_smt_siblings;
+    struct aws_cache_info l1_data_cache;
+    struct aws_cache_info l1_instruction_cache;
+    struct aws_cache_info l2_cache;
+    struct aws_cache_info l3_cache;
+};
+
+/**
+ * Discovers the CPU topology of the machine. The result is a snapshot and doesn't follow CPU hotplug.
+ */
+AWS_COMMON_API
+int aws_system_info_cpu_topology_init(struct aws_cpu_topology *topology, struct aws_allocator *allocator);
+
+AWS_COMMON_API
+void aws_system_info_cpu_topology_clean_up(struct aws_cpu_topology *topology);
+
+/**
+ * Returns the info for the CPU with the given operating system id, or NULL if it isn't online.
+ */
+AWS_COMMON_API
+const struct aws_cpu_info *aws_cpu_topology_get_cpu(const struct aws_cpu_topology *topology, uint32_t cpu_id);
+
 AWS_EXTERN_C_END
 
 #endif /* AWS_COMMON_SYSTEM_INFO_H */
@@ -27,8 +27,38 @@ enum aws_thread_detach_state {
     AWS_THREAD_JOIN_COMPLETED,
 };
 
+enum aws_thread_priority {
+    AWS_THREAD_PRIORITY_DEFAULT = 0,
+    AWS_THREAD_PRIORITY_LOWEST,
+    AWS_THREAD_PRIORITY_LOW,
+    AWS_THREAD_PRIORITY_HIGH,
+    AWS_THREAD_PRIORITY_HIGHEST,
+};
+
+/* Longest thread name every platform keeps in full; Linux truncates names to this many characters. */
+#define AWS_THREAD_NAME_RECOMMENDED_MAX 15
+
+/**
+ * Zeroed fields keep the platform defaults. Placement and priority settings are applied where the platform supports
+ * them and ignored elsewhere; raising priority above the default usually requires elevated privileges and is skipped
+ * without them.
+ */
 struct aws_thread_options {
     size_t stack_size;
+    /*
+     * CPUs the thread may run on, as indices below aws_system_info_processor_count(). Ignored when
+     * cpu_affinity_count is 0. Only read during aws_thread_launch().
+     */
+    const size_t *cpu_affinity;
+    size_t cpu_affinity_count;
+    /* Name shown by debuggers, top and perf. Copied during aws_thread_launch(). May be NULL. */
+    const char *name;
+    enum aws_thread_priority priority;
+    /*
+     * If true, the thread prefers memory from numa_node and, unless cpu_affinity is given, runs on that node's CPUs.
+     */
+    bool prefer_numa_node;
+    uint16_t numa_node;
 };
 
 #ifdef _WIN32
@@ -0,0 +1,189 @@
+#ifndef AWS_COMMON_TRACE_H
+#define AWS_COMMON_TRACE_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/atomics.h>
+#include <aws/common/byte_buf.h>
+#include <aws/common/common.h>
+
+/*
+ * Low overhead event tracing. Each thread records events into its own fixed-size ring, which it alone writes, so
+ * recording takes no lock and no read-modify-write; once a ring is full the oldest events are overwritten. An event is
+ * a fast clock timestamp, an event id and two 64-bit arguments. aws_trace_dump_json() renders every thread's ring in
+ * Chrome's trace_event JSON format, which chrome://tracing and Perfetto load directly.
+ *
+ * Event ids are small integers given a name and a phase with aws_trace_register_event(). Ids below
+ * AWS_TRACE_EVENT_USER_FIRST are reserved for events recorded by this library.
+ *
+ *     aws_trace_init(allocator, 1 << 16);
+ *     aws_trace_register_event(MY_EVENT_READ, "socket_read", AWS_TRACE_PHASE_INSTANT);
+ *     aws_trace_set_enabled(true);
+ *     ...
+ *     AWS_TRACE_EVENT(MY_EVENT_READ, fd, bytes_read);
+ *
+ * When a thread exits its ring is kept, so that its events still show up in the next aws_trace_dump_json(); after that
+ * dump the ring is handed to the next new thread that records an event. At most AWS_TRACE_MAX_RETIRED_RINGS rings of
+ * exited threads are kept: beyond that, rings already dumped are freed first, then the oldest ones not dumped yet, so
+ * programs that keep starting short-lived threads don't grow without bound.
+ *
+ * While tracing is disabled AWS_TRACE_EVENT() costs one relaxed load and a predictable branch. Defining
+ * AWS_DISABLE_TRACING, e.g. with the AWS_DISABLE_TRACING cmake option, compiles it out entirely.
+ */
+
+/* Number of distinct event ids. */
+#define AWS_TRACE_MAX_EVENTS 256
+/* Longest event name accepted, not counting the terminating null. */
+#define AWS_TRACE_MAX_EVENT_NAME_LEN 63
+/* Most rings of exited threads kept, dumped or not. */
+#define AWS_TRACE_MAX_RETIRED_RINGS 16
+
+/* How an event is drawn, as a Chrome trace_event phase. */
+enum aws_trace_phase {
+    /* a point in time */
+    AWS_TRACE_PHASE_INSTANT,
+    /* opens a slice, closed by the next END event with the same name on the same thread */
+    AWS_TRACE_PHASE_BEGIN,
+    AWS_TRACE_PHASE_END,
+    /* plots arg0 and arg1 as counters over time */
+    AWS_TRACE_PHASE_COUNTER,
+};
+
+/* Events recorded by aws-c-common itself. */
+enum aws_trace_common_event {
+    /* a task scheduler runs a task; arg0 is the task's address, arg1 its aws_task_status */
+    AWS_TRACE_EVENT_TASK_RUN_BEGIN = 1,
+    AWS_TRACE_EVENT_TASK_RUN_END,
+    /* a profiled lock was acquired after waiting for it; arg0 is the lock's address, arg1 the wait in nanoseconds */
+    AWS_TRACE_EVENT_LOCK_WAIT,
+    /* aws_mem_acquire() or aws_mem_realloc() returned memory; arg0 is its address, arg1 its size */
+    AWS_TRACE_EVENT_MEM_ACQUIRE,
+    /* memory is given back with aws_mem_release() or moved by aws_mem_realloc(); arg0 is its address */
+    AWS_TRACE_EVENT_MEM_RELEASE,
+
+    AWS_TRACE_EVENT_USER_FIRST = 16,
+};
+
+struct aws_trace_event {
+    uint64_t timestamp;
+    uint64_t arg0;
+    uint64_t arg1;
+    uint32_t event_id;
+    uint32_t reserved;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/* Non-zero while tracing is enabled. Use aws_trace_set_enabled() and aws_trace_is_enabled() instead. */
+AWS_COMMON_API extern struct aws_atomic_var aws_trace_private_enabled;
+/* Non-zero while allocations are traced. Use aws_trace_set_allocations_enabled() instead. */
+AWS_COMMON_API extern struct aws_atomic_var aws_trace_private_allocations_enabled;
+
+/**
+ * Sets up tracing with rings of events_per_thread events, rounded up to a power of two. Rings are allocated from
+ * allocator the first time each thread records an event. Tracing starts out disabled. Raises
+ * AWS_ERROR_INVALID_STATE if tracing is already initialized.
+ */
+AWS_COMMON_API
+int aws_trace_init(struct aws_allocator *allocator, size_t events_per_thread);
+
+/**
+ * Disables tracing and frees every ring and event registration. No thread may be inside aws_trace_record(), so
+ * threads that may still be recording must be stopped, or must have observed tracing being disabled, first.
+ */
+AWS_COMMON_API
+void aws_trace_clean_up(void);
+
+/**
+ * Turns recording on or off for all threads. Has no effect until aws_trace_init() has been called.
+ */
+AWS_COMMON_API
+void aws_trace_set_enabled(bool enabled);
+
+/**
+ * Turns the AWS_TRACE_EVENT_MEM_ACQUIRE and AWS_TRACE_EVENT_MEM_RELEASE events on or off. They are off until this is
+ * called, since every allocation records one, including the ones aws_trace_dump_json() makes; while on they are
+ * recorded whenever tracing is enabled.
+ */
+AWS_COMMON_API
+void aws_trace_set_allocations_enabled(bool enabled);
+
+/**
+ * Returns true if events are currently being recorded.
+ */
+AWS_STATIC_IMPL
+bool aws_trace_is_enabled(void) {
+    return aws_atomic_load_int_explicit(&aws_trace_private_enabled, aws_memory_order_relaxed) != 0;
+}
+
+/**
+ * Names event_id and sets its phase. name must be at most AWS_TRACE_MAX_EVENT_NAME_LEN characters and may not
+ * contain quotes, backslashes or control characters. Registering an id again replaces its name and phase. Events
+ * recorded with an unregistered id are dumped as instant events named after the id.
+ */
+AWS_COMMON_API
+int aws_trace_register_event(uint32_t event_id, const char *name, enum aws_trace_phase phase);
+
+/**
+ * Records an event in the calling thread's ring, whether or not tracing is enabled; callers normally go through
+ * AWS_TRACE_EVENT() instead. Events whose id is AWS_TRACE_MAX_EVENTS or more, and events recorded before
+ * aws_trace_init() or when a ring can't be allocated, are dropped.
+ */
+AWS_COMMON_API
+void aws_trace_record(uint32_t event_id, uint64_t arg0, uint64_t arg1);
+
+/**
+ * Copies the calling thread's most recent events, oldest first, into events and returns how many were copied, at most
+ * max_events.
+ */
+AWS_COMMON_API
+size_t aws_trace_get_thread_events(struct aws_trace_event *events, size_t max_events);
+
+/**
+ * Initializes output with allocator and writes every thread's events to it as a Chrome trace_event JSON object.
+ * Threads may keep recording meanwhile; events they overwrite during the dump are left out.
+ */
+AWS_COMMON_API
+int aws_trace_dump_json(struct aws_byte_buf *output, struct aws_allocator *allocator);
+
+/**
+ * Discards every event recorded so far, on every thread. Threads may keep recording meanwhile.
+ */
+AWS_COMMON_API
+void aws_trace_clear(void);
+
+AWS_EXTERN_C_END
+
+#ifdef AWS_DISABLE_TRACING
+/* sizeof keeps variables only used by trace points from being reported as unused, without evaluating anything */
+#    define AWS_TRACE_EVENT(event_id, arg0, arg1)                                                                     \
+        do {                                                                                                           \
+            (void)sizeof(event_id);                                                                                    \
+            (void)sizeof(arg0);                                                                                        \
+            (void)sizeof(arg1);                                                                                        \
+        } while (0)
+#else
+/**
+ * Records an event if tracing is enabled. The arguments are only evaluated when it is.
+ */
+#    define AWS_TRACE_EVENT(event_id, arg0, arg1)                                                                     \
+        do {                                                                                                           \
+            if (AWS_UNLIKELY(aws_trace_is_enabled())) {                                                                \
+                aws_trace_record((uint32_t)(event_id), (uint64_t)(arg0), (uint64_t)(arg1));                            \
+            }                                                                                                          \
+        } while (0)
+#endif
+
+#endif /* AWS_COMMON_TRACE_H */
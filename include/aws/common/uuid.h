@@ -27,13 +27,104 @@ struct aws_uuid {
 /* 36 bytes for the UUID plus one more for the null terminator. */
 #define AWS_UUID_STR_LEN 37
 
+/*
+ * A ULID: a 48-bit millisecond unix timestamp followed by 80 random bits, written as 26 Crockford base32 characters.
+ * Like UUIDv7, ULIDs sort by creation time both as bytes and as strings.
+ */
+struct aws_ulid {
+    uint8_t ulid_data[16];
+};
+
+/* 26 bytes for the ULID plus one more for the null terminator. */
+#define AWS_ULID_STR_LEN 27
+
 AWS_EXTERN_C_BEGIN
 
+/**
+ * Initializes a random version 4 UUID (RFC 9562): 122 random bits plus the version and variant bits.
+ */
 AWS_COMMON_API int aws_uuid_init(struct aws_uuid *uuid);
+
+/**
+ * Initializes a time-ordered version 7 UUID (RFC 9562): the current unix time in milliseconds followed by random bits.
+ * Keys made this way land next to each other in B-trees and sorted logs instead of all over the index.
+ *
+ * UUIDs made in the same process are strictly increasing, even within a millisecond or if the clock steps back: the
+ * random bits of the previous one are incremented instead of drawn again. This makes a UUID easy to guess from the one
+ * before it, so don't use them as secrets.
+ */
+AWS_COMMON_API int aws_uuid_init_v7(struct aws_uuid *uuid);
+
+/**
+ * Initializes count increasing version 7 UUIDs with a single clock read and random draw.
+ */
+AWS_COMMON_API int aws_uuid_init_v7_batch(struct aws_uuid *uuids, size_t count);
+
+/**
+ * Parses the first 36 characters of uuid_str, in the 8-4-4-4-12 form, with hex digits of either case.
+ */
 AWS_COMMON_API int aws_uuid_init_from_str(struct aws_uuid *uuid, const struct aws_byte_cursor *uuid_str);
+
+/**
+ * Appends uuid to output as 36 lowercase characters in the 8-4-4-4-12 form. output must have room for
+ * AWS_UUID_STR_LEN more bytes: a null terminator is written after the string but not counted in output->len.
+ */
 AWS_COMMON_API int aws_uuid_to_str(const struct aws_uuid *uuid, struct aws_byte_buf *output);
+
+/**
+ * Appends count UUIDs to output as in aws_uuid_to_str(), back to back with no separators or terminator, so the i-th
+ * starts (AWS_UUID_STR_LEN - 1) * i bytes past the original end of output. Nothing is written if output doesn't have
+ * room for all of them.
+ */
+AWS_COMMON_API int aws_uuid_array_to_str(const struct aws_uuid *uuids, size_t count, struct aws_byte_buf *output);
 AWS_COMMON_API bool aws_uuid_equals(const struct aws_uuid *a, const struct aws_uuid *b);
 
+/**
+ * Compares the bytes of two UUIDs, returning a negative number, 0, or a positive number like memcmp. Version 7 UUIDs
+ * compare in creation order.
+ */
+AWS_COMMON_API int aws_uuid_compare(const struct aws_uuid *a, const struct aws_uuid *b);
+
+/**
+ * aws_hash_table hash and equality functions for keys that point to a struct aws_uuid.
+ */
+AWS_COMMON_API uint64_t aws_hash_uuid(const void *item);
+AWS_COMMON_API bool aws_hash_callback_uuid_eq(const void *a, const void *b);
+
+/**
+ * Initializes a ULID from the current time, with the same ordering guarantees, and caveat, as aws_uuid_init_v7().
+ */
+AWS_COMMON_API int aws_ulid_init(struct aws_ulid *ulid);
+
+/**
+ * Initializes count increasing ULIDs with a single clock read and random draw.
+ */
+AWS_COMMON_API int aws_ulid_init_batch(struct aws_ulid *ulids, size_t count);
+
+/**
+ * Parses the first 26 characters of ulid_str. Crockford base32 is case insensitive, and reads I and L as 1 and O as 0.
+ */
+AWS_COMMON_API int aws_ulid_init_from_str(struct aws_ulid *ulid, const struct aws_byte_cursor *ulid_str);
+
+/**
+ * Appends ulid to output as 26 uppercase characters. output must have room for AWS_ULID_STR_LEN more bytes: a null
+ * terminator is written after the string but not counted in output->len.
+ */
+AWS_COMMON_API int aws_ulid_to_str(const struct aws_ulid *ulid, struct aws_byte_buf *output);
+
+AWS_COMMON_API bool aws_ulid_equals(const struct aws_ulid *a, const struct aws_ulid *b);
+
+/**
+ * Compares two ULIDs like memcmp, which orders them by creation time.
+ */
+AWS_COMMON_API int aws_ulid_compare(const struct aws_ulid *a, const struct aws_ulid *b);
+
+/**
+ * aws_hash_table hash and equality functions for keys that point to a struct aws_ulid.
+ */
+AWS_COMMON_API uint64_t aws_hash_ulid(const void *item);
+AWS_COMMON_API bool aws_hash_callback_ulid_eq(const void *a, const void *b);
+
 AWS_EXTERN_C_END
 
 #endif /* AWS_COMMON_UUID_H */
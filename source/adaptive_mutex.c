@@ -0,0 +1,180 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+/* for syscall() */
+#    define _GNU_SOURCE
+#endif
+
+#include <aws/common/adaptive_mutex.h>
+
+#include <aws/common/byte_order.h>
+#include <aws/common/system_info.h>
+
+#if defined(__linux__)
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+enum {
+    S_UNLOCKED = 0,
+    S_LOCKED = 1,
+    S_LOCKED_PARKED = 2,
+};
+
+/* Total pause instructions a locker issues before parking; roughly a few microseconds on current hardware. */
+#define S_SPIN_LIMIT 4096
+/* Cap on pauses between two looks at the lock, so a released lock is noticed quickly. */
+#define S_MAX_BACKOFF 64
+
+#if defined(__linux__)
+
+/* The kernel compares the futex word as a 32-bit int, which is the low half of the atomic's value. */
+static uint32_t *s_futex_word(struct aws_adaptive_mutex *mutex) {
+    uint32_t *word = (uint32_t *)&mutex->state.value;
+    if (sizeof(mutex->state.value) == 8 && aws_is_big_endian()) {
+        ++word;
+    }
+    return word;
+}
+
+static int s_park_init(struct aws_adaptive_mutex *mutex) {
+    (void)mutex;
+    return AWS_OP_SUCCESS;
+}
+
+static void s_park_clean_up(struct aws_adaptive_mutex *mutex) {
+    (void)mutex;
+}
+
+/* Sleeps while the state is S_LOCKED_PARKED. May return spuriously. */
+static void s_park(struct aws_adaptive_mutex *mutex) {
+    syscall(SYS_futex, s_futex_word(mutex), FUTEX_WAIT_PRIVATE, S_LOCKED_PARKED, NULL, NULL, 0);
+}
+
+static void s_unpark_one(struct aws_adaptive_mutex *mutex) {
+    syscall(SYS_futex, s_futex_word(mutex), FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+#else
+
+static int s_park_init(struct aws_adaptive_mutex *mutex) {
+    if (aws_mutex_init(&mutex->park_mutex)) {
+        return AWS_OP_ERR;
+    }
+
+    if (aws_condition_variable_init(&mutex->park_signal)) {
+        aws_mutex_clean_up(&mutex->park_mutex);
+        return AWS_OP_ERR;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_park_clean_up(struct aws_adaptive_mutex *mutex) {
+    aws_condition_variable_clean_up(&mutex->park_signal);
+    aws_mutex_clean_up(&mutex->park_mutex);
+}
+
+/*
+ * Sleeps while the state is S_LOCKED_PARKED. May return spuriously. The state is rechecked under park_mutex, and
+ * unparking takes park_mutex after the state has changed, so a wakeup can not be lost between check and wait.
+ */
+static void s_park(struct aws_adaptive_mutex *mutex) {
+    aws_mutex_lock(&mutex->park_mutex);
+    if (aws_atomic_load_int(&mutex->state) == S_LOCKED_PARKED) {
+        aws_condition_variable_wait(&mutex->park_signal, &mutex->park_mutex);
+    }
+    aws_mutex_unlock(&mutex->park_mutex);
+}
+
+static void s_unpark_one(struct aws_adaptive_mutex *mutex) {
+    aws_mutex_lock(&mutex->park_mutex);
+    aws_condition_variable_notify_one(&mutex->park_signal);
+    aws_mutex_unlock(&mutex->park_mutex);
+}
+
+#endif
+
+int aws_adaptive_mutex_init(struct aws_adaptive_mutex *mutex) {
+    aws_atomic_init_int(&mutex->state, S_UNLOCKED);
+    mutex->spin_limit = aws_system_info_processor_count() > 1 ? S_SPIN_LIMIT : 0;
+
+    return s_park_init(mutex);
+}
+
+void aws_adaptive_mutex_clean_up(struct aws_adaptive_mutex *mutex) {
+    s_park_clean_up(mutex);
+    AWS_ZERO_STRUCT(*mutex);
+}
+
+static bool s_try_acquire(struct aws_adaptive_mutex *mutex) {
+    size_t expected = S_UNLOCKED;
+    return aws_atomic_compare_exchange_int_explicit(
+        &mutex->state, &expected, S_LOCKED, aws_memory_order_acquire, aws_memory_order_relaxed);
+}
+
+int aws_adaptive_mutex_lock(struct aws_adaptive_mutex *mutex) {
+    if (AWS_LIKELY(s_try_acquire(mutex))) {
+        return AWS_OP_SUCCESS;
+    }
+
+    /* Spin, reading rather than writing the lock word so waiters don't fight over the cache line. */
+    size_t backoff = 1;
+    for (size_t spun = 0; spun < mutex->spin_limit; spun += backoff) {
+        for (size_t i = 0; i < backoff; ++i) {
+            aws_atomic_spin_hint();
+        }
+
+        if (aws_atomic_load_int_explicit(&mutex->state, aws_memory_order_relaxed) == S_UNLOCKED &&
+            s_try_acquire(mutex)) {
+            return AWS_OP_SUCCESS;
+        }
+
+        if (backoff < S_MAX_BACKOFF) {
+            backoff <<= 1;
+        }
+    }
+
+    /*
+     * Park. Once we have been parked we can't know whether other threads are still parked, so we always take the lock
+     * in the parked state; the cost is one possibly unneeded wake on unlock.
+     */
+    while (aws_atomic_exchange_int_explicit(&mutex->state, S_LOCKED_PARKED, aws_memory_order_acquire) != S_UNLOCKED) {
+        s_park(mutex);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_adaptive_mutex_try_lock(struct aws_adaptive_mutex *mutex) {
+    if (s_try_acquire(mutex)) {
+        return AWS_OP_SUCCESS;
+    }
+
+    return aws_raise_error(AWS_ERROR_MUTEX_TIMEOUT);
+}
+
+int aws_adaptive_mutex_unlock(struct aws_adaptive_mutex *mutex) {
+    size_t prev = aws_atomic_exchange_int_explicit(&mutex->state, S_UNLOCKED, aws_memory_order_release);
+    if (prev == S_LOCKED_PARKED) {
+        s_unpark_one(mutex);
+    } else if (prev == S_UNLOCKED) {
+        return aws_raise_error(AWS_ERROR_MUTEX_CALLER_NOT_OWNER);
+    }
+
+    return AWS_OP_SUCCESS;
+}
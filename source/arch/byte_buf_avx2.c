@@ -0,0 +1,168 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+/* for _BitScanForward */
+#    include <intrin.h>
+#endif
+
+#include <string.h>
+
+#include <aws/common/common.h>
+
+/*
+ * Returns the index of the lowest set bit in mask. mask must be non-zero.
+ */
+static inline size_t s_lowest_bit(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (size_t)index;
+#else
+    return (size_t)__builtin_ctz(mask);
+#endif
+}
+
+/*
+ * Returns a bitmask with bit i set if block[i] is any of the byte_set_len broadcast vectors in set_vecs.
+ */
+static inline uint32_t s_match_any_of(__m256i block, const __m256i *set_vecs, size_t byte_set_len) {
+    __m256i hits = _mm256_cmpeq_epi8(block, set_vecs[0]);
+    for (size_t i = 1; i < byte_set_len; ++i) {
+        hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, set_vecs[i]));
+    }
+
+    return (uint32_t)_mm256_movemask_epi8(hits);
+}
+
+/*
+ * Returns the index of the first byte of str that is in byte_set, or len if there is none.
+ * Requires len >= 32 and 1 <= byte_set_len <= 8.
+ */
+size_t aws_common_private_byte_cursor_find_any_of_avx2(
+    const uint8_t *str,
+    size_t len,
+    const uint8_t *byte_set,
+    size_t byte_set_len) {
+
+    __m256i set_vecs[8];
+    for (size_t i = 0; i < byte_set_len; ++i) {
+        set_vecs[i] = _mm256_set1_epi8((char)byte_set[i]);
+    }
+
+    size_t offset = 0;
+    for (; offset + 32 <= len; offset += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(str + offset));
+        uint32_t mask = s_match_any_of(block, set_vecs, byte_set_len);
+        if (mask) {
+            return offset + s_lowest_bit(mask);
+        }
+    }
+
+    if (offset < len) {
+        /*
+         * Rather than falling back to a scalar loop for the tail, re-scan the last 32 bytes of the input and discard
+         * the matches that overlap the part we've already searched.
+         */
+        size_t overlap = offset - (len - 32);
+        __m256i block = _mm256_loadu_si256((const __m256i *)(str + len - 32));
+        uint32_t mask = s_match_any_of(block, set_vecs, byte_set_len) >> overlap;
+        if (mask) {
+            return offset + s_lowest_bit(mask);
+        }
+    }
+
+    return len;
+}
+
+/*
+ * Returns the index of the first instance of to_find in str, or len if there is none.
+ * Requires to_find_len >= 2 and len >= to_find_len.
+ *
+ * Candidates are filtered 32 positions at a time by comparing both the first and last byte of to_find, so the memcmp
+ * only runs on positions where both ends already match.
+ */
+size_t aws_common_private_byte_cursor_find_substring_avx2(
+    const uint8_t *str,
+    size_t len,
+    const uint8_t *to_find,
+    size_t to_find_len) {
+
+    const __m256i first = _mm256_set1_epi8((char)to_find[0]);
+    const __m256i last = _mm256_set1_epi8((char)to_find[to_find_len - 1]);
+
+    size_t offset = 0;
+    for (; offset + to_find_len - 1 + 32 <= len; offset += 32) {
+        __m256i block_first = _mm256_loadu_si256((const __m256i *)(str + offset));
+        __m256i block_last = _mm256_loadu_si256((const __m256i *)(str + offset + to_find_len - 1));
+
+        __m256i eq_first = _mm256_cmpeq_epi8(first, block_first);
+        __m256i eq_last = _mm256_cmpeq_epi8(last, block_last);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(eq_first, eq_last));
+
+        while (mask) {
+            size_t candidate = offset + s_lowest_bit(mask);
+            if (!memcmp(str + candidate + 1, to_find + 1, to_find_len - 2)) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    for (; offset + to_find_len <= len; ++offset) {
+        if (str[offset] == to_find[0] && !memcmp(str + offset + 1, to_find + 1, to_find_len - 1)) {
+            return offset;
+        }
+    }
+
+    return len;
+}
+
+/*
+ * Lowercases the ASCII letters in a 256-bit vector; all other bytes are left untouched.
+ */
+static inline __m256i s_tolower_vec(__m256i in) {
+    __m256i offset = _mm256_sub_epi8(in, _mm256_set1_epi8('A'));
+    /* unsigned (in - 'A') <= 25 means in is an uppercase letter */
+    __m256i is_upper = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8('Z' - 'A')), offset);
+    return _mm256_or_si256(in, _mm256_and_si256(is_upper, _mm256_set1_epi8(0x20)));
+}
+
+static inline bool s_eq_ignore_case_vec(const uint8_t *a, const uint8_t *b) {
+    __m256i lower_a = s_tolower_vec(_mm256_loadu_si256((const __m256i *)a));
+    __m256i lower_b = s_tolower_vec(_mm256_loadu_si256((const __m256i *)b));
+    return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lower_a, lower_b)) == UINT32_MAX;
+}
+
+/*
+ * Returns true if a and b are equal after ASCII lowercasing. Requires len >= 32.
+ */
+bool aws_common_private_byte_cursor_eq_ignore_case_avx2(const uint8_t *a, const uint8_t *b, size_t len) {
+    size_t offset = 0;
+    for (; offset + 32 <= len; offset += 32) {
+        if (!s_eq_ignore_case_vec(a + offset, b + offset)) {
+            return false;
+        }
+    }
+
+    /* Compare the tail by re-checking the last full vector, which overlaps bytes already known to be equal. */
+    if (offset < len) {
+        return s_eq_ignore_case_vec(a + len - 32, b + len - 32);
+    }
+
+    return true;
+}
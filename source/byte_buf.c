@@ -24,6 +24,64 @@
 #    pragma warning(disable : 4706)
 #endif
 
+#ifdef USE_SIMD_BYTE_BUF
+size_t aws_common_private_byte_cursor_find_any_of_avx2(
+    const uint8_t *str,
+    size_t len,
+    const uint8_t *byte_set,
+    size_t byte_set_len);
+size_t aws_common_private_byte_cursor_find_substring_avx2(
+    const uint8_t *str,
+    size_t len,
+    const uint8_t *to_find,
+    size_t to_find_len);
+bool aws_common_private_byte_cursor_eq_ignore_case_avx2(const uint8_t *a, const uint8_t *b, size_t len);
+bool aws_common_private_has_avx2(void);
+#else
+/*
+ * When AVX2 compilation is unavailable, we use these stubs to fall back to the pure-C search.
+ * Since we force aws_common_private_has_avx2 to return false, the SIMD functions should
+ * not be called - but we must provide them anyway to avoid link errors.
+ */
+static inline size_t aws_common_private_byte_cursor_find_any_of_avx2(
+    const uint8_t *str,
+    size_t len,
+    const uint8_t *byte_set,
+    size_t byte_set_len) {
+    (void)str;
+    (void)byte_set;
+    (void)byte_set_len;
+    assert(false);
+    return len; /* unreachable */
+}
+static inline size_t aws_common_private_byte_cursor_find_substring_avx2(
+    const uint8_t *str,
+    size_t len,
+    const uint8_t *to_find,
+    size_t to_find_len) {
+    (void)str;
+    (void)to_find;
+    (void)to_find_len;
+    assert(false);
+    return len; /* unreachable */
+}
+static inline bool aws_common_private_byte_cursor_eq_ignore_case_avx2(const uint8_t *a, const uint8_t *b, size_t len) {
+    (void)a;
+    (void)b;
+    (void)len;
+    assert(false);
+    return false; /* unreachable */
+}
+static inline bool aws_common_private_has_avx2(void) {
+    return false;
+}
+#endif
+
+/* Inputs shorter than one 256-bit vector aren't worth the SIMD setup cost. */
+#define AWS_BYTE_CURSOR_SIMD_MIN_LEN 32
+/* Each byte in the set costs one compare per vector, so beyond this we use the lookup table instead. */
+#define AWS_BYTE_CURSOR_SIMD_MAX_SET_LEN 8
+
 int aws_byte_buf_init(struct aws_byte_buf *buf, struct aws_allocator *allocator, size_t capacity) {
     buf->buffer = (uint8_t *)aws_mem_acquire(allocator, capacity);
     if (!buf->buffer) {
@@ -140,11 +198,11 @@ bool aws_byte_cursor_next_split(
         }
     }
 
-    uint8_t *new_location = memchr(substr->ptr, split_on, substr->len);
-    if (new_location) {
+    struct aws_byte_cursor next_token;
+    if (aws_byte_cursor_find_byte(substr, (uint8_t)split_on, &next_token)) {
 
         /* Character found, update string length. */
-        substr->len = new_location - substr->ptr;
+        substr->len = next_token.ptr - substr->ptr;
     }
 
     return true;
@@ -190,6 +248,133 @@ int aws_byte_cursor_split_on_char(
     return aws_byte_cursor_split_on_char_n(input_str, split_on, 0, output);
 }
 
+static inline bool s_set_find_result(
+    const struct aws_byte_cursor *AWS_RESTRICT input_str,
+    size_t index,
+    struct aws_byte_cursor *AWS_RESTRICT result) {
+
+    if (index >= input_str->len) {
+        AWS_ZERO_STRUCT(*result);
+        return false;
+    }
+
+    result->ptr = input_str->ptr + index;
+    result->len = input_str->len - index;
+    return true;
+}
+
+bool aws_byte_cursor_find_byte(
+    const struct aws_byte_cursor *AWS_RESTRICT input_str,
+    uint8_t value,
+    struct aws_byte_cursor *AWS_RESTRICT result) {
+    assert(input_str);
+    assert(result);
+
+    /* memchr is already vectorized by every libc we ship against, so there's nothing to gain by hand-rolling it. */
+    const uint8_t *found = input_str->len ? memchr(input_str->ptr, value, input_str->len) : NULL;
+    if (!found) {
+        AWS_ZERO_STRUCT(*result);
+        return false;
+    }
+
+    return s_set_find_result(input_str, (size_t)(found - input_str->ptr), result);
+}
+
+static size_t s_find_any_of_scalar(const uint8_t *str, size_t len, const uint8_t *byte_set, size_t byte_set_len) {
+    /* 256-bit membership mask, one bit per possible byte value. */
+    uint64_t members[4] = {0, 0, 0, 0};
+    for (size_t i = 0; i < byte_set_len; ++i) {
+        members[byte_set[i] >> 6] |= (uint64_t)1 << (byte_set[i] & 63);
+    }
+
+    for (size_t i = 0; i < len; ++i) {
+        if (members[str[i] >> 6] & ((uint64_t)1 << (str[i] & 63))) {
+            return i;
+        }
+    }
+
+    return len;
+}
+
+bool aws_byte_cursor_find_any_of(
+    const struct aws_byte_cursor *AWS_RESTRICT input_str,
+    const struct aws_byte_cursor *AWS_RESTRICT byte_set,
+    struct aws_byte_cursor *AWS_RESTRICT result) {
+    assert(input_str);
+    assert(byte_set);
+    assert(result);
+
+    if (byte_set->len == 1) {
+        return aws_byte_cursor_find_byte(input_str, byte_set->ptr[0], result);
+    }
+
+    size_t index = input_str->len;
+    if (input_str->len >= AWS_BYTE_CURSOR_SIMD_MIN_LEN && byte_set->len <= AWS_BYTE_CURSOR_SIMD_MAX_SET_LEN &&
+        byte_set->len > 0 && aws_common_private_has_avx2()) {
+        index = aws_common_private_byte_cursor_find_any_of_avx2(
+            input_str->ptr, input_str->len, byte_set->ptr, byte_set->len);
+    } else if (byte_set->len > 0) {
+        index = s_find_any_of_scalar(input_str->ptr, input_str->len, byte_set->ptr, byte_set->len);
+    }
+
+    return s_set_find_result(input_str, index, result);
+}
+
+static size_t s_find_substring_scalar(const uint8_t *str, size_t len, const uint8_t *to_find, size_t to_find_len) {
+    const uint8_t *start = str;
+    const uint8_t *last_start = str + (len - to_find_len);
+    const uint8_t last_byte = to_find[to_find_len - 1];
+
+    /* Let memchr skip ahead to candidates, then reject most false positives on the last byte before the memcmp. */
+    while (start <= last_start) {
+        start = memchr(start, to_find[0], (size_t)(last_start - start) + 1);
+        if (!start) {
+            break;
+        }
+
+        if (start[to_find_len - 1] == last_byte && !memcmp(start + 1, to_find + 1, to_find_len - 1)) {
+            return (size_t)(start - str);
+        }
+
+        ++start;
+    }
+
+    return len;
+}
+
+bool aws_byte_cursor_find_substring(
+    const struct aws_byte_cursor *AWS_RESTRICT input_str,
+    const struct aws_byte_cursor *AWS_RESTRICT to_find,
+    struct aws_byte_cursor *AWS_RESTRICT result) {
+    assert(input_str);
+    assert(to_find);
+    assert(result);
+
+    if (to_find->len == 0) {
+        *result = *input_str;
+        return true;
+    }
+
+    if (to_find->len == 1) {
+        return aws_byte_cursor_find_byte(input_str, to_find->ptr[0], result);
+    }
+
+    if (to_find->len > input_str->len) {
+        AWS_ZERO_STRUCT(*result);
+        return false;
+    }
+
+    size_t index = 0;
+    if (input_str->len >= AWS_BYTE_CURSOR_SIMD_MIN_LEN && aws_common_private_has_avx2()) {
+        index = aws_common_private_byte_cursor_find_substring_avx2(
+            input_str->ptr, input_str->len, to_find->ptr, to_find->len);
+    } else {
+        index = s_find_substring_scalar(input_str->ptr, input_str->len, to_find->ptr, to_find->len);
+    }
+
+    return s_set_find_result(input_str, index, result);
+}
+
 int aws_byte_buf_cat(struct aws_byte_buf *dest, size_t number_of_args, ...) {
     assert(dest);
 
@@ -242,6 +427,29 @@ static const uint8_t s_tolower_table[256] = {
     220, 221, 222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239, 240, 241,
     242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254, 255};
 
+/*
+ * Lowercases the ASCII letters in 8 bytes at once, matching s_tolower_table (bytes >= 0x80 are left untouched).
+ * Each byte's low 7 bits are offset so that bit 7 of the sum says whether it's >= 'A' or > 'Z', which can't carry
+ * into the neighboring byte; letters then get 0x20 OR'd in.
+ */
+static inline uint64_t s_tolower_u64(uint64_t word) {
+    const uint64_t low_bits = 0x7f7f7f7f7f7f7f7fULL;
+    const uint64_t high_bits = 0x8080808080808080ULL;
+
+    uint64_t heptets = word & low_bits;
+    uint64_t is_gt_z = heptets + 0x2525252525252525ULL; /* 0x7f - 'Z' */
+    uint64_t is_ge_a = heptets + 0x3f3f3f3f3f3f3f3fULL; /* 0x80 - 'A' */
+    uint64_t is_upper = (is_ge_a ^ is_gt_z) & ~word & high_bits;
+
+    return word | (is_upper >> 2);
+}
+
+static inline uint64_t s_load_u64(const uint8_t *ptr) {
+    uint64_t word;
+    memcpy(&word, ptr, sizeof(word));
+    return word;
+}
+
 bool aws_byte_cursor_eq_case_insensitive(const struct aws_byte_cursor *a, const struct aws_byte_cursor *b) {
     if (!a || !b) {
         return a == b;
@@ -251,7 +459,18 @@ bool aws_byte_cursor_eq_case_insensitive(const struct aws_byte_cursor *a, const
         return false;
     }
 
-    for (size_t i = 0; i < a->len; ++i) {
+    if (a->len >= AWS_BYTE_CURSOR_SIMD_MIN_LEN && aws_common_private_has_avx2()) {
+        return aws_common_private_byte_cursor_eq_ignore_case_avx2(a->ptr, b->ptr, a->len);
+    }
+
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= a->len; i += sizeof(uint64_t)) {
+        if (s_tolower_u64(s_load_u64(a->ptr + i)) != s_tolower_u64(s_load_u64(b->ptr + i))) {
+            return false;
+        }
+    }
+
+    for (; i < a->len; ++i) {
         if (s_tolower_table[a->ptr[i]] != s_tolower_table[b->ptr[i]]) {
             return false;
         }
@@ -270,6 +489,22 @@ uint64_t aws_hash_byte_cursor_ptr_case_insensitive(const void *item) {
     const uint8_t *end = cursor->ptr + cursor->len;
 
     uint64_t hash = fnv_offset_basis;
+
+    /*
+     * FNV-1a is inherently serial, so only the case folding is done 8 bytes at a time; the folded bytes are then
+     * mixed in the same order as the per-byte loop, so results are identical.
+     */
+    while ((size_t)(end - i) >= sizeof(uint64_t)) {
+        uint8_t lower[sizeof(uint64_t)];
+        uint64_t folded = s_tolower_u64(s_load_u64(i));
+        memcpy(lower, &folded, sizeof(lower));
+        for (size_t j = 0; j < sizeof(lower); ++j) {
+            hash ^= lower[j];
+            hash *= fnv_prime;
+        }
+        i += sizeof(uint64_t);
+    }
+
     while (i != end) {
         const uint8_t lower = s_tolower_table[*i++];
         hash ^= lower;
@@ -295,6 +530,39 @@ bool aws_byte_cursor_eq_byte_buf(const struct aws_byte_cursor *a, const struct a
     return !memcmp(a->ptr, b->buffer, a->len);
 }
 
+size_t aws_byte_cursor_read_varint_u64_n(
+    struct aws_byte_cursor *AWS_RESTRICT cur,
+    uint64_t *AWS_RESTRICT out,
+    size_t count) {
+    assert(cur);
+    assert(out || count == 0);
+
+    size_t read = 0;
+    while (read < count) {
+        /* If the next 8 bytes all have their continuation bit clear, they're 8 complete single byte varints. */
+        if (count - read >= sizeof(uint64_t) && cur->len >= sizeof(uint64_t)) {
+            uint64_t word;
+            memcpy(&word, cur->ptr, sizeof(word));
+
+            if (!(word & 0x8080808080808080ULL)) {
+                for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+                    out[read + i] = cur->ptr[i];
+                }
+                read += sizeof(uint64_t);
+                aws_byte_cursor_advance(cur, sizeof(uint64_t));
+                continue;
+            }
+        }
+
+        if (!aws_byte_cursor_read_varint_u64(cur, &out[read])) {
+            break;
+        }
+        ++read;
+    }
+
+    return read;
+}
+
 int aws_byte_buf_append(struct aws_byte_buf *to, const struct aws_byte_cursor *from) {
     assert(from->ptr);
     assert(to->buffer);
@@ -345,3 +613,86 @@ bool aws_byte_cursor_satisfies_pred(const struct aws_byte_cursor *source, aws_by
 
     return trimmed.len == 0;
 }
+
+/* clang-format off */
+const struct aws_byte_class aws_byte_class_whitespace = {
+    .mask = {0x0000000100003e00ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL}};
+
+const struct aws_byte_class aws_byte_class_digit = {
+    .mask = {0x03ff000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL}};
+
+const struct aws_byte_class aws_byte_class_alnum = {
+    .mask = {0x03ff000000000000ULL, 0x07fffffe07fffffeULL, 0x0000000000000000ULL, 0x0000000000000000ULL}};
+
+const struct aws_byte_class aws_byte_class_token = {
+    .mask = {0x03ff6cfa00000000ULL, 0x57ffffffc7fffffeULL, 0x0000000000000000ULL, 0x0000000000000000ULL}};
+/* clang-format on */
+
+void aws_byte_class_init(struct aws_byte_class *byte_class, const struct aws_byte_cursor *members) {
+    assert(byte_class);
+    assert(members);
+
+    AWS_ZERO_STRUCT(*byte_class);
+    for (size_t i = 0; i < members->len; ++i) {
+        uint8_t value = members->ptr[i];
+        byte_class->mask[value >> 6] |= (uint64_t)1 << (value & 63);
+    }
+}
+
+void aws_byte_class_init_from_pred(struct aws_byte_class *byte_class, aws_byte_predicate_fn predicate) {
+    assert(byte_class);
+    assert(predicate);
+
+    AWS_ZERO_STRUCT(*byte_class);
+    for (size_t value = 0; value < 256; ++value) {
+        if (predicate((uint8_t)value)) {
+            byte_class->mask[value >> 6] |= (uint64_t)1 << (value & 63);
+        }
+    }
+}
+
+struct aws_byte_cursor aws_byte_cursor_right_trim_class(
+    const struct aws_byte_cursor *source,
+    const struct aws_byte_class *byte_class) {
+    /* Copy the mask locally so the compiler knows it can't alias the bytes we're scanning. */
+    const struct aws_byte_class local_class = *byte_class;
+    struct aws_byte_cursor trimmed = *source;
+
+    while (trimmed.len > 0 && aws_byte_class_contains(&local_class, trimmed.ptr[trimmed.len - 1])) {
+        --trimmed.len;
+    }
+
+    return trimmed;
+}
+
+struct aws_byte_cursor aws_byte_cursor_left_trim_class(
+    const struct aws_byte_cursor *source,
+    const struct aws_byte_class *byte_class) {
+    /* Copy the mask locally so the compiler knows it can't alias the bytes we're scanning. */
+    const struct aws_byte_class local_class = *byte_class;
+    const uint8_t *ptr = source->ptr;
+    const uint8_t *end = source->ptr + source->len;
+
+    while (ptr != end && aws_byte_class_contains(&local_class, *ptr)) {
+        ++ptr;
+    }
+
+    struct aws_byte_cursor trimmed = {
+        .ptr = (uint8_t *)ptr,
+        .len = (size_t)(end - ptr),
+    };
+    return trimmed;
+}
+
+struct aws_byte_cursor aws_byte_cursor_trim_class(
+    const struct aws_byte_cursor *source,
+    const struct aws_byte_class *byte_class) {
+    struct aws_byte_cursor left_trimmed = aws_byte_cursor_left_trim_class(source, byte_class);
+    return aws_byte_cursor_right_trim_class(&left_trimmed, byte_class);
+}
+
+bool aws_byte_cursor_satisfies_class(const struct aws_byte_cursor *source, const struct aws_byte_class *byte_class) {
+    struct aws_byte_cursor trimmed = aws_byte_cursor_left_trim_class(source, byte_class);
+
+    return trimmed.len == 0;
+}
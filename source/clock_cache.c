@@ -0,0 +1,43 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/clock.h>
+
+static AWS_THREAD_LOCAL bool tl_cache_valid = false;
+static AWS_THREAD_LOCAL uint64_t tl_cached_sys_ticks = 0;
+
+int aws_sys_clock_cache_refresh(void) {
+    uint64_t now = 0;
+    if (aws_sys_clock_get_ticks(&now)) {
+        return AWS_OP_ERR;
+    }
+
+    tl_cached_sys_ticks = now;
+    tl_cache_valid = true;
+    return AWS_OP_SUCCESS;
+}
+
+void aws_sys_clock_cache_clear(void) {
+    tl_cache_valid = false;
+}
+
+int aws_sys_clock_get_ticks_cached(uint64_t *timestamp) {
+    if (tl_cache_valid) {
+        *timestamp = tl_cached_sys_ticks;
+        return AWS_OP_SUCCESS;
+    }
+
+    return aws_sys_clock_get_ticks_coarse(timestamp);
+}
@@ -35,8 +35,11 @@
 #include <aws/common/math.h>
 #include <aws/common/mutex.h>
 #include <aws/common/priority_queue.h>
+#include <aws/common/prng.h>
 #include <aws/common/rw_lock.h>
+#include <aws/common/seqlock.h>
 #include <aws/common/string.h>
 #include <aws/common/system_info.h>
 #include <aws/common/task_scheduler.h>
 #include <aws/common/thread.h>
+#include <aws/common/trace.h>
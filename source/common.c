@@ -15,6 +15,8 @@
 
 #include <aws/common/common.h>
 
+#include <aws/common/trace.h>
+
 #include <stdarg.h>
 #include <stdlib.h>
 
@@ -32,6 +34,19 @@
 #    pragma warning(disable : 4100)
 #endif
 
+#ifdef AWS_DISABLE_TRACING
+#    define TRACE_ALLOCATION(event_id, arg0, arg1) AWS_TRACE_EVENT(event_id, arg0, arg1)
+#else
+/* allocation events are opt-in on top of tracing itself, see aws_trace_set_allocations_enabled() */
+#    define TRACE_ALLOCATION(event_id, arg0, arg1)                                                                    \
+        do {                                                                                                           \
+            if (AWS_UNLIKELY(aws_atomic_load_int_explicit(                                                             \
+                    &aws_trace_private_allocations_enabled, aws_memory_order_relaxed))) {                              \
+                AWS_TRACE_EVENT(event_id, arg0, arg1);                                                                 \
+            }                                                                                                          \
+        } while (0)
+#endif
+
 static void *s_default_malloc(struct aws_allocator *allocator, size_t size) {
     (void)allocator;
     return malloc(size);
@@ -62,7 +77,9 @@ void *aws_mem_acquire(struct aws_allocator *allocator, size_t size) {
     void *mem = allocator->mem_acquire(allocator, size);
     if (!mem) {
         aws_raise_error(AWS_ERROR_OOM);
+        return NULL;
     }
+    TRACE_ALLOCATION(AWS_TRACE_EVENT_MEM_ACQUIRE, (uintptr_t)mem, size);
     return mem;
 }
 
@@ -119,6 +136,7 @@ cleanup:
 #undef AWS_ALIGN_ROUND_UP
 
 void aws_mem_release(struct aws_allocator *allocator, void *ptr) {
+    TRACE_ALLOCATION(AWS_TRACE_EVENT_MEM_RELEASE, (uintptr_t)ptr, 0);
     allocator->mem_release(allocator, ptr);
 }
 
@@ -128,6 +146,8 @@ int aws_mem_realloc(struct aws_allocator *allocator, void **ptr, size_t oldsize,
         if (!newptr) {
             return aws_raise_error(AWS_ERROR_OOM);
         }
+        TRACE_ALLOCATION(AWS_TRACE_EVENT_MEM_RELEASE, (uintptr_t)*ptr, 0);
+        TRACE_ALLOCATION(AWS_TRACE_EVENT_MEM_ACQUIRE, (uintptr_t)newptr, newsize);
         *ptr = newptr;
         return AWS_OP_SUCCESS;
     }
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/private/cpu_topology.h>
+
+static uint32_t s_package_id(const struct aws_cpu_info *cpu) {
+    return cpu->package_id;
+}
+
+static uint32_t s_numa_node(const struct aws_cpu_info *cpu) {
+    return cpu->numa_node;
+}
+
+/* Counts distinct values of a field. Topologies are small enough for this to be quadratic. */
+static size_t s_count_distinct(const struct aws_cpu_topology *topology, uint32_t (*get)(const struct aws_cpu_info *)) {
+    size_t count = 0;
+    for (size_t i = 0; i < topology->logical_cpu_count; ++i) {
+        bool seen = false;
+        for (size_t j = 0; j < i && !seen; ++j) {
+            seen = get(&topology->cpus[j]) == get(&topology->cpus[i]);
+        }
+        count += !seen;
+    }
+
+    return count;
+}
+
+int aws_cpu_topology_private_init_flat(struct aws_cpu_topology *topology) {
+    size_t cpu_count = aws_system_info_processor_count();
+    if (cpu_count == 0) {
+        cpu_count = 1;
+    }
+
+    topology->cpus = aws_mem_acquire(topology->allocator, cpu_count * sizeof(struct aws_cpu_info));
+    if (!topology->cpus) {
+        return AWS_OP_ERR;
+    }
+
+    for (size_t i = 0; i < cpu_count; ++i) {
+        topology->cpus[i] = (struct aws_cpu_info){.cpu_id = (uint32_t)i, .core_index = (uint32_t)i};
+    }
+    topology->logical_cpu_count = cpu_count;
+
+    return AWS_OP_SUCCESS;
+}
+
+void aws_cpu_topology_private_summarize(struct aws_cpu_topology *topology) {
+    topology->physical_core_count = 0;
+    topology->max_smt_siblings = 0;
+
+    for (size_t i = 0; i < topology->logical_cpu_count; ++i) {
+        uint32_t core_index = topology->cpus[i].core_index;
+        if (core_index >= topology->physical_core_count) {
+            topology->physical_core_count = (size_t)core_index + 1;
+        }
+
+        size_t siblings = 0;
+        for (size_t j = 0; j < topology->logical_cpu_count; ++j) {
+            siblings += topology->cpus[j].core_index == core_index;
+        }
+        if (siblings > topology->max_smt_siblings) {
+            topology->max_smt_siblings = siblings;
+        }
+    }
+
+    topology->package_count = s_count_distinct(topology, s_package_id);
+    topology->numa_node_count = s_count_distinct(topology, s_numa_node);
+}
+
+void aws_system_info_cpu_topology_clean_up(struct aws_cpu_topology *topology) {
+    if (topology->cpus) {
+        aws_mem_release(topology->allocator, topology->cpus);
+    }
+    AWS_ZERO_STRUCT(*topology);
+}
+
+const struct aws_cpu_info *aws_cpu_topology_get_cpu(const struct aws_cpu_topology *topology, uint32_t cpu_id) {
+    /* cpus is sorted by cpu_id */
+    size_t low = 0;
+    size_t high = topology->logical_cpu_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (topology->cpus[mid].cpu_id < cpu_id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low < topology->logical_cpu_count && topology->cpus[low].cpu_id == cpu_id) {
+        return &topology->cpus[low];
+    }
+    return NULL;
+}
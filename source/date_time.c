@@ -19,6 +19,7 @@
 #include <aws/common/byte_order.h>
 #include <aws/common/clock.h>
 #include <aws/common/string.h>
+#include <aws/common/thread.h>
 #include <aws/common/time.h>
 
 #include <ctype.h>
@@ -29,6 +30,12 @@ static const char *RFC822_DATE_FORMAT_STR_WITH_Z = "%a, %d %b %Y %H:%M:%S %Z";
 static const char *RFC822_SHORT_DATE_FORMAT_STR = "%a, %d %b %Y";
 static const char *ISO_8601_LONG_DATE_FORMAT_STR = "%Y-%m-%dT%H:%M:%SZ";
 static const char *ISO_8601_SHORT_DATE_FORMAT_STR = "%Y-%m-%d";
+static const char *ISO_8601_BASIC_LONG_DATE_FORMAT_STR = "%Y%m%dT%H%M%SZ";
+static const char *ISO_8601_BASIC_SHORT_DATE_FORMAT_STR = "%Y%m%d";
+
+static const char s_weekday_names[7][3] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+static const char s_month_names[12][3] =
+    {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
 
 #define STR_TRIPLET_TO_INDEX(str)                                                                                      \
     (((uint32_t)(uint8_t)tolower((str)[0]) << 0) | ((uint32_t)(uint8_t)tolower((str)[1]) << 8) |                       \
@@ -166,36 +173,151 @@ static bool is_utc_time_zone(const char *str) {
     return false;
 }
 
-struct tm s_get_time_struct(struct aws_date_time *dt, bool local_time) {
-    struct tm time;
-    AWS_ZERO_STRUCT(time);
-    if (local_time) {
-        aws_localtime(dt->timestamp, &time);
-    } else {
-        aws_gmtime(dt->timestamp, &time);
+static const int64_t SECS_PER_DAY = 86400;
+
+/* Days before the first of each month in a non-leap year. */
+static const int s_days_before_month[] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+
+/*
+ * gmtime without the libc call: glibc's gmtime_r takes the same lock as localtime_r. The date is derived with Howard
+ * Hinnant's civil_from_days, which counts 400-year eras starting on March 1st so that leap days fall at the end.
+ */
+static void s_gmtime(time_t timestamp, struct tm *time) {
+    int64_t days = (int64_t)timestamp / SECS_PER_DAY;
+    int64_t secs_of_day = (int64_t)timestamp % SECS_PER_DAY;
+    if (secs_of_day < 0) {
+        secs_of_day += SECS_PER_DAY;
+        --days;
     }
 
-    return time;
+    AWS_ZERO_STRUCT(*time);
+    time->tm_hour = (int)(secs_of_day / 3600);
+    time->tm_min = (int)(secs_of_day % 3600 / 60);
+    time->tm_sec = (int)(secs_of_day % 60);
+    /* 1970-01-01 was a Thursday */
+    time->tm_wday = (int)((days % 7 + 11) % 7);
+
+    int64_t shifted = days + 719468;
+    int64_t era = (shifted >= 0 ? shifted : shifted - 146096) / 146097;
+    int64_t day_of_era = shifted - era * 146097;
+    int64_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    int64_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    int64_t shifted_month = (5 * day_of_year + 2) / 153;
+    int month = (int)(shifted_month < 10 ? shifted_month + 2 : shifted_month - 10);
+    int64_t year = year_of_era + era * 400 + (month < 2);
+
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    time->tm_year = (int)(year - 1900);
+    time->tm_mon = month;
+    time->tm_mday = (int)(day_of_year - (153 * shifted_month + 2) / 5 + 1);
+    time->tm_yday = s_days_before_month[month] + time->tm_mday - 1 + (leap && month > 1);
+}
+
+/* Days from 1970-01-01 to a proleptic Gregorian date (month is 1-12); the inverse of the computation in s_gmtime. */
+static int64_t s_days_from_civil(int64_t year, int month, int day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t year_of_era = year - era * 400;
+    int64_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+/* Sets the timestamp and the GMT breakdown. The local breakdown is only computed when asked for, see below. */
+static void s_set_timestamp(struct aws_date_time *dt, time_t timestamp, uint32_t nanoseconds) {
+    dt->timestamp = timestamp;
+    dt->nanoseconds = nanoseconds;
+    s_gmtime(timestamp, &dt->gmt_time);
+    AWS_ZERO_STRUCT(dt->local_time);
+    dt->local_time_set = false;
+}
+
+/*
+ * Returns the broken-down time to read. localtime_r takes a libc lock and may reload TZ state, so it only runs when a
+ * caller actually wants local time, and its result goes to storage instead of dt so that a const aws_date_time can be
+ * read from several threads.
+ */
+static const struct tm *s_get_time_struct(const struct aws_date_time *dt, bool local_time, struct tm *storage) {
+    if (!local_time) {
+        return &dt->gmt_time;
+    }
+    if (dt->local_time_set) {
+        return &dt->local_time;
+    }
+
+    AWS_ZERO_STRUCT(*storage);
+    aws_localtime(dt->timestamp, storage);
+    return storage;
+}
+
+void aws_date_time_compute_local_time(struct aws_date_time *dt) {
+    if (!dt->local_time_set) {
+        aws_localtime(dt->timestamp, &dt->local_time);
+        dt->local_time_set = true;
+    }
+}
+
+static void s_init_from_sys_ticks(struct aws_date_time *dt, uint64_t sys_ticks) {
+    aws_date_time_init_epoch_nanos(dt, sys_ticks);
 }
 
 void aws_date_time_init_now(struct aws_date_time *dt) {
     uint64_t current_time = 0;
     aws_sys_clock_get_ticks(&current_time);
-    dt->timestamp = (time_t)aws_timestamp_convert(current_time, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_SECS, NULL);
-    dt->gmt_time = s_get_time_struct(dt, false);
-    dt->local_time = s_get_time_struct(dt, true);
+    s_init_from_sys_ticks(dt, current_time);
+}
+
+void aws_date_time_init_now_cached(struct aws_date_time *dt) {
+    uint64_t current_time = 0;
+    aws_sys_clock_get_ticks_cached(&current_time);
+    s_init_from_sys_ticks(dt, current_time);
+}
+
+void aws_date_time_init_epoch_nanos(struct aws_date_time *dt, uint64_t ns_since_epoch) {
+    s_set_timestamp(
+        dt, (time_t)(ns_since_epoch / AWS_TIMESTAMP_NANOS), (uint32_t)(ns_since_epoch % AWS_TIMESTAMP_NANOS));
 }
 
 void aws_date_time_init_epoch_millis(struct aws_date_time *dt, uint64_t ms_since_epoch) {
-    dt->timestamp = (time_t)(ms_since_epoch / AWS_TIMESTAMP_MILLIS);
-    dt->gmt_time = s_get_time_struct(dt, false);
-    dt->local_time = s_get_time_struct(dt, true);
+    s_set_timestamp(
+        dt,
+        (time_t)(ms_since_epoch / AWS_TIMESTAMP_MILLIS),
+        (uint32_t)(ms_since_epoch % AWS_TIMESTAMP_MILLIS) * (AWS_TIMESTAMP_NANOS / AWS_TIMESTAMP_MILLIS));
 }
 
 void aws_date_time_init_epoch_secs(struct aws_date_time *dt, double sec_ms) {
-    dt->timestamp = (time_t)sec_ms;
-    dt->gmt_time = s_get_time_struct(dt, false);
-    dt->local_time = s_get_time_struct(dt, true);
+    /* rounded down rather than toward zero, so that the fraction is never negative */
+    time_t seconds = (time_t)sec_ms;
+    if ((double)seconds > sec_ms) {
+        --seconds;
+    }
+    uint64_t nanoseconds = (uint64_t)((sec_ms - (double)seconds) * (double)AWS_TIMESTAMP_NANOS + 0.5);
+    if (nanoseconds >= AWS_TIMESTAMP_NANOS) {
+        ++seconds;
+        nanoseconds = 0;
+    }
+    s_set_timestamp(dt, seconds, (uint32_t)nanoseconds);
+}
+
+/*
+ * Reads the digits of a fractional second, of which only the first nine are significant. Returns false if any of the
+ * count characters isn't a digit.
+ */
+static bool s_parse_fraction(const uint8_t *digits, size_t count, uint32_t *nanoseconds) {
+    uint32_t value = 0;
+    uint32_t scale = AWS_TIMESTAMP_NANOS;
+    for (size_t i = 0; i < count; ++i) {
+        if (!isdigit(digits[i])) {
+            return false;
+        }
+        if (scale > 1) {
+            scale /= 10;
+            value += (uint32_t)(digits[i] - '0') * scale;
+        }
+    }
+
+    *nanoseconds = value;
+    return true;
 }
 
 enum parser_state {
@@ -211,7 +333,7 @@ enum parser_state {
     FINISHED,
 };
 
-static int s_parse_iso_8601(const struct aws_byte_buf *date_str, struct tm *parsed_time) {
+static int s_parse_iso_8601(const struct aws_byte_buf *date_str, struct tm *parsed_time, uint32_t *nanoseconds) {
     size_t index = 0;
     size_t state_start_index = 0;
     enum parser_state state = ON_YEAR;
@@ -307,6 +429,7 @@ static int s_parse_iso_8601(const struct aws_byte_buf *date_str, struct tm *pars
                 break;
             case ON_TZ:
                 if (c == 'Z') {
+                    s_parse_fraction(date_str->buffer + state_start_index, index - state_start_index, nanoseconds);
                     state = FINISHED;
                     state_start_index = index + 1;
                 } else if (!isdigit(c)) {
@@ -329,6 +452,51 @@ static int s_parse_iso_8601(const struct aws_byte_buf *date_str, struct tm *pars
     return (state == FINISHED || state == ON_MONTH_DAY) && !error ? AWS_OP_SUCCESS : AWS_OP_ERR;
 }
 
+/*
+ * ISO 8601 basic format has a fixed layout: YYYYMMDD, optionally followed by THHMMSSZ, where the seconds may have a
+ * fraction (THHMMSS.sssZ).
+ */
+static int s_parse_iso_8601_basic(const struct aws_byte_buf *date_str, struct tm *parsed_time, uint32_t *nanoseconds) {
+    static const char s_layout[] = "DDDDDDDDTDDDDDDZ";
+    const size_t fraction_start = sizeof(s_layout) - 2;
+    size_t len = date_str->len;
+    if (len > sizeof(s_layout) && date_str->buffer[fraction_start] == '.' && date_str->buffer[len - 1] == 'Z') {
+        if (!s_parse_fraction(date_str->buffer + fraction_start + 1, len - fraction_start - 2, nanoseconds)) {
+            return AWS_OP_ERR;
+        }
+        /* the fraction is done, so check the rest as if it were the seconds */
+        len = fraction_start;
+    } else if (len != 8 && len != sizeof(s_layout) - 1) {
+        return AWS_OP_ERR;
+    }
+
+    int values[7] = {0};
+    /* digit pairs: century, year, month, day, hour, minute, second */
+    for (size_t i = 0, pair = 0; i < len; ++i) {
+        char c = (char)date_str->buffer[i];
+        if (s_layout[i] != 'D') {
+            if (c != s_layout[i]) {
+                return AWS_OP_ERR;
+            }
+            continue;
+        }
+        if (!isdigit((unsigned char)c)) {
+            return AWS_OP_ERR;
+        }
+        values[pair / 2] = values[pair / 2] * 10 + (c - '0');
+        ++pair;
+    }
+
+    parsed_time->tm_year = values[0] * 100 + values[1] - 1900;
+    parsed_time->tm_mon = values[2] - 1;
+    parsed_time->tm_mday = values[3];
+    parsed_time->tm_hour = values[4];
+    parsed_time->tm_min = values[5];
+    parsed_time->tm_sec = values[6];
+
+    return AWS_OP_SUCCESS;
+}
+
 static int s_parse_rfc_822(const struct aws_byte_buf *date_str, struct tm *parsed_time, struct aws_date_time *dt) {
     size_t len = date_str->len;
 
@@ -459,6 +627,203 @@ static int s_parse_rfc_822(const struct aws_byte_buf *date_str, struct tm *parse
     return error || state != ON_TZ ? AWS_OP_ERR : AWS_OP_SUCCESS;
 }
 
+/*
+ * A date layout with fixed positions. In layout, 'D' is a digit and 'A' a letter; anything else must match exactly.
+ * Offsets point at the first character of each field; named_month means the month is a three letter name.
+ */
+struct fixed_date_layout {
+    const char *layout;
+    size_t len;
+    bool named_month;
+    uint8_t year;
+    uint8_t month;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+};
+
+enum fixed_date_layout_id {
+    FIXED_LAYOUT_RFC822,
+    FIXED_LAYOUT_ISO_8601,
+    FIXED_LAYOUT_ISO_8601_BASIC,
+    /* the parts before the fraction of 2002-10-02T08:05:09.123Z and 20021002T080509.123Z */
+    FIXED_LAYOUT_ISO_8601_SECONDS,
+    FIXED_LAYOUT_ISO_8601_BASIC_SECONDS,
+    FIXED_LAYOUT_COUNT,
+};
+
+static const struct fixed_date_layout s_fixed_layouts[FIXED_LAYOUT_COUNT] = {
+    [FIXED_LAYOUT_RFC822] = {"AAA, DD AAA DDDD DD:DD:DD GMT", 29, true, 12, 8, 5, 17, 20, 23},
+    [FIXED_LAYOUT_ISO_8601] = {"DDDD-DD-DDTDD:DD:DDZ", 20, false, 0, 5, 8, 11, 14, 17},
+    [FIXED_LAYOUT_ISO_8601_BASIC] = {"DDDDDDDDTDDDDDDZ", 16, false, 0, 4, 6, 9, 11, 13},
+    [FIXED_LAYOUT_ISO_8601_SECONDS] = {"DDDD-DD-DDTDD:DD:DD", 19, false, 0, 5, 8, 11, 14, 17},
+    [FIXED_LAYOUT_ISO_8601_BASIC_SECONDS] = {"DDDDDDDDTDDDDDD", 15, false, 0, 4, 6, 9, 11, 13},
+};
+
+#define FIXED_LAYOUT_WORDS 4
+
+/*
+ * Each layout as masks over 8 byte words, so that a string is checked a word at a time rather than a character at a
+ * time. Letters are in neither mask: names are checked against the name tables.
+ */
+struct fixed_date_layout_masks {
+    uint64_t digits[FIXED_LAYOUT_WORDS];
+    uint64_t literals[FIXED_LAYOUT_WORDS];
+    uint64_t expected[FIXED_LAYOUT_WORDS];
+};
+
+static struct fixed_date_layout_masks s_fixed_layout_masks[FIXED_LAYOUT_COUNT];
+static aws_thread_once s_fixed_layout_masks_once = AWS_THREAD_ONCE_STATIC_INIT;
+
+/* Built from the layout strings at runtime so that the masks come out in the host's byte order. */
+static void s_init_fixed_layout_masks(void) {
+    for (size_t id = 0; id < FIXED_LAYOUT_COUNT; ++id) {
+        const struct fixed_date_layout *layout = &s_fixed_layouts[id];
+        uint8_t digits[FIXED_LAYOUT_WORDS * 8] = {0};
+        uint8_t literals[FIXED_LAYOUT_WORDS * 8] = {0};
+        uint8_t expected[FIXED_LAYOUT_WORDS * 8] = {0};
+        for (size_t i = 0; i < layout->len; ++i) {
+            if (layout->layout[i] == 'D') {
+                digits[i] = 0xFF;
+            } else if (layout->layout[i] != 'A') {
+                literals[i] = 0xFF;
+                expected[i] = (uint8_t)layout->layout[i];
+            }
+        }
+
+        struct fixed_date_layout_masks *masks = &s_fixed_layout_masks[id];
+        memcpy(masks->digits, digits, sizeof(digits));
+        memcpy(masks->literals, literals, sizeof(literals));
+        memcpy(masks->expected, expected, sizeof(expected));
+    }
+}
+
+/*
+ * Checks str against a layout 8 bytes at a time. A byte is a digit if its high nibble is 3 and adding 6 leaves it so;
+ * the addition can't carry into the next byte once the high nibble check has passed.
+ */
+static bool s_matches_layout(const uint8_t *str, size_t len, enum fixed_date_layout_id id) {
+    uint64_t words[FIXED_LAYOUT_WORDS] = {0};
+    memcpy(words, str, len);
+
+    const struct fixed_date_layout_masks *masks = &s_fixed_layout_masks[id];
+    const uint64_t high_nibbles = 0xF0F0F0F0F0F0F0F0ULL;
+    const uint64_t threes = 0x3030303030303030ULL;
+    const uint64_t sixes = 0x0606060606060606ULL;
+    uint64_t mismatch = 0;
+    for (size_t i = 0; i < FIXED_LAYOUT_WORDS; ++i) {
+        uint64_t digit_mask = masks->digits[i];
+        uint64_t digits = words[i] & digit_mask;
+        mismatch |= (words[i] & masks->literals[i]) ^ masks->expected[i];
+        mismatch |= (digits & high_nibbles & digit_mask) ^ (threes & digit_mask);
+        mismatch |= ((digits + (sixes & digit_mask)) & high_nibbles & digit_mask) ^ (threes & digit_mask);
+    }
+    return mismatch == 0;
+}
+
+static int s_2_digits(const uint8_t *str) {
+    return (str[0] - '0') * 10 + (str[1] - '0');
+}
+
+static int s_month_from_name(const uint8_t *name) {
+    for (int month = 0; month < 12; ++month) {
+        if (memcmp(name, s_month_names[month], 3) == 0) {
+            return month + 1;
+        }
+    }
+    return 0;
+}
+
+static bool s_is_weekday_name(const uint8_t *name) {
+    for (size_t day = 0; day < AWS_ARRAY_SIZE(s_weekday_names); ++day) {
+        if (memcmp(name, s_weekday_names[day], 3) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Parses the exact layouts that we and most servers emit, without the state machines or timegm. Returns false for
+ * anything else, including out of range fields, and leaves those to the general parsers, which normalize them.
+ */
+static bool s_parse_fixed_layout(
+    const struct aws_byte_buf *date_str,
+    enum aws_date_format fmt,
+    struct aws_date_time *dt) {
+
+    const uint8_t *str = date_str->buffer;
+    size_t len = date_str->len;
+    uint32_t nanoseconds = 0;
+    enum fixed_date_layout_id id = FIXED_LAYOUT_COUNT;
+    bool auto_detect = fmt == AWS_DATE_FORMAT_AUTO_DETECT;
+    size_t seconds_len = s_fixed_layouts[FIXED_LAYOUT_ISO_8601_SECONDS].len;
+    size_t basic_seconds_len = s_fixed_layouts[FIXED_LAYOUT_ISO_8601_BASIC_SECONDS].len;
+    if ((fmt == AWS_DATE_FORMAT_ISO_8601 || auto_detect) && len > seconds_len + 2 && str[seconds_len] == '.' &&
+        str[len - 1] == 'Z') {
+        if (!s_parse_fraction(str + seconds_len + 1, len - seconds_len - 2, &nanoseconds)) {
+            return false;
+        }
+        id = FIXED_LAYOUT_ISO_8601_SECONDS;
+    } else if (
+        (fmt == AWS_DATE_FORMAT_ISO_8601_BASIC || auto_detect) && len > basic_seconds_len + 2 &&
+        str[basic_seconds_len] == '.' && str[len - 1] == 'Z') {
+        if (!s_parse_fraction(str + basic_seconds_len + 1, len - basic_seconds_len - 2, &nanoseconds)) {
+            return false;
+        }
+        id = FIXED_LAYOUT_ISO_8601_BASIC_SECONDS;
+    } else if ((fmt == AWS_DATE_FORMAT_RFC822 || auto_detect) && len == s_fixed_layouts[FIXED_LAYOUT_RFC822].len) {
+        id = FIXED_LAYOUT_RFC822;
+    } else if (
+        (fmt == AWS_DATE_FORMAT_ISO_8601 || auto_detect) && len == s_fixed_layouts[FIXED_LAYOUT_ISO_8601].len) {
+        id = FIXED_LAYOUT_ISO_8601;
+    } else if (
+        (fmt == AWS_DATE_FORMAT_ISO_8601_BASIC || auto_detect) &&
+        len == s_fixed_layouts[FIXED_LAYOUT_ISO_8601_BASIC].len) {
+        id = FIXED_LAYOUT_ISO_8601_BASIC;
+    } else {
+        return false;
+    }
+
+    aws_thread_call_once(&s_fixed_layout_masks_once, s_init_fixed_layout_masks);
+
+    const struct fixed_date_layout *layout = &s_fixed_layouts[id];
+    if (!s_matches_layout(str, layout->len, id)) {
+        return false;
+    }
+
+    int year = s_2_digits(str + layout->year) * 100 + s_2_digits(str + layout->year + 2);
+    int month = layout->named_month ? s_month_from_name(str + layout->month) : s_2_digits(str + layout->month);
+    int day = s_2_digits(str + layout->day);
+    int hour = s_2_digits(str + layout->hour);
+    int minute = s_2_digits(str + layout->minute);
+    int second = s_2_digits(str + layout->second);
+
+    if (layout->named_month && !s_is_weekday_name(str)) {
+        return false;
+    }
+
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    int days_in_month = month == 2 ? 28 + leap : 30 + ((month + (month > 7)) & 1);
+    /* a leap second is accepted, and like timegm, rolls over into the next minute */
+    if (month < 1 || month > 12 || day < 1 || day > days_in_month || hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+
+    int64_t timestamp = s_days_from_civil(year, month, day) * SECS_PER_DAY + hour * 3600 + minute * 60 + second;
+    if ((int64_t)(time_t)timestamp != timestamp) {
+        return false;
+    }
+
+    if (layout->named_month) {
+        memcpy(dt->tz, "GMT", 4);
+    }
+    dt->utc_assumed = true;
+    s_set_timestamp(dt, (time_t)timestamp, nanoseconds);
+    return true;
+}
+
 int aws_date_time_init_from_str(
     struct aws_date_time *dt,
     const struct aws_byte_buf *date_str,
@@ -469,19 +834,34 @@ int aws_date_time_init_from_str(
 
     AWS_ZERO_STRUCT(*dt);
 
+    if (s_parse_fixed_layout(date_str, fmt, dt)) {
+        return AWS_OP_SUCCESS;
+    }
+
     struct tm parsed_time;
     AWS_ZERO_STRUCT(parsed_time);
     bool successfully_parsed = false;
 
     time_t seconds_offset = 0;
+    uint32_t nanoseconds = 0;
     if (fmt == AWS_DATE_FORMAT_ISO_8601 || fmt == AWS_DATE_FORMAT_AUTO_DETECT) {
-        if (!s_parse_iso_8601(date_str, &parsed_time)) {
+        if (!s_parse_iso_8601(date_str, &parsed_time, &nanoseconds)) {
+            dt->utc_assumed = true;
+            successfully_parsed = true;
+        }
+    }
+
+    if (fmt == AWS_DATE_FORMAT_ISO_8601_BASIC || (fmt == AWS_DATE_FORMAT_AUTO_DETECT && !successfully_parsed)) {
+        AWS_ZERO_STRUCT(parsed_time);
+        nanoseconds = 0;
+        if (!s_parse_iso_8601_basic(date_str, &parsed_time, &nanoseconds)) {
             dt->utc_assumed = true;
             successfully_parsed = true;
         }
     }
 
     if (fmt == AWS_DATE_FORMAT_RFC822 || (fmt == AWS_DATE_FORMAT_AUTO_DETECT && !successfully_parsed)) {
+        nanoseconds = 0;
         if (!s_parse_rfc_822(date_str, &parsed_time, dt)) {
             successfully_parsed = true;
 
@@ -512,18 +892,16 @@ int aws_date_time_init_from_str(
         return aws_raise_error(AWS_ERROR_INVALID_DATE_STR);
     }
 
+    time_t timestamp = 0;
     if (dt->utc_assumed || seconds_offset) {
-        dt->timestamp = aws_timegm(&parsed_time);
+        timestamp = aws_timegm(&parsed_time);
     } else {
-        dt->timestamp = mktime(&parsed_time);
+        timestamp = mktime(&parsed_time);
     }
 
     /* negative means we need to move west (increase the timestamp), positive means head east, so decrease the
      * timestamp. */
-    dt->timestamp -= seconds_offset;
-
-    dt->gmt_time = s_get_time_struct(dt, false);
-    dt->local_time = s_get_time_struct(dt, true);
+    s_set_timestamp(dt, timestamp - seconds_offset, nanoseconds);
 
     return AWS_OP_SUCCESS;
 }
@@ -542,26 +920,120 @@ static inline int s_date_to_str(const struct tm *tm, const char *format_str, str
     return AWS_OP_SUCCESS;
 }
 
-int aws_date_time_to_local_time_str(
-    const struct aws_date_time *dt,
-    enum aws_date_format fmt,
-    struct aws_byte_buf *output_buf) {
-    assert(fmt != AWS_DATE_FORMAT_AUTO_DETECT);
+static const char *s_format_str(enum aws_date_format fmt, bool short_form, bool local_time) {
+    switch (fmt) {
+        case AWS_DATE_FORMAT_RFC822:
+            if (short_form) {
+                return RFC822_SHORT_DATE_FORMAT_STR;
+            }
+            return local_time ? RFC822_DATE_FORMAT_STR_WITH_Z : RFC822_DATE_FORMAT_STR_MINUS_Z;
+        case AWS_DATE_FORMAT_ISO_8601_BASIC:
+            return short_form ? ISO_8601_BASIC_SHORT_DATE_FORMAT_STR : ISO_8601_BASIC_LONG_DATE_FORMAT_STR;
+        default:
+            return short_form ? ISO_8601_SHORT_DATE_FORMAT_STR : ISO_8601_LONG_DATE_FORMAT_STR;
+    }
+}
 
-    if (AWS_UNLIKELY(fmt == AWS_DATE_FORMAT_AUTO_DETECT)) {
-        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+static uint8_t *s_write_2_digits(uint8_t *out, int value) {
+    out[0] = (uint8_t)('0' + value / 10);
+    out[1] = (uint8_t)('0' + value % 10);
+    return out + 2;
+}
+
+static uint8_t *s_write_chars(uint8_t *out, const char *chars, size_t len) {
+    memcpy(out, chars, len);
+    return out + len;
+}
+
+/* Writes '.' and the first digits of nanoseconds, truncating the rest. */
+static uint8_t *s_write_fraction(uint8_t *out, uint32_t nanoseconds, uint8_t digits) {
+    *out++ = '.';
+    uint32_t scale = AWS_TIMESTAMP_NANOS;
+    for (uint8_t i = 0; i < digits; ++i) {
+        scale /= 10;
+        *out++ = (uint8_t)('0' + nanoseconds / scale % 10);
     }
+    return out;
+}
 
+/*
+ * Writes a GMT date without strftime, which would look up the locale and parse the format on every call. Returns the
+ * number of bytes written to out, which must have room for AWS_DATE_TIME_STR_MAX_LEN bytes, or 0 if the date is
+ * outside what the fixed layouts can express (years before 0 or after 9999) and strftime has to handle it.
+ * fraction_digits digits of nanoseconds are written after the seconds; it is 0 for RFC 822 and short forms.
+ */
+static size_t s_format_utc(
+    const struct tm *time,
+    uint32_t nanoseconds,
+    enum aws_date_format fmt,
+    bool short_form,
+    uint8_t fraction_digits,
+    uint8_t *out) {
+    int year = time->tm_year + 1900;
+    if (year < 0 || year > 9999 || time->tm_mon < 0 || time->tm_mon > 11 || time->tm_wday < 0 || time->tm_wday > 6) {
+        return 0;
+    }
+
+    uint8_t *cursor = out;
     if (fmt == AWS_DATE_FORMAT_RFC822) {
-        return s_date_to_str(&dt->local_time, RFC822_DATE_FORMAT_STR_WITH_Z, output_buf);
+        /* Thu, 01 Jan 1970 00:00:00 GMT */
+        cursor = s_write_chars(cursor, s_weekday_names[time->tm_wday], 3);
+        cursor = s_write_chars(cursor, ", ", 2);
+        cursor = s_write_2_digits(cursor, time->tm_mday);
+        *cursor++ = ' ';
+        cursor = s_write_chars(cursor, s_month_names[time->tm_mon], 3);
+        *cursor++ = ' ';
+        cursor = s_write_2_digits(cursor, year / 100);
+        cursor = s_write_2_digits(cursor, year % 100);
+        if (!short_form) {
+            *cursor++ = ' ';
+            cursor = s_write_2_digits(cursor, time->tm_hour);
+            *cursor++ = ':';
+            cursor = s_write_2_digits(cursor, time->tm_min);
+            *cursor++ = ':';
+            cursor = s_write_2_digits(cursor, time->tm_sec);
+            cursor = s_write_chars(cursor, " GMT", 4);
+        }
+    } else {
+        /* 1970-01-01T00:00:00Z, or 19700101T000000Z in the basic format */
+        bool extended = fmt != AWS_DATE_FORMAT_ISO_8601_BASIC;
+        cursor = s_write_2_digits(cursor, year / 100);
+        cursor = s_write_2_digits(cursor, year % 100);
+        if (extended) {
+            *cursor++ = '-';
+        }
+        cursor = s_write_2_digits(cursor, time->tm_mon + 1);
+        if (extended) {
+            *cursor++ = '-';
+        }
+        cursor = s_write_2_digits(cursor, time->tm_mday);
+        if (!short_form) {
+            *cursor++ = 'T';
+            cursor = s_write_2_digits(cursor, time->tm_hour);
+            if (extended) {
+                *cursor++ = ':';
+            }
+            cursor = s_write_2_digits(cursor, time->tm_min);
+            if (extended) {
+                *cursor++ = ':';
+            }
+            cursor = s_write_2_digits(cursor, time->tm_sec);
+            if (fraction_digits) {
+                cursor = s_write_fraction(cursor, nanoseconds, fraction_digits);
+            }
+            *cursor++ = 'Z';
+        }
     }
 
-    return s_date_to_str(&dt->local_time, ISO_8601_LONG_DATE_FORMAT_STR, output_buf);
+    return (size_t)(cursor - out);
 }
 
-int aws_date_time_to_utc_time_str(
+static int s_to_str(
     const struct aws_date_time *dt,
     enum aws_date_format fmt,
+    bool short_form,
+    bool local_time,
+    uint8_t fraction_digits,
     struct aws_byte_buf *output_buf) {
     assert(fmt != AWS_DATE_FORMAT_AUTO_DETECT);
 
@@ -569,103 +1041,176 @@ int aws_date_time_to_utc_time_str(
         return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
     }
 
-    if (fmt == AWS_DATE_FORMAT_RFC822) {
-        return s_date_to_str(&dt->gmt_time, RFC822_DATE_FORMAT_STR_MINUS_Z, output_buf);
+    if (!local_time) {
+        if (output_buf->capacity < AWS_DATE_TIME_STR_MAX_LEN) {
+            return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+        }
+
+        size_t len =
+            s_format_utc(&dt->gmt_time, dt->nanoseconds, fmt, short_form, fraction_digits, output_buf->buffer);
+        if (len) {
+            output_buf->len = len;
+            return AWS_OP_SUCCESS;
+        }
     }
 
-    return s_date_to_str(&dt->gmt_time, ISO_8601_LONG_DATE_FORMAT_STR, output_buf);
+    struct tm storage;
+    const struct tm *time = s_get_time_struct(dt, local_time, &storage);
+    if (s_date_to_str(time, s_format_str(fmt, short_form, local_time), output_buf)) {
+        return AWS_OP_ERR;
+    }
+
+    if (fraction_digits) {
+        /* the ISO 8601 layouts end in the seconds and a Z; the fraction goes in between */
+        uint8_t *cursor = s_write_fraction(output_buf->buffer + output_buf->len - 1, dt->nanoseconds, fraction_digits);
+        *cursor++ = 'Z';
+        output_buf->len = (size_t)(cursor - output_buf->buffer);
+    }
+
+    return AWS_OP_SUCCESS;
 }
 
-int aws_date_time_to_local_time_short_str(
+int aws_date_time_to_local_time_str(
     const struct aws_date_time *dt,
     enum aws_date_format fmt,
     struct aws_byte_buf *output_buf) {
-    assert(fmt != AWS_DATE_FORMAT_AUTO_DETECT);
+    return s_to_str(dt, fmt, false, true, 0, output_buf);
+}
 
-    if (AWS_UNLIKELY(fmt == AWS_DATE_FORMAT_AUTO_DETECT)) {
+int aws_date_time_to_utc_time_str(
+    const struct aws_date_time *dt,
+    enum aws_date_format fmt,
+    struct aws_byte_buf *output_buf) {
+    return s_to_str(dt, fmt, false, false, 0, output_buf);
+}
+
+int aws_date_time_to_utc_time_str_with_fraction(
+    const struct aws_date_time *dt,
+    enum aws_date_format fmt,
+    uint8_t fraction_digits,
+    struct aws_byte_buf *output_buf) {
+    if (fmt == AWS_DATE_FORMAT_RFC822 || fraction_digits < 1 || fraction_digits > 9) {
         return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
     }
 
-    if (fmt == AWS_DATE_FORMAT_RFC822) {
-        return s_date_to_str(&dt->local_time, RFC822_SHORT_DATE_FORMAT_STR, output_buf);
-    }
+    return s_to_str(dt, fmt, false, false, fraction_digits, output_buf);
+}
 
-    return s_date_to_str(&dt->local_time, ISO_8601_SHORT_DATE_FORMAT_STR, output_buf);
+int aws_date_time_to_local_time_short_str(
+    const struct aws_date_time *dt,
+    enum aws_date_format fmt,
+    struct aws_byte_buf *output_buf) {
+    return s_to_str(dt, fmt, true, true, 0, output_buf);
 }
 
 int aws_date_time_to_utc_time_short_str(
     const struct aws_date_time *dt,
     enum aws_date_format fmt,
     struct aws_byte_buf *output_buf) {
+    return s_to_str(dt, fmt, true, false, 0, output_buf);
+}
+
+void aws_date_time_str_cache_init(struct aws_date_time_str_cache *cache, enum aws_date_format fmt, bool short_form) {
     assert(fmt != AWS_DATE_FORMAT_AUTO_DETECT);
 
-    if (AWS_UNLIKELY(fmt == AWS_DATE_FORMAT_AUTO_DETECT)) {
-        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
-    }
+    AWS_ZERO_STRUCT(*cache);
+    cache->fmt = fmt;
+    cache->short_form = short_form;
+}
 
-    if (fmt == AWS_DATE_FORMAT_RFC822) {
-        return s_date_to_str(&dt->gmt_time, RFC822_SHORT_DATE_FORMAT_STR, output_buf);
+int aws_date_time_str_cache_get_utc(
+    struct aws_date_time_str_cache *cache,
+    const struct aws_date_time *dt,
+    struct aws_byte_cursor *output) {
+
+    if (!cache->len || cache->timestamp != dt->timestamp) {
+        struct aws_byte_buf buf = aws_byte_buf_from_empty_array(cache->str, sizeof(cache->str));
+        if (s_to_str(dt, cache->fmt, cache->short_form, false, 0, &buf)) {
+            cache->len = 0;
+            return AWS_OP_ERR;
+        }
+        cache->timestamp = dt->timestamp;
+        cache->len = buf.len;
     }
 
-    return s_date_to_str(&dt->gmt_time, ISO_8601_SHORT_DATE_FORMAT_STR, output_buf);
+    *output = aws_byte_cursor_from_array(cache->str, cache->len);
+    return AWS_OP_SUCCESS;
 }
 
 double aws_date_time_as_epoch_secs(const struct aws_date_time *dt) {
-    return (double)dt->timestamp;
+    return (double)dt->timestamp + (double)dt->nanoseconds / AWS_TIMESTAMP_NANOS;
 }
 
 uint64_t aws_date_time_as_nanos(const struct aws_date_time *dt) {
-    return (uint64_t)dt->timestamp * AWS_TIMESTAMP_NANOS;
+    return (uint64_t)dt->timestamp * AWS_TIMESTAMP_NANOS + dt->nanoseconds;
+}
+
+uint64_t aws_date_time_as_micros(const struct aws_date_time *dt) {
+    return (uint64_t)dt->timestamp * AWS_TIMESTAMP_MICROS +
+           dt->nanoseconds / (AWS_TIMESTAMP_NANOS / AWS_TIMESTAMP_MICROS);
 }
 
 uint64_t aws_date_time_as_millis(const struct aws_date_time *dt) {
-    return (uint64_t)dt->timestamp * AWS_TIMESTAMP_MILLIS;
+    return (uint64_t)dt->timestamp * AWS_TIMESTAMP_MILLIS +
+           dt->nanoseconds / (AWS_TIMESTAMP_NANOS / AWS_TIMESTAMP_MILLIS);
 }
 
 uint16_t aws_date_time_year(const struct aws_date_time *dt, bool local_time) {
-    const struct tm *time = local_time ? &dt->local_time : &dt->gmt_time;
+    struct tm storage;
+    const struct tm *time = s_get_time_struct(dt, local_time, &storage);
 
     return (uint16_t)(time->tm_year + 1900);
 }
 
 enum aws_date_month aws_date_time_month(const struct aws_date_time *dt, bool local_time) {
-    const struct tm *time = local_time ? &dt->local_time : &dt->gmt_time;
+    struct tm storage;
+    const struct tm *time = s_get_time_struct(dt, local_time, &storage);
 
     return time->tm_mon;
 }
 
 uint8_t aws_date_time_month_day(const struct aws_date_time *dt, bool local_time) {
-    const struct tm *time = local_time ? &dt->local_time : &dt->gmt_time;
+    struct tm storage;
+    const struct tm *time = s_get_time_struct(dt, local_time, &storage);
 
     return (uint8_t)time->tm_mday;
 }
 
 enum aws_date_day_of_week aws_date_time_day_of_week(const struct aws_date_time *dt, bool local_time) {
-    const struct tm *time = local_time ? &dt->local_time : &dt->gmt_time;
+    struct tm storage;
+    const struct tm *time = s_get_time_struct(dt, local_time, &storage);
 
     return time->tm_wday;
 }
 
 uint8_t aws_date_time_hour(const struct aws_date_time *dt, bool local_time) {
-    const struct tm *time = local_time ? &dt->local_time : &dt->gmt_time;
+    struct tm storage;
+    const struct tm *time = s_get_time_struct(dt, local_time, &storage);
 
     return (uint8_t)time->tm_hour;
 }
 
 uint8_t aws_date_time_minute(const struct aws_date_time *dt, bool local_time) {
-    const struct tm *time = local_time ? &dt->local_time : &dt->gmt_time;
+    struct tm storage;
+    const struct tm *time = s_get_time_struct(dt, local_time, &storage);
 
     return (uint8_t)time->tm_min;
 }
 
 uint8_t aws_date_time_second(const struct aws_date_time *dt, bool local_time) {
-    const struct tm *time = local_time ? &dt->local_time : &dt->gmt_time;
+    struct tm storage;
+    const struct tm *time = s_get_time_struct(dt, local_time, &storage);
 
     return (uint8_t)time->tm_sec;
 }
 
+uint32_t aws_date_time_nanosecond(const struct aws_date_time *dt) {
+    return dt->nanoseconds;
+}
+
 bool aws_date_time_dst(const struct aws_date_time *dt, bool local_time) {
-    const struct tm *time = local_time ? &dt->local_time : &dt->gmt_time;
+    struct tm storage;
+    const struct tm *time = s_get_time_struct(dt, local_time, &storage);
 
     return (bool)time->tm_isdst;
 }
@@ -673,3 +1218,8 @@ bool aws_date_time_dst(const struct aws_date_time *dt, bool local_time) {
 time_t aws_date_time_diff(const struct aws_date_time *a, const struct aws_date_time *b) {
     return a->timestamp - b->timestamp;
 }
+
+int64_t aws_date_time_diff_nanos(const struct aws_date_time *a, const struct aws_date_time *b) {
+    return ((int64_t)a->timestamp - (int64_t)b->timestamp) * (int64_t)AWS_TIMESTAMP_NANOS +
+           ((int64_t)a->nanoseconds - (int64_t)b->nanoseconds);
+}
@@ -14,8 +14,11 @@
  */
 #include <aws/common/device_random.h>
 
+#include <aws/common/atomics.h>
 #include <aws/common/byte_buf.h>
 
+#include <aws/common/private/device_random.h>
+
 #ifdef _MSC_VER
 /* disables warning non const declared initializers for Microsoft compilers */
 #    pragma warning(disable : 4204)
@@ -45,3 +48,108 @@ int aws_device_random_u8(uint8_t *output) {
 
     return aws_device_random_buffer(&buf);
 }
+
+/* Requests larger than this go straight to the operating system, even in buffered mode. */
+#define BUFFERED_MAX_REQUEST 256
+
+static struct aws_atomic_var s_buffered = AWS_ATOMIC_INIT_INT(0);
+
+/*
+ * Allocated on a thread's first buffered request, so threads that never use buffered mode pay nothing for it.
+ * tl_available bytes at the end of tl_buffer have not been handed out yet.
+ */
+static AWS_THREAD_LOCAL uint8_t *tl_buffer = NULL;
+static AWS_THREAD_LOCAL size_t tl_available = 0;
+static AWS_THREAD_LOCAL size_t tl_fork_generation = 0;
+
+void aws_device_random_private_release_thread_buffer(void *buffer) {
+    aws_secure_zero(buffer, AWS_DEVICE_RANDOM_BUFFER_SIZE);
+    aws_mem_release(aws_default_allocator(), buffer);
+
+    if (tl_buffer == buffer) {
+        tl_buffer = NULL;
+        tl_available = 0;
+    }
+}
+
+static void s_release_own_buffer(void) {
+    uint8_t *buffer = tl_buffer;
+    aws_device_random_private_watch_thread_exit(NULL);
+    aws_device_random_private_release_thread_buffer(buffer);
+}
+
+/* Returns false if the calling thread can't have a buffer, in which case requests go straight to the OS. */
+static bool s_ensure_buffer(void) {
+    if (AWS_LIKELY(tl_buffer != NULL)) {
+        return true;
+    }
+
+    uint8_t *buffer = aws_mem_acquire(aws_default_allocator(), AWS_DEVICE_RANDOM_BUFFER_SIZE);
+    if (!buffer) {
+        return false;
+    }
+    if (!aws_device_random_private_watch_thread_exit(buffer)) {
+        aws_mem_release(aws_default_allocator(), buffer);
+        return false;
+    }
+
+    tl_buffer = buffer;
+    tl_available = 0;
+    return true;
+}
+
+static int s_take_buffered(uint8_t *dest, size_t len) {
+    size_t fork_generation = aws_device_random_private_fork_generation();
+    if (AWS_UNLIKELY(tl_fork_generation != fork_generation)) {
+        /* this is a forked child holding a copy of its parent's buffer */
+        tl_available = 0;
+        tl_fork_generation = fork_generation;
+    }
+
+    if (tl_available < len) {
+        if (aws_device_random_private_fill(tl_buffer, AWS_DEVICE_RANDOM_BUFFER_SIZE)) {
+            tl_available = 0;
+            return AWS_OP_ERR;
+        }
+        tl_available = AWS_DEVICE_RANDOM_BUFFER_SIZE;
+    }
+
+    uint8_t *next = tl_buffer + AWS_DEVICE_RANDOM_BUFFER_SIZE - tl_available;
+    memcpy(dest, next, len);
+    /* bytes already handed out shouldn't stay readable in this thread's memory */
+    aws_secure_zero(next, len);
+    tl_available -= len;
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_device_random_buffer(struct aws_byte_buf *output) {
+    size_t len = output->capacity - output->len;
+    uint8_t *dest = output->buffer + output->len;
+
+    bool buffered = aws_atomic_load_int_explicit(&s_buffered, aws_memory_order_relaxed) != 0;
+    if (AWS_UNLIKELY(!buffered && tl_buffer)) {
+        /* buffered mode was turned off since this thread last used it */
+        s_release_own_buffer();
+    }
+
+    if (buffered && len <= BUFFERED_MAX_REQUEST && s_ensure_buffer()) {
+        if (s_take_buffered(dest, len)) {
+            return AWS_OP_ERR;
+        }
+    } else if (aws_device_random_private_fill(dest, len)) {
+        return AWS_OP_ERR;
+    }
+
+    output->len += len;
+    return AWS_OP_SUCCESS;
+}
+
+void aws_device_random_set_buffered(bool buffered) {
+    aws_atomic_store_int(&s_buffered, buffered);
+
+    /* other threads free theirs on their next request, or when they exit */
+    if (!buffered && tl_buffer) {
+        s_release_own_buffer();
+    }
+}
@@ -15,6 +15,8 @@
 
 #include <aws/common/encoding.h>
 
+#include <aws/common/private/hex.h>
+
 #include <assert.h>
 #include <ctype.h>
 #include <stdlib.h>
@@ -49,6 +51,27 @@ static inline bool aws_common_private_has_avx2(void) {
 
 static const uint8_t *HEX_CHARS = (const uint8_t *)"0123456789abcdef";
 
+/* the value of each hex digit, either case, and 0xFF for everything else. */
+/* clang-format off */
+static const uint8_t HEX_DECODING_TABLE[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0,    1,    2,    3,    4,    5,    6,    7,    8,    9,    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 10,   11,   12,   13,   14,   15,   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 10,   11,   12,   13,   14,   15,   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+/* clang-format on */
+
 static const uint8_t BASE64_SENTIANAL_VALUE = 0xff;
 static const uint8_t BASE64_ENCODING_TABLE[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
@@ -102,36 +125,42 @@ int aws_hex_encode(const struct aws_byte_cursor *AWS_RESTRICT to_encode, struct
         return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
     }
 
-    size_t written = 0;
-    for (size_t i = 0; i < to_encode->len; ++i) {
-
-        output->buffer[written++] = HEX_CHARS[to_encode->ptr[i] >> 4 & 0x0f];
-        output->buffer[written++] = HEX_CHARS[to_encode->ptr[i] & 0x0f];
-    }
+    aws_hex_private_encode_bytes(to_encode->ptr, to_encode->len, output->buffer);
 
-    output->buffer[written] = '\0';
+    output->buffer[encoded_len - 1] = '\0';
     output->len = encoded_len;
 
     return AWS_OP_SUCCESS;
 }
 
-static int s_hex_decode_char_to_int(char character, uint8_t *int_val) {
-    if (character >= 'a' && character <= 'f') {
-        *int_val = (uint8_t)(10 + (character - 'a'));
-        return 0;
+void aws_hex_private_encode_bytes(const uint8_t *in, size_t len, uint8_t *out) {
+    for (size_t i = 0; i < len; ++i) {
+        out[2 * i] = HEX_CHARS[in[i] >> 4 & 0x0f];
+        out[2 * i + 1] = HEX_CHARS[in[i] & 0x0f];
     }
+}
 
-    if (character >= 'A' && character <= 'F') {
-        *int_val = (uint8_t)(10 + (character - 'A'));
-        return 0;
+bool aws_hex_private_decode_bytes(const uint8_t *in, size_t len, uint8_t *out) {
+    /* invalid characters decode to 0xFF, so any of them leaves high bits set here; checked once at the end */
+    uint8_t invalid = 0;
+    for (size_t i = 0; i < len; ++i) {
+        uint8_t high_value = HEX_DECODING_TABLE[in[2 * i]];
+        uint8_t low_value = HEX_DECODING_TABLE[in[2 * i + 1]];
+        invalid |= high_value | low_value;
+        out[i] = (uint8_t)(high_value << 4 | low_value);
     }
 
-    if (character >= '0' && character <= '9') {
-        *int_val = (uint8_t)(character - '0');
-        return 0;
+    return (invalid & 0xF0) == 0;
+}
+
+static int s_hex_decode_char_to_int(char character, uint8_t *int_val) {
+    uint8_t value = HEX_DECODING_TABLE[(uint8_t)character];
+    if (value == 0xFF) {
+        return AWS_OP_ERR;
     }
 
-    return AWS_OP_ERR;
+    *int_val = value;
+    return AWS_OP_SUCCESS;
 }
 
 int aws_hex_compute_decoded_len(size_t to_decode_len, size_t *decoded_len) {
@@ -163,7 +192,6 @@ int aws_hex_decode(const struct aws_byte_cursor *AWS_RESTRICT to_decode, struct
 
     size_t written = 0;
     size_t i = 0;
-    uint8_t high_value = 0;
     uint8_t low_value = 0;
 
     /* if the buffer isn't even, prepend a 0 to the buffer. */
@@ -176,16 +204,9 @@ int aws_hex_decode(const struct aws_byte_cursor *AWS_RESTRICT to_decode, struct
         output->buffer[written++] = low_value;
     }
 
-    for (; i < to_decode->len; i += 2) {
-        if (AWS_UNLIKELY(
-                s_hex_decode_char_to_int(to_decode->ptr[i], &high_value) ||
-                s_hex_decode_char_to_int(to_decode->ptr[i + 1], &low_value))) {
-            return aws_raise_error(AWS_ERROR_INVALID_HEX_STR);
-        }
-
-        uint8_t value = (uint8_t)(high_value << 4);
-        value |= low_value;
-        output->buffer[written++] = value;
+    if (AWS_UNLIKELY(
+            !aws_hex_private_decode_bytes(to_decode->ptr + i, decoded_length - written, output->buffer + written))) {
+        return aws_raise_error(AWS_ERROR_INVALID_HEX_STR);
     }
 
     output->len = decoded_length;
@@ -0,0 +1,267 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/epoch.h>
+
+#include <assert.h>
+
+struct deferred_free {
+    /* global epoch when the free was deferred */
+    size_t epoch;
+    /* used when destroy_fn is NULL */
+    struct aws_allocator *allocator;
+    void (*destroy_fn)(void *);
+    void *ptr;
+};
+
+/* Deferred frees a participant accumulates before it tries to reclaim some. */
+#define S_COLLECT_THRESHOLD 64
+
+/* Memory deferred in epoch can be freed once the global epoch is two past it; see the comment in epoch.h. */
+static bool s_is_reclaimable(size_t epoch, size_t global_epoch) {
+    return global_epoch - epoch >= 2;
+}
+
+static void s_run_deferred(const struct deferred_free *item) {
+    if (item->destroy_fn) {
+        item->destroy_fn(item->ptr);
+    } else {
+        aws_mem_release(item->allocator, item->ptr);
+    }
+}
+
+static void s_free_bucket(struct aws_epoch_participant *participant, struct aws_epoch_bucket *bucket) {
+    size_t length = aws_array_list_length(&bucket->items);
+    for (size_t i = 0; i < length; ++i) {
+        struct deferred_free *item = NULL;
+        aws_array_list_get_at_ptr(&bucket->items, (void **)&item, i);
+        s_run_deferred(item);
+    }
+
+    aws_array_list_clear(&bucket->items);
+    participant->pending_count -= length;
+}
+
+/* Advances the global epoch if every participant inside a critical section has observed the current one. */
+static void s_try_advance(struct aws_epoch_domain *domain) {
+    size_t epoch = aws_atomic_load_int(&domain->global_epoch);
+    size_t current_local = (epoch << 1) | 1;
+    bool all_current = true;
+
+    aws_mutex_lock(&domain->lock);
+    for (struct aws_linked_list_node *node = aws_linked_list_begin(&domain->participants);
+         node != aws_linked_list_end(&domain->participants);
+         node = aws_linked_list_next(node)) {
+        struct aws_epoch_participant *participant = AWS_CONTAINER_OF(node, struct aws_epoch_participant, node);
+        size_t local = aws_atomic_load_int(&participant->local_epoch);
+        if ((local & 1) && local != current_local) {
+            all_current = false;
+            break;
+        }
+    }
+    aws_mutex_unlock(&domain->lock);
+
+    if (all_current) {
+        /* losing the race means someone else advanced it, which is just as good */
+        aws_atomic_compare_exchange_int(&domain->global_epoch, &epoch, epoch + 1);
+    }
+}
+
+int aws_epoch_domain_init(struct aws_epoch_domain *domain, struct aws_allocator *allocator) {
+    AWS_ZERO_STRUCT(*domain);
+
+    if (aws_array_list_init_dynamic(&domain->orphans, allocator, 0, sizeof(struct deferred_free))) {
+        return AWS_OP_ERR;
+    }
+
+    if (aws_mutex_init(&domain->lock)) {
+        aws_array_list_clean_up(&domain->orphans);
+        return AWS_OP_ERR;
+    }
+
+    domain->allocator = allocator;
+    aws_atomic_init_int(&domain->global_epoch, 0);
+    aws_linked_list_init(&domain->participants);
+
+    return AWS_OP_SUCCESS;
+}
+
+void aws_epoch_domain_clean_up(struct aws_epoch_domain *domain) {
+    assert(aws_linked_list_empty(&domain->participants));
+
+    size_t length = aws_array_list_length(&domain->orphans);
+    for (size_t i = 0; i < length; ++i) {
+        struct deferred_free *item = NULL;
+        aws_array_list_get_at_ptr(&domain->orphans, (void **)&item, i);
+        s_run_deferred(item);
+    }
+
+    aws_array_list_clean_up(&domain->orphans);
+    aws_mutex_clean_up(&domain->lock);
+    AWS_ZERO_STRUCT(*domain);
+}
+
+int aws_epoch_participant_register(struct aws_epoch_domain *domain, struct aws_epoch_participant *participant) {
+    AWS_ZERO_STRUCT(*participant);
+
+    for (size_t i = 0; i < AWS_EPOCH_BUCKET_COUNT; ++i) {
+        if (aws_array_list_init_dynamic(
+                &participant->buckets[i].items, domain->allocator, 0, sizeof(struct deferred_free))) {
+            for (size_t j = 0; j < i; ++j) {
+                aws_array_list_clean_up(&participant->buckets[j].items);
+            }
+            return AWS_OP_ERR;
+        }
+    }
+
+    participant->domain = domain;
+    aws_atomic_init_int(&participant->local_epoch, 0);
+
+    aws_mutex_lock(&domain->lock);
+    aws_linked_list_push_back(&domain->participants, &participant->node);
+    aws_mutex_unlock(&domain->lock);
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_epoch_participant_unregister(struct aws_epoch_participant *participant) {
+    assert(participant->nesting == 0);
+
+    aws_epoch_collect(participant);
+
+    struct aws_epoch_domain *domain = participant->domain;
+    aws_mutex_lock(&domain->lock);
+
+    size_t orphan_count = aws_array_list_length(&domain->orphans) + participant->pending_count;
+    if (participant->pending_count && aws_array_list_ensure_capacity(&domain->orphans, orphan_count - 1)) {
+        aws_mutex_unlock(&domain->lock);
+        return AWS_OP_ERR;
+    }
+
+    aws_linked_list_remove(&participant->node);
+    for (size_t i = 0; i < AWS_EPOCH_BUCKET_COUNT; ++i) {
+        struct aws_array_list *items = &participant->buckets[i].items;
+        size_t length = aws_array_list_length(items);
+        for (size_t j = 0; j < length; ++j) {
+            struct deferred_free *item = NULL;
+            aws_array_list_get_at_ptr(items, (void **)&item, j);
+            /* can't fail, capacity was reserved above */
+            aws_array_list_push_back(&domain->orphans, item);
+        }
+        aws_array_list_clean_up(items);
+    }
+
+    aws_mutex_unlock(&domain->lock);
+
+    AWS_ZERO_STRUCT(*participant);
+    return AWS_OP_SUCCESS;
+}
+
+void aws_epoch_enter(struct aws_epoch_participant *participant) {
+    if (participant->nesting++ == 0) {
+        size_t epoch = aws_atomic_load_int_explicit(&participant->domain->global_epoch, aws_memory_order_relaxed);
+        aws_atomic_store_int_explicit(&participant->local_epoch, (epoch << 1) | 1, aws_memory_order_relaxed);
+        /* the announcement must be visible before any load of the protected structure */
+        aws_atomic_thread_fence(aws_memory_order_seq_cst);
+    }
+}
+
+void aws_epoch_exit(struct aws_epoch_participant *participant) {
+    assert(participant->nesting > 0);
+
+    if (--participant->nesting == 0) {
+        size_t local = aws_atomic_load_int_explicit(&participant->local_epoch, aws_memory_order_relaxed);
+        aws_atomic_store_int_explicit(&participant->local_epoch, local & ~(size_t)1, aws_memory_order_release);
+    }
+}
+
+static int s_defer(
+    struct aws_epoch_participant *participant,
+    struct aws_allocator *allocator,
+    void (*destroy_fn)(void *),
+    void *ptr) {
+
+    /* the unlink of ptr must be ordered before reading the epoch it is tagged with */
+    aws_atomic_thread_fence(aws_memory_order_seq_cst);
+    size_t epoch = aws_atomic_load_int(&participant->domain->global_epoch);
+
+    struct aws_epoch_bucket *bucket = &participant->buckets[epoch % AWS_EPOCH_BUCKET_COUNT];
+    if (bucket->epoch != epoch && aws_array_list_length(&bucket->items)) {
+        /* a bucket is reused three epochs later, by which time its contents are reclaimable */
+        s_free_bucket(participant, bucket);
+    }
+    bucket->epoch = epoch;
+
+    struct deferred_free item = {
+        .epoch = epoch,
+        .allocator = allocator,
+        .destroy_fn = destroy_fn,
+        .ptr = ptr,
+    };
+    if (aws_array_list_push_back(&bucket->items, &item)) {
+        return AWS_OP_ERR;
+    }
+
+    if (++participant->pending_count >= S_COLLECT_THRESHOLD) {
+        aws_epoch_collect(participant);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_epoch_defer_free(struct aws_epoch_participant *participant, struct aws_allocator *allocator, void *ptr) {
+    return s_defer(participant, allocator, NULL, ptr);
+}
+
+int aws_epoch_defer_destroy(struct aws_epoch_participant *participant, void (*destroy_fn)(void *), void *ptr) {
+    return s_defer(participant, NULL, destroy_fn, ptr);
+}
+
+void aws_epoch_collect(struct aws_epoch_participant *participant) {
+    struct aws_epoch_domain *domain = participant->domain;
+    s_try_advance(domain);
+    size_t global_epoch = aws_atomic_load_int(&domain->global_epoch);
+
+    for (size_t i = 0; i < AWS_EPOCH_BUCKET_COUNT; ++i) {
+        struct aws_epoch_bucket *bucket = &participant->buckets[i];
+        if (aws_array_list_length(&bucket->items) && s_is_reclaimable(bucket->epoch, global_epoch)) {
+            s_free_bucket(participant, bucket);
+        }
+    }
+
+    aws_mutex_lock(&domain->lock);
+    size_t length = aws_array_list_length(&domain->orphans);
+    size_t kept = 0;
+    for (size_t i = 0; i < length; ++i) {
+        struct deferred_free *item = NULL;
+        aws_array_list_get_at_ptr(&domain->orphans, (void **)&item, i);
+        if (s_is_reclaimable(item->epoch, global_epoch)) {
+            s_run_deferred(item);
+        } else {
+            if (kept != i) {
+                aws_array_list_set_at(&domain->orphans, item, kept);
+            }
+            ++kept;
+        }
+    }
+    while (aws_array_list_length(&domain->orphans) > kept) {
+        aws_array_list_pop_back(&domain->orphans);
+    }
+    aws_mutex_unlock(&domain->lock);
+}
+
+size_t aws_epoch_participant_get_pending_count(const struct aws_epoch_participant *participant) {
+    return participant->pending_count;
+}
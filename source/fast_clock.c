@@ -0,0 +1,184 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/clock.h>
+
+#include <aws/common/atomics.h>
+#include <aws/common/thread.h>
+
+#if defined(__linux__)
+#    include <time.h>
+#endif
+
+#if defined(_M_X64) || defined(__x86_64__)
+#    define AWS_FAST_CLOCK_TSC
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    else
+#        include <cpuid.h>
+#        include <x86intrin.h>
+#    endif
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#    define AWS_FAST_CLOCK_CNTVCT
+#endif
+
+static const uint64_t NS_PER_SEC = 1000000000;
+
+/* How long the TSC is measured against the reference clock. Calibration error is roughly 1us / this. */
+static const uint64_t CALIBRATION_NS = 10000000;
+
+static aws_thread_once s_calibrate_once = AWS_THREAD_ONCE_STATIC_INIT;
+static struct aws_atomic_var s_calibrated = AWS_ATOMIC_INIT_INT(0);
+static bool s_hardware_counter;
+static uint64_t s_ticks_per_sec;
+
+/* CLOCK_MONOTONIC is served from the vDSO on Linux, where CLOCK_MONOTONIC_RAW often is not. */
+static uint64_t s_reference_ns(void) {
+    uint64_t now = 0;
+#if defined(__linux__)
+    struct timespec ts;
+    if (!clock_gettime(CLOCK_MONOTONIC, &ts)) {
+        now = (uint64_t)ts.tv_sec * NS_PER_SEC + (uint64_t)ts.tv_nsec;
+    }
+#else
+    aws_high_res_clock_get_ticks(&now);
+#endif
+    return now;
+}
+
+#if defined(AWS_FAST_CLOCK_TSC)
+
+static uint64_t s_read_counter(void) {
+    return __rdtsc();
+}
+
+/* The TSC only ticks at a constant rate across frequency changes and sleep states if it is invariant. */
+static bool s_has_invariant_tsc(void) {
+#    if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0x80000000);
+    if ((unsigned)regs[0] < 0x80000007) {
+        return false;
+    }
+    __cpuid(regs, 0x80000007);
+    return (regs[3] & (1 << 8)) != 0;
+#    else
+    unsigned eax = 0;
+    unsigned ebx = 0;
+    unsigned ecx = 0;
+    unsigned edx = 0;
+    if (__get_cpuid_max(0x80000000, NULL) < 0x80000007 || !__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (edx & (1u << 8)) != 0;
+#    endif
+}
+
+static uint64_t s_counter_frequency(void) {
+    if (!s_has_invariant_tsc()) {
+        return 0;
+    }
+
+    uint64_t start_ns = s_reference_ns();
+    uint64_t start_ticks = s_read_counter();
+    uint64_t end_ns = start_ns;
+    while (end_ns - start_ns < CALIBRATION_NS) {
+        end_ns = s_reference_ns();
+    }
+    uint64_t end_ticks = s_read_counter();
+
+    if (start_ns == 0 || end_ticks <= start_ticks) {
+        return 0;
+    }
+
+    /* the TSC runs at about the nominal core frequency; at 10ms the product can't overflow */
+    return (end_ticks - start_ticks) * NS_PER_SEC / (end_ns - start_ns);
+}
+
+#elif defined(AWS_FAST_CLOCK_CNTVCT)
+
+static uint64_t s_read_counter(void) {
+    uint64_t ticks;
+    __asm__ __volatile__("isb\n\tmrs %0, cntvct_el0" : "=r"(ticks)::"memory");
+    return ticks;
+}
+
+/* The generic timer reports its own frequency, so there is nothing to calibrate. */
+static uint64_t s_counter_frequency(void) {
+    uint64_t frequency;
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(frequency));
+    return frequency;
+}
+
+#else
+
+static uint64_t s_read_counter(void) {
+    return 0;
+}
+
+static uint64_t s_counter_frequency(void) {
+    return 0;
+}
+
+#endif
+
+static void s_calibrate(void) {
+    uint64_t frequency = s_counter_frequency();
+
+    /* anything below 1MHz is a broken measurement or a counter too coarse to beat the reference clock */
+    if (frequency >= 1000000) {
+        s_hardware_counter = true;
+        s_ticks_per_sec = frequency;
+    } else {
+        s_hardware_counter = false;
+        s_ticks_per_sec = NS_PER_SEC;
+    }
+
+    aws_atomic_store_int_explicit(&s_calibrated, 1, aws_memory_order_release);
+}
+
+static void s_ensure_calibrated(void) {
+    if (AWS_UNLIKELY(!aws_atomic_load_int_explicit(&s_calibrated, aws_memory_order_acquire))) {
+        aws_thread_call_once(&s_calibrate_once, s_calibrate);
+    }
+}
+
+uint64_t aws_fast_clock_get_ticks(void) {
+    s_ensure_calibrated();
+
+    return s_hardware_counter ? s_read_counter() : s_reference_ns();
+}
+
+uint64_t aws_fast_clock_ticks_to_ns(uint64_t ticks) {
+    s_ensure_calibrated();
+
+    /* split so that ticks * NS_PER_SEC never overflows, whatever the uptime */
+    uint64_t secs = ticks / s_ticks_per_sec;
+    uint64_t remainder = ticks % s_ticks_per_sec;
+    return aws_add_u64_saturating(
+        aws_mul_u64_saturating(secs, NS_PER_SEC), remainder * NS_PER_SEC / s_ticks_per_sec);
+}
+
+uint64_t aws_fast_clock_get_frequency(void) {
+    s_ensure_calibrated();
+
+    return s_ticks_per_sec;
+}
+
+bool aws_fast_clock_is_hardware_counter(void) {
+    s_ensure_calibrated();
+
+    return s_hardware_counter;
+}
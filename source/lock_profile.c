@@ -0,0 +1,296 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/private/lock_profile.h>
+
+#include <aws/common/atomics.h>
+#include <aws/common/clock.h>
+#include <aws/common/linked_list.h>
+#include <aws/common/mutex.h>
+#include <aws/common/rw_lock.h>
+#include <aws/common/seqlock.h>
+#include <aws/common/trace.h>
+
+#include <string.h>
+
+/* Counters of exclusive holds. */
+struct exclusive_counters {
+    uint64_t acquisitions;
+    uint64_t contended_acquisitions;
+    uint64_t wait_ns;
+    uint64_t max_hold_ns;
+};
+
+/* Every lock profiled under one name. */
+struct lock_class {
+    char name[AWS_LOCK_STATS_MAX_NAME_LEN + 1];
+    /* aws_lock_profile.node of every live lock with this name */
+    struct aws_linked_list live_profiles;
+    /* counters of locks with this name that have been cleaned up */
+    struct aws_lock_stats retired;
+};
+
+struct aws_lock_profile {
+    struct aws_allocator *allocator;
+    /* the profiled lock, to tell locks apart in traces */
+    const void *lock;
+    /* NULL if the lock was not given a name */
+    struct lock_class *lock_class;
+    struct aws_linked_list_node node;
+    /* when the current exclusive hold started; only touched by the exclusive holder */
+    uint64_t hold_start;
+    /*
+     * only changed by the exclusive holder, inside exclusive_seqlock, so that readers on other threads retry instead of
+     * seeing a half-written 64-bit value
+     */
+    struct exclusive_counters exclusive;
+    struct aws_seqlock exclusive_seqlock;
+    /* shared acquisitions run concurrently, so their count is atomic and summed in when stats are read */
+    struct aws_atomic_var shared_acquisitions;
+    /* a contended shared acquisition has already waited, so taking this lock to record the wait costs it little */
+    struct aws_mutex shared_wait_lock;
+    uint64_t shared_contended_acquisitions;
+    uint64_t shared_wait_ns;
+};
+
+/* Guards the class table and the class lists. Never profiled itself. */
+static struct aws_mutex s_registry_lock = AWS_MUTEX_INIT;
+static struct lock_class s_classes[AWS_LOCK_STATS_MAX_NAMES];
+static size_t s_class_count;
+
+/* Must hold s_registry_lock. */
+static struct lock_class *s_find_class(const char *name) {
+    for (size_t i = 0; i < s_class_count; ++i) {
+        if (!strcmp(s_classes[i].name, name)) {
+            return &s_classes[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void s_fold_stats(struct aws_lock_stats *into, const struct aws_lock_stats *from) {
+    into->acquisitions += from->acquisitions;
+    into->contended_acquisitions += from->contended_acquisitions;
+    into->total_wait_ns += from->total_wait_ns;
+    if (from->max_hold_ns > into->max_hold_ns) {
+        into->max_hold_ns = from->max_hold_ns;
+    }
+}
+
+struct aws_lock_profile *aws_lock_profile_private_new(
+    struct aws_allocator *allocator,
+    const void *lock,
+    const char *name) {
+    if (name && strlen(name) > AWS_LOCK_STATS_MAX_NAME_LEN) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    struct aws_lock_profile *profile = aws_mem_acquire(allocator, sizeof(struct aws_lock_profile));
+    if (!profile) {
+        return NULL;
+    }
+
+    AWS_ZERO_STRUCT(*profile);
+    profile->allocator = allocator;
+    profile->lock = lock;
+    aws_atomic_init_int(&profile->shared_acquisitions, 0);
+    if (aws_seqlock_init(&profile->exclusive_seqlock)) {
+        aws_mem_release(allocator, profile);
+        return NULL;
+    }
+    if (aws_mutex_init(&profile->shared_wait_lock)) {
+        aws_seqlock_clean_up(&profile->exclusive_seqlock);
+        aws_mem_release(allocator, profile);
+        return NULL;
+    }
+
+    if (!name) {
+        return profile;
+    }
+
+    aws_mutex_lock(&s_registry_lock);
+    struct lock_class *lock_class = s_find_class(name);
+    if (!lock_class && s_class_count < AWS_LOCK_STATS_MAX_NAMES) {
+        lock_class = &s_classes[s_class_count++];
+        strcpy(lock_class->name, name);
+        aws_linked_list_init(&lock_class->live_profiles);
+    }
+    if (lock_class) {
+        profile->lock_class = lock_class;
+        aws_linked_list_push_back(&lock_class->live_profiles, &profile->node);
+    }
+    aws_mutex_unlock(&s_registry_lock);
+
+    if (!lock_class) {
+        aws_mutex_clean_up(&profile->shared_wait_lock);
+        aws_seqlock_clean_up(&profile->exclusive_seqlock);
+        aws_mem_release(allocator, profile);
+        aws_raise_error(AWS_ERROR_INVALID_STATE);
+        return NULL;
+    }
+
+    return profile;
+}
+
+void aws_lock_profile_private_destroy(struct aws_lock_profile *profile) {
+    if (profile->lock_class) {
+        struct aws_lock_stats stats;
+        aws_lock_profile_private_get_stats(profile, &stats);
+
+        aws_mutex_lock(&s_registry_lock);
+        aws_linked_list_remove(&profile->node);
+        s_fold_stats(&profile->lock_class->retired, &stats);
+        aws_mutex_unlock(&s_registry_lock);
+    }
+
+    aws_mutex_clean_up(&profile->shared_wait_lock);
+    aws_seqlock_clean_up(&profile->exclusive_seqlock);
+    aws_mem_release(profile->allocator, profile);
+}
+
+uint64_t aws_lock_profile_private_now(void) {
+    uint64_t now = 0;
+    aws_high_res_clock_get_ticks(&now);
+    return now;
+}
+
+void aws_lock_profile_private_acquired(
+    struct aws_lock_profile *profile,
+    bool exclusive,
+    bool contended,
+    uint64_t wait_start) {
+
+    if (!exclusive) {
+        aws_atomic_fetch_add_explicit(&profile->shared_acquisitions, 1, aws_memory_order_relaxed);
+        if (contended) {
+            uint64_t now = aws_lock_profile_private_now();
+            uint64_t wait_ns = now > wait_start ? now - wait_start : 0;
+            AWS_TRACE_EVENT(AWS_TRACE_EVENT_LOCK_WAIT, (uintptr_t)profile->lock, wait_ns);
+            aws_mutex_lock(&profile->shared_wait_lock);
+            profile->shared_contended_acquisitions++;
+            profile->shared_wait_ns += wait_ns;
+            aws_mutex_unlock(&profile->shared_wait_lock);
+        }
+        return;
+    }
+
+    uint64_t now = aws_lock_profile_private_now();
+    uint64_t wait_ns = 0;
+    if (contended) {
+        wait_ns = now > wait_start ? now - wait_start : 0;
+        AWS_TRACE_EVENT(AWS_TRACE_EVENT_LOCK_WAIT, (uintptr_t)profile->lock, wait_ns);
+    }
+
+    aws_seqlock_write_lock(&profile->exclusive_seqlock);
+    profile->exclusive.acquisitions++;
+    if (contended) {
+        profile->exclusive.contended_acquisitions++;
+        profile->exclusive.wait_ns += wait_ns;
+    }
+    aws_seqlock_write_unlock(&profile->exclusive_seqlock);
+    profile->hold_start = now;
+}
+
+void aws_lock_profile_private_released(struct aws_lock_profile *profile) {
+    uint64_t now = aws_lock_profile_private_now();
+    uint64_t held = now > profile->hold_start ? now - profile->hold_start : 0;
+    /* the holder is the only writer, so it can read the counters outside the seqlock */
+    if (held > profile->exclusive.max_hold_ns) {
+        aws_seqlock_write_lock(&profile->exclusive_seqlock);
+        profile->exclusive.max_hold_ns = held;
+        aws_seqlock_write_unlock(&profile->exclusive_seqlock);
+    }
+}
+
+void aws_lock_profile_private_reacquired(struct aws_lock_profile *profile) {
+    profile->hold_start = aws_lock_profile_private_now();
+}
+
+void aws_lock_profile_private_get_stats(struct aws_lock_profile *profile, struct aws_lock_stats *stats) {
+    struct exclusive_counters exclusive;
+    aws_seqlock_read_copy(&profile->exclusive_seqlock, &exclusive, &profile->exclusive, sizeof(exclusive));
+    stats->acquisitions = exclusive.acquisitions;
+    stats->contended_acquisitions = exclusive.contended_acquisitions;
+    stats->total_wait_ns = exclusive.wait_ns;
+    stats->max_hold_ns = exclusive.max_hold_ns;
+
+    stats->acquisitions += aws_atomic_load_int_explicit(&profile->shared_acquisitions, aws_memory_order_relaxed);
+    aws_mutex_lock(&profile->shared_wait_lock);
+    stats->contended_acquisitions += profile->shared_contended_acquisitions;
+    stats->total_wait_ns += profile->shared_wait_ns;
+    aws_mutex_unlock(&profile->shared_wait_lock);
+}
+
+int aws_lock_stats_get_by_name(const char *name, struct aws_lock_stats *stats) {
+    AWS_ZERO_STRUCT(*stats);
+
+    aws_mutex_lock(&s_registry_lock);
+    struct lock_class *lock_class = s_find_class(name);
+    if (lock_class) {
+        *stats = lock_class->retired;
+        for (struct aws_linked_list_node *node = aws_linked_list_begin(&lock_class->live_profiles);
+             node != aws_linked_list_end(&lock_class->live_profiles);
+             node = aws_linked_list_next(node)) {
+            struct aws_lock_stats live;
+            aws_lock_profile_private_get_stats(AWS_CONTAINER_OF(node, struct aws_lock_profile, node), &live);
+            s_fold_stats(stats, &live);
+        }
+    }
+    aws_mutex_unlock(&s_registry_lock);
+
+    if (!lock_class) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_mutex_enable_profiling(struct aws_mutex *mutex, struct aws_allocator *allocator, const char *name) {
+    if (mutex->profile) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    mutex->profile = aws_lock_profile_private_new(allocator, mutex, name);
+    return mutex->profile ? AWS_OP_SUCCESS : AWS_OP_ERR;
+}
+
+int aws_mutex_get_lock_stats(const struct aws_mutex *mutex, struct aws_lock_stats *stats) {
+    if (!mutex->profile) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    aws_lock_profile_private_get_stats(mutex->profile, stats);
+    return AWS_OP_SUCCESS;
+}
+
+int aws_rw_lock_enable_profiling(struct aws_rw_lock *lock, struct aws_allocator *allocator, const char *name) {
+    if (lock->profile) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    lock->profile = aws_lock_profile_private_new(allocator, lock, name);
+    return lock->profile ? AWS_OP_SUCCESS : AWS_OP_ERR;
+}
+
+int aws_rw_lock_get_lock_stats(const struct aws_rw_lock *lock, struct aws_lock_stats *stats) {
+    if (!lock->profile) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    aws_lock_profile_private_get_stats(lock->profile, stats);
+    return AWS_OP_SUCCESS;
+}
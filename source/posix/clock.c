@@ -132,3 +132,19 @@ int aws_sys_clock_get_ticks(uint64_t *timestamp) {
     return AWS_OP_SUCCESS;
 }
 #endif /* defined(__MACH__) */
+
+#if defined(CLOCK_REALTIME_COARSE)
+int aws_sys_clock_get_ticks_coarse(uint64_t *timestamp) {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_REALTIME_COARSE, &ts)) {
+        return aws_raise_error(AWS_ERROR_CLOCK_FAILURE);
+    }
+
+    *timestamp = (uint64_t)((ts.tv_sec * NS_PER_SEC) + ts.tv_nsec);
+    return AWS_OP_SUCCESS;
+}
+#else
+int aws_sys_clock_get_ticks_coarse(uint64_t *timestamp) {
+    return aws_sys_clock_get_ticks(timestamp);
+}
+#endif /* defined(CLOCK_REALTIME_COARSE) */
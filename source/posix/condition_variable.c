@@ -17,6 +17,7 @@
 
 #include <aws/common/clock.h>
 #include <aws/common/mutex.h>
+#include <aws/common/private/lock_profile.h>
 
 #include <errno.h>
 
@@ -64,8 +65,16 @@ int aws_condition_variable_notify_all(struct aws_condition_variable *condition_v
 }
 
 int aws_condition_variable_wait(struct aws_condition_variable *condition_variable, struct aws_mutex *mutex) {
+    if (AWS_UNLIKELY(mutex->profile != NULL)) {
+        aws_lock_profile_private_released(mutex->profile);
+    }
+
     int err_code = pthread_cond_wait(&condition_variable->condition_handle, &mutex->mutex_handle);
 
+    if (AWS_UNLIKELY(mutex->profile != NULL)) {
+        aws_lock_profile_private_reacquired(mutex->profile);
+    }
+
     if (err_code) {
         return process_error_code(err_code);
     }
@@ -91,8 +100,16 @@ int aws_condition_variable_wait_for(
         (time_t)aws_timestamp_convert((uint64_t)time_to_wait, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_SECS, &remainder);
     ts.tv_nsec = (long)remainder;
 
+    if (AWS_UNLIKELY(mutex->profile != NULL)) {
+        aws_lock_profile_private_released(mutex->profile);
+    }
+
     int err_code = pthread_cond_timedwait(&condition_variable->condition_handle, &mutex->mutex_handle, &ts);
 
+    if (AWS_UNLIKELY(mutex->profile != NULL)) {
+        aws_lock_profile_private_reacquired(mutex->profile);
+    }
+
     if (err_code) {
         return process_error_code(err_code);
     }
@@ -12,23 +12,64 @@
  * express or implied. See the License for the specific language governing
  * permissions and limitations under the License.
  */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+/* for syscall() */
+#    define _GNU_SOURCE
+#endif
+
 #include <aws/common/device_random.h>
 
-#include <aws/common/byte_buf.h>
+#include <aws/common/atomics.h>
 #include <aws/common/thread.h>
 
+#include <aws/common/private/device_random.h>
+
+#include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <unistd.h>
 
+#if defined(__linux__)
+#    include <sys/syscall.h>
+#    if defined(SYS_getrandom)
+/* called through syscall() since the libc wrapper is newer than the kernel call */
+#        define USE_GETRANDOM
+#    endif
+#endif
+
 static int s_rand_fd = -1;
+static bool s_use_getrandom = false;
 static aws_thread_once s_rand_init = AWS_THREAD_ONCE_STATIC_INIT;
+static struct aws_atomic_var s_fork_generation = AWS_ATOMIC_INIT_INT(0);
+static pthread_key_t s_thread_buffer_key;
+static bool s_thread_buffer_key_created = false;
+static aws_thread_once s_thread_buffer_key_init = AWS_THREAD_ONCE_STATIC_INIT;
 
 #ifdef O_CLOEXEC
 #    define OPEN_FLAGS (O_RDONLY | O_CLOEXEC)
 #else
 #    define OPEN_FLAGS (O_RDONLY)
 #endif
+
+static void s_on_fork_child(void) {
+    aws_atomic_fetch_add(&s_fork_generation, 1);
+}
+
 static void s_init_rand(void) {
+    if (pthread_atfork(NULL, NULL, s_on_fork_child)) {
+        abort();
+    }
+
+#ifdef USE_GETRANDOM
+    /* old kernels, and some seccomp sandboxes, reject getrandom; /dev/urandom still works there */
+    uint8_t probe = 0;
+    if (syscall(SYS_getrandom, &probe, sizeof(probe), 0) == sizeof(probe)) {
+        s_use_getrandom = true;
+        return;
+    }
+#endif
+
     s_rand_fd = open("/dev/urandom", OPEN_FLAGS);
 
     if (s_rand_fd == -1) {
@@ -44,23 +85,46 @@ static void s_init_rand(void) {
     }
 }
 
-static int s_fallback_device_random_buffer(struct aws_byte_buf *output) {
+static ssize_t s_read_some(uint8_t *dest, size_t len) {
+#ifdef USE_GETRANDOM
+    if (s_use_getrandom) {
+        return (ssize_t)syscall(SYS_getrandom, dest, len, 0);
+    }
+#endif
+    return read(s_rand_fd, dest, len);
+}
 
+int aws_device_random_private_fill(uint8_t *dest, size_t len) {
     aws_thread_call_once(&s_rand_init, s_init_rand);
 
-    size_t diff = output->capacity - output->len;
-
-    ssize_t amount_read = read(s_rand_fd, output->buffer + output->len, diff);
+    /* both sources may return less than asked for, when interrupted by a signal or for very large requests */
+    while (len > 0) {
+        ssize_t amount_read = s_read_some(dest, len);
+        if (amount_read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (amount_read <= 0) {
+            return aws_raise_error(AWS_ERROR_RANDOM_GEN_FAILED);
+        }
 
-    if (amount_read != diff) {
-        return aws_raise_error(AWS_ERROR_RANDOM_GEN_FAILED);
+        dest += amount_read;
+        len -= (size_t)amount_read;
     }
 
-    output->len += diff;
-
     return AWS_OP_SUCCESS;
 }
 
-int aws_device_random_buffer(struct aws_byte_buf *output) {
-    return s_fallback_device_random_buffer(output);
+size_t aws_device_random_private_fork_generation(void) {
+    return aws_atomic_load_int_explicit(&s_fork_generation, aws_memory_order_relaxed);
+}
+
+static void s_init_thread_buffer_key(void) {
+    s_thread_buffer_key_created =
+        !pthread_key_create(&s_thread_buffer_key, aws_device_random_private_release_thread_buffer);
+}
+
+bool aws_device_random_private_watch_thread_exit(void *buffer) {
+    aws_thread_call_once(&s_thread_buffer_key_init, s_init_thread_buffer_key);
+
+    return s_thread_buffer_key_created && !pthread_setspecific(s_thread_buffer_key, buffer);
 }
@@ -15,17 +15,23 @@
 
 #include <aws/common/mutex.h>
 #include <aws/common/posix/common.inl>
+#include <aws/common/private/lock_profile.h>
 
 #include <errno.h>
 
 void aws_mutex_clean_up(struct aws_mutex *mutex) {
     pthread_mutex_destroy(&mutex->mutex_handle);
+    if (mutex->profile) {
+        aws_lock_profile_private_destroy(mutex->profile);
+        mutex->profile = NULL;
+    }
 }
 
 int aws_mutex_init(struct aws_mutex *mutex) {
     pthread_mutexattr_t attr;
     int err_code = pthread_mutexattr_init(&attr);
     int return_code = AWS_OP_SUCCESS;
+    mutex->profile = NULL;
 
     if (!err_code) {
         if ((err_code = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_NORMAL)) ||
@@ -41,17 +47,47 @@ int aws_mutex_init(struct aws_mutex *mutex) {
     return return_code;
 }
 
+static int s_profiled_lock(struct aws_mutex *mutex) {
+    bool contended = false;
+    uint64_t wait_start = 0;
+    int err_code = pthread_mutex_trylock(&mutex->mutex_handle);
+    if (err_code == EBUSY) {
+        contended = true;
+        wait_start = aws_lock_profile_private_now();
+        err_code = pthread_mutex_lock(&mutex->mutex_handle);
+    }
+
+    if (!err_code) {
+        aws_lock_profile_private_acquired(mutex->profile, true, contended, wait_start);
+    }
+
+    return aws_private_convert_and_raise_error_code(err_code);
+}
+
 int aws_mutex_lock(struct aws_mutex *mutex) {
 
+    if (AWS_UNLIKELY(mutex->profile != NULL)) {
+        return s_profiled_lock(mutex);
+    }
+
     return aws_private_convert_and_raise_error_code(pthread_mutex_lock(&mutex->mutex_handle));
 }
 
 int aws_mutex_try_lock(struct aws_mutex *mutex) {
 
-    return aws_private_convert_and_raise_error_code(pthread_mutex_trylock(&mutex->mutex_handle));
+    int err_code = pthread_mutex_trylock(&mutex->mutex_handle);
+    if (AWS_UNLIKELY(mutex->profile != NULL) && !err_code) {
+        aws_lock_profile_private_acquired(mutex->profile, true, false, 0);
+    }
+
+    return aws_private_convert_and_raise_error_code(err_code);
 }
 
 int aws_mutex_unlock(struct aws_mutex *mutex) {
 
+    if (AWS_UNLIKELY(mutex->profile != NULL)) {
+        aws_lock_profile_private_released(mutex->profile);
+    }
+
     return aws_private_convert_and_raise_error_code(pthread_mutex_unlock(&mutex->mutex_handle));
 }
@@ -17,35 +17,83 @@
 #include <aws/common/rw_lock.h>
 
 #include <aws/common/posix/common.inl>
+#include <aws/common/private/lock_profile.h>
+
+#include <errno.h>
 
 int aws_rw_lock_init(struct aws_rw_lock *lock) {
 
+    lock->profile = NULL;
     return aws_private_convert_and_raise_error_code(pthread_rwlock_init(&lock->lock_handle, NULL));
 }
 
 void aws_rw_lock_clean_up(struct aws_rw_lock *lock) {
 
     pthread_rwlock_destroy(&lock->lock_handle);
+    if (lock->profile) {
+        aws_lock_profile_private_destroy(lock->profile);
+        lock->profile = NULL;
+    }
+}
+
+static int s_profiled_lock(
+    struct aws_rw_lock *lock,
+    bool exclusive,
+    int (*try_lock_fn)(pthread_rwlock_t *),
+    int (*lock_fn)(pthread_rwlock_t *)) {
+
+    bool contended = false;
+    uint64_t wait_start = 0;
+    int err_code = try_lock_fn(&lock->lock_handle);
+    if (err_code == EBUSY) {
+        contended = true;
+        wait_start = aws_lock_profile_private_now();
+        err_code = lock_fn(&lock->lock_handle);
+    }
+
+    if (!err_code) {
+        aws_lock_profile_private_acquired(lock->profile, exclusive, contended, wait_start);
+    }
+
+    return aws_private_convert_and_raise_error_code(err_code);
 }
 
 int aws_rw_lock_rlock(struct aws_rw_lock *lock) {
 
+    if (AWS_UNLIKELY(lock->profile != NULL)) {
+        return s_profiled_lock(lock, false, pthread_rwlock_tryrdlock, pthread_rwlock_rdlock);
+    }
+
     return aws_private_convert_and_raise_error_code(pthread_rwlock_rdlock(&lock->lock_handle));
 }
 
 int aws_rw_lock_wlock(struct aws_rw_lock *lock) {
 
+    if (AWS_UNLIKELY(lock->profile != NULL)) {
+        return s_profiled_lock(lock, true, pthread_rwlock_trywrlock, pthread_rwlock_wrlock);
+    }
+
     return aws_private_convert_and_raise_error_code(pthread_rwlock_wrlock(&lock->lock_handle));
 }
 
 int aws_rw_lock_try_rlock(struct aws_rw_lock *lock) {
 
-    return aws_private_convert_and_raise_error_code(pthread_rwlock_tryrdlock(&lock->lock_handle));
+    int err_code = pthread_rwlock_tryrdlock(&lock->lock_handle);
+    if (AWS_UNLIKELY(lock->profile != NULL) && !err_code) {
+        aws_lock_profile_private_acquired(lock->profile, false, false, 0);
+    }
+
+    return aws_private_convert_and_raise_error_code(err_code);
 }
 
 int aws_rw_lock_try_wlock(struct aws_rw_lock *lock) {
 
-    return aws_private_convert_and_raise_error_code(pthread_rwlock_trywrlock(&lock->lock_handle));
+    int err_code = pthread_rwlock_trywrlock(&lock->lock_handle);
+    if (AWS_UNLIKELY(lock->profile != NULL) && !err_code) {
+        aws_lock_profile_private_acquired(lock->profile, true, false, 0);
+    }
+
+    return aws_private_convert_and_raise_error_code(err_code);
 }
 
 int aws_rw_lock_runlock(struct aws_rw_lock *lock) {
@@ -55,5 +103,9 @@ int aws_rw_lock_runlock(struct aws_rw_lock *lock) {
 
 int aws_rw_lock_wunlock(struct aws_rw_lock *lock) {
 
+    if (AWS_UNLIKELY(lock->profile != NULL)) {
+        aws_lock_profile_private_released(lock->profile);
+    }
+
     return aws_private_convert_and_raise_error_code(pthread_rwlock_unlock(&lock->lock_handle));
 }
@@ -15,7 +15,12 @@
 
 #include <aws/common/system_info.h>
 
+#include <aws/common/private/cpu_topology.h>
+
 #include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #if defined(__FreeBSD__) || defined(__NetBSD__)
 #    define __BSD_VISIBLE 1
@@ -23,6 +28,10 @@
 
 #include <unistd.h>
 
+#if defined(__APPLE__)
+#    include <sys/sysctl.h>
+#endif
+
 #if defined(HAVE_SYSCONF)
 size_t aws_system_info_processor_count(void) {
     long nprocs = sysconf(_SC_NPROCESSORS_ONLN);
@@ -43,3 +52,286 @@ size_t aws_system_info_processor_count(void) {
 #    endif
 }
 #endif
+
+bool aws_cpu_list_private_parse(const char *list, void (*on_id)(size_t id, void *user_data), void *user_data) {
+    const char *cursor = list;
+    while (*cursor && *cursor != '\n') {
+        char *end = NULL;
+        unsigned long first = strtoul(cursor, &end, 10);
+        if (end == cursor) {
+            return false;
+        }
+        unsigned long last = first;
+        cursor = end;
+        if (*cursor == '-') {
+            ++cursor;
+            last = strtoul(cursor, &end, 10);
+            if (end == cursor || last < first) {
+                return false;
+            }
+            cursor = end;
+        }
+        for (unsigned long id = first; id <= last; ++id) {
+            on_id((size_t)id, user_data);
+        }
+        if (*cursor == ',') {
+            ++cursor;
+        } else if (*cursor && *cursor != '\n') {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool aws_cpu_list_private_read_file(const char *path, char *buffer, size_t buffer_size) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        return false;
+    }
+
+    bool read = fgets(buffer, (int)buffer_size, file) != NULL;
+    fclose(file);
+
+    return read;
+}
+
+#if defined(__linux__)
+
+#    define SYSFS_CPU_PATH "/sys/devices/system/cpu"
+#    define SYSFS_NODE_PATH "/sys/devices/system/node"
+/* enough for any cpu list the kernel writes on machines with a few thousand CPUs */
+#    define SYSFS_LIST_MAX 8192
+
+struct cpu_list_builder {
+    struct aws_cpu_info *cpus;
+    size_t count;
+};
+
+static void s_count_id(size_t id, void *user_data) {
+    (void)id;
+    ((struct cpu_list_builder *)user_data)->count++;
+}
+
+static void s_append_cpu(size_t id, void *user_data) {
+    struct cpu_list_builder *builder = user_data;
+    builder->cpus[builder->count++] = (struct aws_cpu_info){.cpu_id = (uint32_t)id};
+}
+
+/* Reads a sysfs file holding one integer. Some architectures report -1 for ids they don't know. */
+static long s_read_long(const char *path, long default_value) {
+    char buffer[32];
+    if (!aws_cpu_list_private_read_file(path, buffer, sizeof(buffer))) {
+        return default_value;
+    }
+
+    char *end = NULL;
+    long value = strtol(buffer, &end, 10);
+    return end == buffer || value < 0 ? default_value : value;
+}
+
+/* Reads a cache size such as "48K". */
+static size_t s_read_size(const char *path) {
+    char buffer[32];
+    if (!aws_cpu_list_private_read_file(path, buffer, sizeof(buffer))) {
+        return 0;
+    }
+
+    char *end = NULL;
+    size_t size = (size_t)strtoul(buffer, &end, 10);
+    switch (*end) {
+        case 'K':
+            return size << 10;
+        case 'M':
+            return size << 20;
+        case 'G':
+            return size << 30;
+        default:
+            return size;
+    }
+}
+
+/* Assigns every core a dense index, keyed by its (package, core id) pair. */
+static void s_assign_core_indices(struct aws_cpu_topology *topology, const uint32_t *core_ids) {
+    uint32_t next_core_index = 0;
+    for (size_t i = 0; i < topology->logical_cpu_count; ++i) {
+        struct aws_cpu_info *cpu = &topology->cpus[i];
+        cpu->core_index = next_core_index;
+        for (size_t j = 0; j < i; ++j) {
+            if (core_ids[j] == core_ids[i] && topology->cpus[j].package_id == cpu->package_id) {
+                cpu->core_index = topology->cpus[j].core_index;
+                break;
+            }
+        }
+        next_core_index += cpu->core_index == next_core_index;
+    }
+}
+
+struct numa_node_assignment {
+    struct aws_cpu_topology *topology;
+    uint32_t numa_node;
+};
+
+static void s_assign_numa_node(size_t cpu_id, void *user_data) {
+    struct numa_node_assignment *assignment = user_data;
+    struct aws_cpu_info *cpu = (struct aws_cpu_info *)aws_cpu_topology_get_cpu(assignment->topology, (uint32_t)cpu_id);
+    if (cpu) {
+        cpu->numa_node = assignment->numa_node;
+    }
+}
+
+static void s_read_numa_node(size_t numa_node, void *user_data) {
+    struct aws_cpu_topology *topology = user_data;
+    char path[64];
+    char list[SYSFS_LIST_MAX];
+    snprintf(path, sizeof(path), SYSFS_NODE_PATH "/node%zu/cpulist", numa_node);
+    if (aws_cpu_list_private_read_file(path, list, sizeof(list))) {
+        struct numa_node_assignment assignment = {.topology = topology, .numa_node = (uint32_t)numa_node};
+        aws_cpu_list_private_parse(list, s_assign_numa_node, &assignment);
+    }
+}
+
+static void s_read_caches(struct aws_cpu_topology *topology) {
+    char path[128];
+    char buffer[SYSFS_LIST_MAX];
+    uint32_t cpu_id = topology->cpus[0].cpu_id;
+
+    for (unsigned index = 0;; ++index) {
+        snprintf(path, sizeof(path), SYSFS_CPU_PATH "/cpu%u/cache/index%u/level", (unsigned)cpu_id, index);
+        long level = s_read_long(path, -1);
+        if (level < 0) {
+            break;
+        }
+
+        snprintf(path, sizeof(path), SYSFS_CPU_PATH "/cpu%u/cache/index%u/type", (unsigned)cpu_id, index);
+        if (!aws_cpu_list_private_read_file(path, buffer, sizeof(buffer))) {
+            continue;
+        }
+
+        struct aws_cache_info *cache = NULL;
+        if (level == 1 && strncmp(buffer, "Data", 4) == 0) {
+            cache = &topology->l1_data_cache;
+        } else if (level == 1 && strncmp(buffer, "Instruction", 11) == 0) {
+            cache = &topology->l1_instruction_cache;
+        } else if (level == 2) {
+            cache = &topology->l2_cache;
+        } else if (level == 3) {
+            cache = &topology->l3_cache;
+        } else {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), SYSFS_CPU_PATH "/cpu%u/cache/index%u/size", (unsigned)cpu_id, index);
+        cache->size = s_read_size(path);
+        snprintf(
+            path, sizeof(path), SYSFS_CPU_PATH "/cpu%u/cache/index%u/coherency_line_size", (unsigned)cpu_id, index);
+        cache->line_size = (size_t)s_read_long(path, 0);
+
+        struct cpu_list_builder sharing = {0};
+        snprintf(path, sizeof(path), SYSFS_CPU_PATH "/cpu%u/cache/index%u/shared_cpu_list", (unsigned)cpu_id, index);
+        if (aws_cpu_list_private_read_file(path, buffer, sizeof(buffer))) {
+            aws_cpu_list_private_parse(buffer, s_count_id, &sharing);
+        }
+        cache->shared_cpu_count = sharing.count ? sharing.count : 1;
+    }
+}
+
+static int s_topology_init_sysfs(struct aws_cpu_topology *topology) {
+    char list[SYSFS_LIST_MAX];
+    struct cpu_list_builder builder = {0};
+    if (!aws_cpu_list_private_read_file(SYSFS_CPU_PATH "/online", list, sizeof(list)) ||
+        !aws_cpu_list_private_parse(list, s_count_id, &builder) || builder.count == 0) {
+        return aws_cpu_topology_private_init_flat(topology);
+    }
+
+    topology->cpus = aws_mem_acquire(topology->allocator, builder.count * sizeof(struct aws_cpu_info));
+    uint32_t *core_ids = aws_mem_acquire(topology->allocator, builder.count * sizeof(uint32_t));
+    if (!topology->cpus || !core_ids) {
+        goto error;
+    }
+
+    builder.cpus = topology->cpus;
+    builder.count = 0;
+    aws_cpu_list_private_parse(list, s_append_cpu, &builder);
+    topology->logical_cpu_count = builder.count;
+
+    char path[128];
+    for (size_t i = 0; i < topology->logical_cpu_count; ++i) {
+        struct aws_cpu_info *cpu = &topology->cpus[i];
+        snprintf(path, sizeof(path), SYSFS_CPU_PATH "/cpu%u/topology/core_id", (unsigned)cpu->cpu_id);
+        /* without a core id, a CPU can only be assumed to be a core of its own */
+        core_ids[i] = (uint32_t)s_read_long(path, (long)cpu->cpu_id);
+        snprintf(path, sizeof(path), SYSFS_CPU_PATH "/cpu%u/topology/physical_package_id", (unsigned)cpu->cpu_id);
+        cpu->package_id = (uint32_t)s_read_long(path, 0);
+    }
+    s_assign_core_indices(topology, core_ids);
+    aws_mem_release(topology->allocator, core_ids);
+
+    /* without NUMA support in the kernel there is no node directory, and every CPU stays on node 0 */
+    if (aws_cpu_list_private_read_file(SYSFS_NODE_PATH "/online", list, sizeof(list))) {
+        aws_cpu_list_private_parse(list, s_read_numa_node, topology);
+    }
+
+    s_read_caches(topology);
+
+    return AWS_OP_SUCCESS;
+
+error:
+    if (topology->cpus) {
+        aws_mem_release(topology->allocator, topology->cpus);
+        topology->cpus = NULL;
+    }
+    if (core_ids) {
+        aws_mem_release(topology->allocator, core_ids);
+    }
+    return AWS_OP_ERR;
+}
+
+#elif defined(__APPLE__)
+
+static size_t s_sysctl_size(const char *name) {
+    int64_t value = 0;
+    size_t value_size = sizeof(value);
+    if (sysctlbyname(name, &value, &value_size, NULL, 0) || value < 0) {
+        return 0;
+    }
+    return (size_t)value;
+}
+
+/* Darwin reports cache sizes but not which CPUs share a core, so the cores stay flat. */
+static int s_topology_init_sysctl(struct aws_cpu_topology *topology) {
+    if (aws_cpu_topology_private_init_flat(topology)) {
+        return AWS_OP_ERR;
+    }
+
+    size_t line_size = s_sysctl_size("hw.cachelinesize");
+    topology->l1_data_cache = (struct aws_cache_info){s_sysctl_size("hw.l1dcachesize"), line_size, 1};
+    topology->l1_instruction_cache = (struct aws_cache_info){s_sysctl_size("hw.l1icachesize"), line_size, 1};
+    topology->l2_cache = (struct aws_cache_info){s_sysctl_size("hw.l2cachesize"), line_size, 1};
+    topology->l3_cache = (struct aws_cache_info){s_sysctl_size("hw.l3cachesize"), line_size, 1};
+
+    return AWS_OP_SUCCESS;
+}
+
+#endif
+
+int aws_system_info_cpu_topology_init(struct aws_cpu_topology *topology, struct aws_allocator *allocator) {
+    AWS_ZERO_STRUCT(*topology);
+    topology->allocator = allocator;
+
+#if defined(__linux__)
+    int result = s_topology_init_sysfs(topology);
+#elif defined(__APPLE__)
+    int result = s_topology_init_sysctl(topology);
+#else
+    int result = aws_cpu_topology_private_init_flat(topology);
+#endif
+
+    if (result) {
+        AWS_ZERO_STRUCT(*topology);
+        return AWS_OP_ERR;
+    }
+
+    aws_cpu_topology_private_summarize(topology);
+    return AWS_OP_SUCCESS;
+}
@@ -13,29 +13,187 @@
  * permissions and limitations under the License.
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+/* for CPU affinity, thread names and syscall() */
+#    define _GNU_SOURCE
+#endif
+
 #include <aws/common/thread.h>
 
 #include <aws/common/clock.h>
+#include <aws/common/private/cpu_topology.h>
 
 #include <assert.h>
 #include <errno.h>
 #include <limits.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
 #include <time.h>
 
+#if defined(__linux__)
+#    include <linux/mempolicy.h>
+#    include <sys/resource.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
 static struct aws_thread_options s_default_options = {
     /* this will make sure platform default stack size is used. */
     .stack_size = 0};
 
+/* Settings that can only be applied from inside the new thread are carried here. */
 struct thread_wrapper {
     struct aws_allocator *allocator;
     void (*func)(void *arg);
     void *arg;
+    char name[AWS_THREAD_NAME_RECOMMENDED_MAX + 1];
+    enum aws_thread_priority priority;
+    bool prefer_numa_node;
+    uint16_t numa_node;
 };
 
+static void s_set_current_name(const char *name) {
+#if defined(__linux__)
+    pthread_setname_np(pthread_self(), name);
+#elif defined(__APPLE__)
+    pthread_setname_np(name);
+#else
+    (void)name;
+#endif
+}
+
+#if defined(__linux__)
+
+/* On Linux each thread has its own nice value, which is what SCHED_OTHER priorities are made of. */
+static void s_set_current_priority(enum aws_thread_priority priority) {
+    static const int s_nice_values[] = {
+        [AWS_THREAD_PRIORITY_LOWEST] = 19,
+        [AWS_THREAD_PRIORITY_LOW] = 10,
+        [AWS_THREAD_PRIORITY_HIGH] = -5,
+        [AWS_THREAD_PRIORITY_HIGHEST] = -10,
+    };
+
+    if ((size_t)priority >= AWS_ARRAY_SIZE(s_nice_values)) {
+        return;
+    }
+
+    /* raising priority fails without CAP_SYS_NICE; the thread then just runs at the default */
+    setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), s_nice_values[priority]);
+}
+
+static void s_set_current_numa_node(uint16_t numa_node) {
+    unsigned long node_mask[1024 / (8 * sizeof(unsigned long))] = {0};
+    const size_t bits_per_word = 8 * sizeof(unsigned long);
+    if (numa_node >= AWS_ARRAY_SIZE(node_mask) * bits_per_word) {
+        return;
+    }
+
+    node_mask[numa_node / bits_per_word] = 1UL << (numa_node % bits_per_word);
+    /* best effort: fails with ENOSYS on kernels built without NUMA support */
+    syscall(SYS_set_mempolicy, MPOL_PREFERRED, node_mask, (unsigned long)(AWS_ARRAY_SIZE(node_mask) * bits_per_word));
+}
+
+static void s_add_cpu(size_t cpu, void *user_data) {
+    if (cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, (cpu_set_t *)user_data);
+    }
+}
+
+static int s_numa_node_cpus(uint16_t numa_node, cpu_set_t *cpus) {
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", (unsigned)numa_node);
+
+    char list[4096];
+    if (!aws_cpu_list_private_read_file(path, list, sizeof(list))) {
+        /* no NUMA information means one node holding every CPU */
+        return numa_node == 0 ? ENOENT : EINVAL;
+    }
+
+    return aws_cpu_list_private_parse(list, s_add_cpu, cpus) && CPU_COUNT(cpus) > 0 ? 0 : EINVAL;
+}
+
+/* Pins the thread from the moment it starts, rather than after it has already run somewhere else. */
+static int s_set_affinity(pthread_attr_t *attributes, const struct aws_thread_options *options) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+
+    if (options->cpu_affinity_count) {
+        for (size_t i = 0; i < options->cpu_affinity_count; ++i) {
+            if (options->cpu_affinity[i] >= CPU_SETSIZE) {
+                return EINVAL;
+            }
+            CPU_SET(options->cpu_affinity[i], &cpus);
+        }
+    } else if (options->prefer_numa_node) {
+        int err_code = s_numa_node_cpus(options->numa_node, &cpus);
+        if (err_code) {
+            return err_code == ENOENT ? 0 : err_code;
+        }
+    } else {
+        return 0;
+    }
+
+    return pthread_attr_setaffinity_np(attributes, sizeof(cpus), &cpus);
+}
+
+#else
+
+/* Maps priorities onto the range the current scheduling policy allows. */
+static void s_set_current_priority(enum aws_thread_priority priority) {
+    int policy = 0;
+    struct sched_param param;
+    if (pthread_getschedparam(pthread_self(), &policy, &param)) {
+        return;
+    }
+
+    int min = sched_get_priority_min(policy);
+    int max = sched_get_priority_max(policy);
+    int mid = param.sched_priority;
+    switch (priority) {
+        case AWS_THREAD_PRIORITY_LOWEST:
+            param.sched_priority = min;
+            break;
+        case AWS_THREAD_PRIORITY_LOW:
+            param.sched_priority = min + (mid - min) / 2;
+            break;
+        case AWS_THREAD_PRIORITY_HIGH:
+            param.sched_priority = mid + (max - mid) / 2;
+            break;
+        default:
+            param.sched_priority = max;
+            break;
+    }
+
+    pthread_setschedparam(pthread_self(), policy, &param);
+}
+
+static void s_set_current_numa_node(uint16_t numa_node) {
+    (void)numa_node;
+}
+
+static int s_set_affinity(pthread_attr_t *attributes, const struct aws_thread_options *options) {
+    (void)attributes;
+    (void)options;
+    return 0;
+}
+
+#endif
+
 static void *thread_fn(void *arg) {
     struct thread_wrapper wrapper = *(struct thread_wrapper *)arg;
     aws_mem_release(wrapper.allocator, arg);
 
+    if (wrapper.name[0]) {
+        s_set_current_name(wrapper.name);
+    }
+    if (wrapper.priority != AWS_THREAD_PRIORITY_DEFAULT) {
+        s_set_current_priority(wrapper.priority);
+    }
+    if (wrapper.prefer_numa_node) {
+        s_set_current_numa_node(wrapper.numa_node);
+    }
+
     wrapper.func(wrapper.arg);
     return NULL;
 }
@@ -89,6 +247,12 @@ int aws_thread_launch(
                 goto cleanup;
             }
         }
+
+        attr_return = s_set_affinity(attributes_ptr, options);
+
+        if (attr_return) {
+            goto cleanup;
+        }
     }
 
     struct thread_wrapper *wrapper =
@@ -99,12 +263,24 @@ int aws_thread_launch(
         goto cleanup;
     }
 
+    AWS_ZERO_STRUCT(*wrapper);
     wrapper->allocator = thread->allocator;
     wrapper->func = func;
     wrapper->arg = arg;
+
+    if (options) {
+        if (options->name) {
+            strncpy(wrapper->name, options->name, sizeof(wrapper->name) - 1);
+        }
+        wrapper->priority = options->priority;
+        wrapper->prefer_numa_node = options->prefer_numa_node;
+        wrapper->numa_node = options->numa_node;
+    }
+
     attr_return = pthread_create(&thread->thread_id, attributes_ptr, thread_fn, (void *)wrapper);
 
     if (attr_return) {
+        aws_mem_release(thread->allocator, wrapper);
         goto cleanup;
     }
 
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <aws/common/trace.h>
+
+#include <aws/common/thread.h>
+
+#include <aws/common/private/trace.h>
+
+#include <pthread.h>
+
+static pthread_key_t s_thread_ring_key;
+static bool s_thread_ring_key_created = false;
+static aws_thread_once s_thread_ring_key_init = AWS_THREAD_ONCE_STATIC_INIT;
+
+static void s_init_thread_ring_key(void) {
+    s_thread_ring_key_created = !pthread_key_create(&s_thread_ring_key, aws_trace_private_retire_thread_ring);
+}
+
+bool aws_trace_private_watch_thread_exit(void *ring) {
+    aws_thread_call_once(&s_thread_ring_key_init, s_init_thread_ring_key);
+
+    return s_thread_ring_key_created && !pthread_setspecific(s_thread_ring_key, ring);
+}
@@ -217,6 +217,50 @@ backpointer_update_failed:
     return AWS_OP_ERR;
 }
 
+int aws_priority_queue_push_batch(struct aws_priority_queue *queue, const void *items, size_t count) {
+    if (!count) {
+        return AWS_OP_SUCCESS;
+    }
+
+    size_t old_len = aws_array_list_length(&queue->container);
+    size_t new_len;
+    if (aws_add_size_checked(old_len, count, &new_len)) {
+        return AWS_OP_ERR;
+    }
+
+    /* Reserve everything up front so that a failure leaves the queue untouched */
+    if (aws_array_list_ensure_capacity(&queue->container, new_len - 1)) {
+        return AWS_OP_ERR;
+    }
+
+    if (queue->backpointers.data && aws_array_list_ensure_capacity(&queue->backpointers, new_len - 1)) {
+        return AWS_OP_ERR;
+    }
+
+    size_t item_size = queue->container.item_size;
+    memcpy((uint8_t *)queue->container.data + old_len * item_size, items, count * item_size);
+    queue->container.length = new_len;
+
+    if (queue->backpointers.data) {
+        size_t bp_size = sizeof(struct aws_priority_queue_node *);
+        memset((uint8_t *)queue->backpointers.data + old_len * bp_size, 0, count * bp_size);
+        queue->backpointers.length = new_len;
+    }
+
+    if (count >= old_len) {
+        /* Floyd's heap construction: O(n) for the whole array */
+        for (size_t i = new_len / 2; i-- > 0;) {
+            s_sift_down(queue, i);
+        }
+    } else {
+        for (size_t i = old_len; i < new_len; ++i) {
+            s_sift_up(queue, i);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
 static int s_remove_node(struct aws_priority_queue *queue, void *item, size_t item_index) {
     if (aws_array_list_get_at(&queue->container, item, item_index)) {
         /* shouldn't happen, but if it does we've already raised an error... */
@@ -264,6 +308,28 @@ int aws_priority_queue_pop(struct aws_priority_queue *queue, void *item) {
     return s_remove_node(queue, item, 0);
 }
 
+int aws_priority_queue_pop_up_to(struct aws_priority_queue *queue, const void *threshold, struct aws_array_list *out) {
+    assert(out->item_size == queue->container.item_size);
+
+    void *top = NULL;
+    while (aws_array_list_length(&queue->container)) {
+        aws_array_list_get_at_ptr(&queue->container, &top, 0);
+        if (queue->pred(top, threshold) > 0) {
+            break;
+        }
+
+        if (aws_array_list_push_back(out, top)) {
+            return AWS_OP_ERR;
+        }
+
+        void *slot = NULL;
+        aws_array_list_get_at_ptr(out, &slot, aws_array_list_length(out) - 1);
+        s_remove_node(queue, slot, 0);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
 int aws_priority_queue_top(const struct aws_priority_queue *queue, void **item) {
     if (0 == aws_array_list_length(&queue->container)) {
         return aws_raise_error(AWS_ERROR_PRIORITY_QUEUE_EMPTY);
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/prng.h>
+
+#include <aws/common/byte_buf.h>
+#include <aws/common/clock.h>
+#include <aws/common/device_random.h>
+
+#include <aws/common/private/device_random.h>
+
+static AWS_THREAD_LOCAL struct aws_prng tl_prng;
+static AWS_THREAD_LOCAL bool tl_prng_seeded = false;
+static AWS_THREAD_LOCAL size_t tl_prng_fork_generation = 0;
+
+/* splitmix64, as recommended by the xoshiro authors for expanding a single seed into a full state */
+static uint64_t s_splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void aws_prng_init_from_seed(struct aws_prng *prng, uint64_t seed) {
+    /* splitmix64 never yields four zero words in a row, the one state xoshiro can't leave */
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(prng->state); ++i) {
+        prng->state[i] = s_splitmix64(&seed);
+    }
+}
+
+int aws_prng_init(struct aws_prng *prng) {
+    uint64_t seed = 0;
+    if (aws_device_random_u64(&seed)) {
+        return AWS_OP_ERR;
+    }
+
+    aws_prng_init_from_seed(prng, seed);
+    return AWS_OP_SUCCESS;
+}
+
+struct aws_prng *aws_prng_thread_local(void) {
+    size_t fork_generation = aws_device_random_private_fork_generation();
+    if (AWS_UNLIKELY(!tl_prng_seeded || tl_prng_fork_generation != fork_generation)) {
+        if (aws_prng_init(&tl_prng)) {
+            /* this generator isn't for secrets, so a clock reading is an acceptable seed of last resort */
+            uint64_t now = 0;
+            aws_high_res_clock_get_ticks(&now);
+            aws_prng_init_from_seed(&tl_prng, now ^ (uint64_t)(uintptr_t)&tl_prng);
+        }
+        tl_prng_seeded = true;
+        /* read again: seeding is what registers for fork notifications */
+        tl_prng_fork_generation = aws_device_random_private_fork_generation();
+    }
+
+    return &tl_prng;
+}
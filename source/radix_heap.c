@@ -0,0 +1,174 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/radix_heap.h>
+
+#ifdef _MSC_VER
+/* for _BitScanForward64 and _BitScanReverse64 */
+#    include <intrin.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+static size_t s_highest_bit(uint64_t x) {
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return index;
+}
+
+static size_t s_lowest_bit(uint64_t x) {
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return index;
+}
+#elif defined(__GNUC__) || defined(__clang__)
+static size_t s_highest_bit(uint64_t x) {
+    return 63 - (size_t)__builtin_clzll(x);
+}
+
+static size_t s_lowest_bit(uint64_t x) {
+    return (size_t)__builtin_ctzll(x);
+}
+#else
+static size_t s_highest_bit(uint64_t x) {
+    size_t index = 0;
+    while (x >>= 1) {
+        ++index;
+    }
+    return index;
+}
+
+static size_t s_lowest_bit(uint64_t x) {
+    size_t index = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        ++index;
+    }
+    return index;
+}
+#endif
+
+/* Bucket 0 holds keys equal to last_key; bucket n holds keys whose highest bit differing from last_key is n - 1. */
+static size_t s_bucket_of(const struct aws_radix_heap *heap, uint64_t key) {
+    uint64_t diff = key ^ heap->last_key;
+    return diff ? s_highest_bit(diff) + 1 : 0;
+}
+
+static void s_insert(struct aws_radix_heap *heap, struct aws_radix_heap_node *node) {
+    size_t bucket = s_bucket_of(heap, node->key);
+    aws_linked_list_push_back(&heap->buckets[bucket], &node->node);
+    if (bucket) {
+        heap->occupied |= (uint64_t)1 << (bucket - 1);
+    }
+}
+
+/*
+ * Makes bucket 0 non-empty by advancing last_key to the smallest key in the lowest occupied bucket and redistributing
+ * that bucket. Every node moved lands in a strictly lower bucket, which is what bounds the amortized cost of a pop.
+ * Precondition: the heap is not empty.
+ */
+static void s_fill_bucket_zero(struct aws_radix_heap *heap) {
+    if (!aws_linked_list_empty(&heap->buckets[0])) {
+        return;
+    }
+
+    size_t bucket = s_lowest_bit(heap->occupied) + 1;
+    struct aws_linked_list *list = &heap->buckets[bucket];
+
+    uint64_t min_key = UINT64_MAX;
+    for (struct aws_linked_list_node *iter = aws_linked_list_begin(list); iter != aws_linked_list_end(list);
+         iter = aws_linked_list_next(iter)) {
+        struct aws_radix_heap_node *node = AWS_CONTAINER_OF(iter, struct aws_radix_heap_node, node);
+        if (node->key < min_key) {
+            min_key = node->key;
+        }
+    }
+
+    heap->last_key = min_key;
+    heap->occupied &= ~((uint64_t)1 << (bucket - 1));
+
+    while (!aws_linked_list_empty(list)) {
+        struct aws_linked_list_node *iter = aws_linked_list_pop_front(list);
+        s_insert(heap, AWS_CONTAINER_OF(iter, struct aws_radix_heap_node, node));
+    }
+}
+
+void aws_radix_heap_init(struct aws_radix_heap *heap, uint64_t min_key) {
+    for (size_t i = 0; i < AWS_RADIX_HEAP_BUCKET_COUNT; ++i) {
+        aws_linked_list_init(&heap->buckets[i]);
+    }
+
+    heap->occupied = 0;
+    heap->last_key = min_key;
+    heap->size = 0;
+}
+
+int aws_radix_heap_push(struct aws_radix_heap *heap, struct aws_radix_heap_node *node, uint64_t key) {
+    if (key < heap->last_key) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    node->key = key;
+    s_insert(heap, node);
+    heap->size++;
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_radix_heap_top(struct aws_radix_heap *heap, struct aws_radix_heap_node **node) {
+    if (!heap->size) {
+        return aws_raise_error(AWS_ERROR_PRIORITY_QUEUE_EMPTY);
+    }
+
+    s_fill_bucket_zero(heap);
+    *node = AWS_CONTAINER_OF(aws_linked_list_front(&heap->buckets[0]), struct aws_radix_heap_node, node);
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_radix_heap_pop(struct aws_radix_heap *heap, struct aws_radix_heap_node **node) {
+    if (!heap->size) {
+        return aws_raise_error(AWS_ERROR_PRIORITY_QUEUE_EMPTY);
+    }
+
+    s_fill_bucket_zero(heap);
+    struct aws_linked_list_node *front = aws_linked_list_pop_front(&heap->buckets[0]);
+    heap->size--;
+
+    *node = AWS_CONTAINER_OF(front, struct aws_radix_heap_node, node);
+    return AWS_OP_SUCCESS;
+}
+
+int aws_radix_heap_remove(struct aws_radix_heap *heap, struct aws_radix_heap_node *node) {
+    if (!node->node.next) {
+        return aws_raise_error(AWS_ERROR_PRIORITY_QUEUE_BAD_NODE);
+    }
+
+    size_t bucket = s_bucket_of(heap, node->key);
+    aws_linked_list_remove(&node->node);
+    if (bucket && aws_linked_list_empty(&heap->buckets[bucket])) {
+        heap->occupied &= ~((uint64_t)1 << (bucket - 1));
+    }
+    heap->size--;
+
+    return AWS_OP_SUCCESS;
+}
+
+size_t aws_radix_heap_size(const struct aws_radix_heap *heap) {
+    return heap->size;
+}
+
+uint64_t aws_radix_heap_min_key(const struct aws_radix_heap *heap) {
+    return heap->last_key;
+}
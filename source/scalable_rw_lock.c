@@ -0,0 +1,191 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/scalable_rw_lock.h>
+
+#include <aws/common/system_info.h>
+#include <aws/common/thread.h>
+
+struct aws_scalable_rw_lock_slot {
+    /* number of read locks held through this slot */
+    struct aws_atomic_var readers;
+    uint8_t padding[AWS_CACHE_LINE - sizeof(struct aws_atomic_var)];
+};
+
+/* Bounds on the number of reader slots; the actual count is twice the processor count, rounded up to a power of 2. */
+#define S_MIN_SLOTS 8
+#define S_MAX_SLOTS 512
+
+/* Pauses a writer issues between looks at a busy slot before it starts sleeping instead. */
+#define S_DRAIN_SPIN_LIMIT 1024
+#define S_DRAIN_SLEEP_NS 1000
+
+static AWS_THREAD_LOCAL bool tl_has_slot_hash = false;
+static AWS_THREAD_LOCAL size_t tl_slot_hash = 0;
+
+/* Every thread hashes to the same slot of every lock, so it keeps writing the same few cache lines. */
+static size_t s_current_slot_hash(void) {
+    if (AWS_UNLIKELY(!tl_has_slot_hash)) {
+        /* thread ids are often aligned addresses: mix the high bits down before masking */
+        uint64_t hash = aws_thread_current_thread_id();
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 33;
+        tl_slot_hash = (size_t)hash;
+        tl_has_slot_hash = true;
+    }
+
+    return tl_slot_hash;
+}
+
+static struct aws_scalable_rw_lock_slot *s_current_slot(struct aws_scalable_rw_lock *lock) {
+    return &lock->slots[s_current_slot_hash() & lock->slot_mask];
+}
+
+int aws_scalable_rw_lock_init(struct aws_scalable_rw_lock *lock, struct aws_allocator *allocator) {
+    AWS_ZERO_STRUCT(*lock);
+
+    size_t slot_count = S_MIN_SLOTS;
+    size_t wanted = aws_system_info_processor_count() * 2;
+    while (slot_count < wanted && slot_count < S_MAX_SLOTS) {
+        slot_count <<= 1;
+    }
+
+    /* over-allocate so the slots can start on a cache line boundary */
+    lock->slots_allocation =
+        aws_mem_acquire(allocator, slot_count * sizeof(struct aws_scalable_rw_lock_slot) + AWS_CACHE_LINE - 1);
+    if (!lock->slots_allocation) {
+        return AWS_OP_ERR;
+    }
+
+    uintptr_t aligned = ((uintptr_t)lock->slots_allocation + AWS_CACHE_LINE - 1) & ~(uintptr_t)(AWS_CACHE_LINE - 1);
+    lock->slots = (struct aws_scalable_rw_lock_slot *)aligned;
+    for (size_t i = 0; i < slot_count; ++i) {
+        aws_atomic_init_int(&lock->slots[i].readers, 0);
+    }
+
+    if (aws_mutex_init(&lock->writer_mutex)) {
+        aws_mem_release(allocator, lock->slots_allocation);
+        AWS_ZERO_STRUCT(*lock);
+        return AWS_OP_ERR;
+    }
+
+    lock->allocator = allocator;
+    lock->slot_mask = slot_count - 1;
+    aws_atomic_init_int(&lock->writer_active, 0);
+
+    return AWS_OP_SUCCESS;
+}
+
+void aws_scalable_rw_lock_clean_up(struct aws_scalable_rw_lock *lock) {
+    aws_mutex_clean_up(&lock->writer_mutex);
+    aws_mem_release(lock->allocator, lock->slots_allocation);
+    AWS_ZERO_STRUCT(*lock);
+}
+
+/*
+ * Readers increment their slot and then look for a writer; writers raise writer_active and then look at the slots.
+ * Both sides use sequentially consistent operations, so at least one of them sees the other and backs off.
+ */
+static bool s_try_enter_read(struct aws_scalable_rw_lock *lock, struct aws_scalable_rw_lock_slot *slot) {
+    if (aws_atomic_load_int_explicit(&lock->writer_active, aws_memory_order_relaxed)) {
+        return false;
+    }
+
+    aws_atomic_fetch_add_explicit(&slot->readers, 1, aws_memory_order_seq_cst);
+    if (AWS_LIKELY(!aws_atomic_load_int_explicit(&lock->writer_active, aws_memory_order_seq_cst))) {
+        return true;
+    }
+
+    aws_atomic_fetch_sub_explicit(&slot->readers, 1, aws_memory_order_release);
+    return false;
+}
+
+int aws_scalable_rw_lock_rlock(struct aws_scalable_rw_lock *lock) {
+    struct aws_scalable_rw_lock_slot *slot = s_current_slot(lock);
+
+    while (!s_try_enter_read(lock, slot)) {
+        /* a writer holds writer_mutex until it is done; sleep on it rather than spin */
+        if (aws_mutex_lock(&lock->writer_mutex)) {
+            return AWS_OP_ERR;
+        }
+        aws_mutex_unlock(&lock->writer_mutex);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_scalable_rw_lock_try_rlock(struct aws_scalable_rw_lock *lock) {
+    if (s_try_enter_read(lock, s_current_slot(lock))) {
+        return AWS_OP_SUCCESS;
+    }
+
+    return aws_raise_error(AWS_ERROR_MUTEX_TIMEOUT);
+}
+
+int aws_scalable_rw_lock_runlock(struct aws_scalable_rw_lock *lock) {
+    aws_atomic_fetch_sub_explicit(&s_current_slot(lock)->readers, 1, aws_memory_order_release);
+    return AWS_OP_SUCCESS;
+}
+
+static bool s_slot_is_empty(struct aws_scalable_rw_lock_slot *slot) {
+    return aws_atomic_load_int_explicit(&slot->readers, aws_memory_order_seq_cst) == 0;
+}
+
+int aws_scalable_rw_lock_wlock(struct aws_scalable_rw_lock *lock) {
+    if (aws_mutex_lock(&lock->writer_mutex)) {
+        return AWS_OP_ERR;
+    }
+
+    aws_atomic_store_int_explicit(&lock->writer_active, 1, aws_memory_order_seq_cst);
+
+    /* no new reader gets in now; wait for the ones already in to leave */
+    for (size_t i = 0; i <= lock->slot_mask; ++i) {
+        size_t spun = 0;
+        while (!s_slot_is_empty(&lock->slots[i])) {
+            if (spun < S_DRAIN_SPIN_LIMIT) {
+                aws_atomic_spin_hint();
+                ++spun;
+            } else {
+                aws_thread_current_sleep(S_DRAIN_SLEEP_NS);
+            }
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_scalable_rw_lock_try_wlock(struct aws_scalable_rw_lock *lock) {
+    if (aws_mutex_try_lock(&lock->writer_mutex)) {
+        return aws_raise_error(AWS_ERROR_MUTEX_TIMEOUT);
+    }
+
+    aws_atomic_store_int_explicit(&lock->writer_active, 1, aws_memory_order_seq_cst);
+
+    for (size_t i = 0; i <= lock->slot_mask; ++i) {
+        if (!s_slot_is_empty(&lock->slots[i])) {
+            aws_atomic_store_int_explicit(&lock->writer_active, 0, aws_memory_order_release);
+            aws_mutex_unlock(&lock->writer_mutex);
+            return aws_raise_error(AWS_ERROR_MUTEX_TIMEOUT);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_scalable_rw_lock_wunlock(struct aws_scalable_rw_lock *lock) {
+    aws_atomic_store_int_explicit(&lock->writer_active, 0, aws_memory_order_release);
+    return aws_mutex_unlock(&lock->writer_mutex);
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/seqlock.h>
+
+#include <string.h>
+
+int aws_seqlock_init(struct aws_seqlock *lock) {
+    aws_atomic_init_int(&lock->sequence, 0);
+    return aws_mutex_init(&lock->write_lock);
+}
+
+void aws_seqlock_clean_up(struct aws_seqlock *lock) {
+    aws_mutex_clean_up(&lock->write_lock);
+}
+
+int aws_seqlock_write_lock(struct aws_seqlock *lock) {
+    if (aws_mutex_lock(&lock->write_lock)) {
+        return AWS_OP_ERR;
+    }
+
+    /* only writers change the sequence, and they are serialized, so no read-modify-write is needed */
+    size_t sequence = aws_atomic_load_int_explicit(&lock->sequence, aws_memory_order_relaxed);
+    aws_atomic_store_int_explicit(&lock->sequence, sequence + 1, aws_memory_order_relaxed);
+    /* the odd sequence must be visible before any of the writes that follow */
+    aws_atomic_thread_fence(aws_memory_order_release);
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_seqlock_write_unlock(struct aws_seqlock *lock) {
+    size_t sequence = aws_atomic_load_int_explicit(&lock->sequence, aws_memory_order_relaxed);
+    aws_atomic_store_int_explicit(&lock->sequence, sequence + 1, aws_memory_order_release);
+
+    return aws_mutex_unlock(&lock->write_lock);
+}
+
+void aws_seqlock_read_copy(const struct aws_seqlock *lock, void *dest, const void *src, size_t size) {
+    size_t sequence;
+    do {
+        sequence = aws_seqlock_read_begin(lock);
+        memcpy(dest, src, size);
+    } while (aws_seqlock_read_retry(lock, sequence));
+}
+
+int aws_seqlock_write_copy(struct aws_seqlock *lock, void *dest, const void *src, size_t size) {
+    if (aws_seqlock_write_lock(lock)) {
+        return AWS_OP_ERR;
+    }
+
+    memcpy(dest, src, size);
+
+    return aws_seqlock_write_unlock(lock);
+}
@@ -48,11 +48,10 @@ void aws_string_destroy(struct aws_string *str) {
 }
 
 void aws_string_destroy_secure(struct aws_string *str) {
-    if (str) {
+    /* strings without an allocator are static or owned by a string pool, and may be shared */
+    if (str && str->allocator) {
         aws_secure_zero((void *)aws_string_bytes(str), str->len);
-        if (str->allocator) {
-            aws_mem_release(str->allocator, str);
-        }
+        aws_mem_release(str->allocator, str);
     }
 }
 
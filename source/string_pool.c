@@ -0,0 +1,207 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <aws/common/string_pool.h>
+
+#include <assert.h>
+
+/* ref_count value marking a string that lives as long as the pool */
+#define S_IMMORTAL_REF_COUNT SIZE_MAX
+
+/* Hash table key: the bytes, and their hash computed once per intern. */
+struct pool_key {
+    struct aws_byte_cursor cursor;
+    uint64_t hash;
+};
+
+/*
+ * Every interned string is allocated as one block: this header, immediately
+ * followed by the aws_string and its bytes. The header holds only pointers,
+ * size_ts and a uint64_t, so its size keeps the aws_string that follows
+ * suitably aligned.
+ */
+struct string_pool_entry {
+    /* points at the bytes of the string that follows; this is the hash table key */
+    struct pool_key key;
+    size_t ref_count;
+};
+
+static struct aws_string *s_entry_string(struct string_pool_entry *entry) {
+    return (struct aws_string *)((uint8_t *)entry + sizeof(struct string_pool_entry));
+}
+
+static struct string_pool_entry *s_string_entry(const struct aws_string *str) {
+    return (struct string_pool_entry *)((uint8_t *)str - sizeof(struct string_pool_entry));
+}
+
+static uint64_t s_pool_key_hash(const void *item) {
+    return ((const struct pool_key *)item)->hash;
+}
+
+static bool s_pool_key_eq(const void *a, const void *b) {
+    return aws_byte_cursor_eq(&((const struct pool_key *)a)->cursor, &((const struct pool_key *)b)->cursor);
+}
+
+static struct string_pool_entry *s_entry_new(struct aws_allocator *allocator, const struct pool_key *lookup) {
+    struct aws_byte_cursor cursor = lookup->cursor;
+    size_t malloc_size;
+    size_t header_size = sizeof(struct string_pool_entry) + sizeof(struct aws_string) + 1;
+    if (aws_add_size_checked(header_size, cursor.len, &malloc_size)) {
+        return NULL;
+    }
+    struct string_pool_entry *entry = aws_mem_acquire(allocator, malloc_size);
+    if (!entry) {
+        return NULL;
+    }
+
+    struct aws_string *str = s_entry_string(entry);
+
+    /* A NULL allocator makes aws_string_destroy() a no-op on interned strings */
+    *(struct aws_allocator **)(&str->allocator) = NULL;
+    *(size_t *)(&str->len) = cursor.len;
+    if (cursor.len) {
+        memcpy((void *)str->bytes, cursor.ptr, cursor.len);
+    }
+    *(uint8_t *)&str->bytes[cursor.len] = '\0';
+
+    entry->key.cursor = aws_byte_cursor_from_array(str->bytes, cursor.len);
+    entry->key.hash = lookup->hash;
+    entry->ref_count = 0;
+
+    return entry;
+}
+
+int aws_string_pool_init(struct aws_string_pool *pool, struct aws_allocator *allocator, size_t initial_size) {
+    assert(allocator);
+
+    pool->allocator = allocator;
+    if (aws_mutex_init(&pool->lock)) {
+        return AWS_OP_ERR;
+    }
+
+    if (aws_hash_table_init(
+            &pool->table, allocator, initial_size, s_pool_key_hash, s_pool_key_eq, NULL, NULL)) {
+        aws_mutex_clean_up(&pool->lock);
+        return AWS_OP_ERR;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+void aws_string_pool_clean_up(struct aws_string_pool *pool) {
+    for (struct aws_hash_iter iter = aws_hash_iter_begin(&pool->table); !aws_hash_iter_done(&iter);
+         aws_hash_iter_next(&iter)) {
+        aws_mem_release(pool->allocator, iter.element.value);
+    }
+
+    aws_hash_table_clean_up(&pool->table);
+    aws_mutex_clean_up(&pool->lock);
+    AWS_ZERO_STRUCT(*pool);
+}
+
+static const struct aws_string *s_intern(struct aws_string_pool *pool, struct aws_byte_cursor cursor, bool immortal) {
+    const struct aws_string *result = NULL;
+
+    /* hashed outside the lock; the same hash serves the table and aws_hash_interned_string() */
+    struct pool_key lookup;
+    lookup.cursor = cursor;
+    lookup.hash = aws_hash_byte_cursor_ptr(&cursor);
+
+    aws_mutex_lock(&pool->lock);
+
+    struct aws_hash_element *elem = NULL;
+    aws_hash_table_find(&pool->table, &lookup, &elem);
+
+    struct string_pool_entry *entry = elem ? elem->value : NULL;
+    if (!entry) {
+        entry = s_entry_new(pool->allocator, &lookup);
+        if (!entry) {
+            goto done;
+        }
+
+        if (aws_hash_table_put(&pool->table, &entry->key, entry, NULL)) {
+            aws_mem_release(pool->allocator, entry);
+            goto done;
+        }
+    }
+
+    if (immortal) {
+        entry->ref_count = S_IMMORTAL_REF_COUNT;
+    } else if (entry->ref_count != S_IMMORTAL_REF_COUNT) {
+        entry->ref_count++;
+    }
+
+    result = s_entry_string(entry);
+
+done:
+    aws_mutex_unlock(&pool->lock);
+    return result;
+}
+
+const struct aws_string *aws_string_pool_intern(struct aws_string_pool *pool, struct aws_byte_cursor cursor) {
+    return s_intern(pool, cursor, false);
+}
+
+const struct aws_string *aws_string_pool_intern_c_str(struct aws_string_pool *pool, const char *c_str) {
+    return s_intern(pool, aws_byte_cursor_from_c_str(c_str), false);
+}
+
+const struct aws_string *aws_string_pool_intern_immortal(struct aws_string_pool *pool, struct aws_byte_cursor cursor) {
+    return s_intern(pool, cursor, true);
+}
+
+const struct aws_string *aws_string_pool_acquire(struct aws_string_pool *pool, const struct aws_string *str) {
+    struct string_pool_entry *entry = s_string_entry(str);
+
+    aws_mutex_lock(&pool->lock);
+    assert(entry->ref_count > 0);
+    if (entry->ref_count != S_IMMORTAL_REF_COUNT) {
+        entry->ref_count++;
+    }
+    aws_mutex_unlock(&pool->lock);
+
+    return str;
+}
+
+void aws_string_pool_release(struct aws_string_pool *pool, const struct aws_string *str) {
+    if (!str) {
+        return;
+    }
+
+    struct string_pool_entry *entry = s_string_entry(str);
+
+    aws_mutex_lock(&pool->lock);
+    assert(entry->ref_count > 0);
+    if (entry->ref_count != S_IMMORTAL_REF_COUNT && --entry->ref_count == 0) {
+        aws_hash_table_remove(&pool->table, &entry->key, NULL, NULL);
+        aws_mem_release(pool->allocator, entry);
+    }
+    aws_mutex_unlock(&pool->lock);
+}
+
+size_t aws_string_pool_get_entry_count(struct aws_string_pool *pool) {
+    aws_mutex_lock(&pool->lock);
+    size_t count = aws_hash_table_get_entry_count(&pool->table);
+    aws_mutex_unlock(&pool->lock);
+
+    return count;
+}
+
+uint64_t aws_hash_interned_string(const void *item) {
+    return s_string_entry(item)->key.hash;
+}
+
+bool aws_hash_callback_interned_string_eq(const void *a, const void *b) {
+    return a == b;
+}
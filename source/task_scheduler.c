@@ -15,6 +15,8 @@
 
 #include <aws/common/task_scheduler.h>
 
+#include <aws/common/trace.h>
+
 #include <assert.h>
 
 static const size_t DEFAULT_QUEUE_SIZE = 7;
@@ -191,7 +193,11 @@ static void s_run_all(struct aws_task_scheduler *scheduler, uint64_t current_tim
     while (!aws_linked_list_empty(&running_list)) {
         struct aws_linked_list_node *task_node = aws_linked_list_pop_front(&running_list);
         struct aws_task *task = AWS_CONTAINER_OF(task_node, struct aws_task, node);
+        /* the task may free itself, so only its address is recorded */
+        uintptr_t task_address = (uintptr_t)task;
+        AWS_TRACE_EVENT(AWS_TRACE_EVENT_TASK_RUN_BEGIN, task_address, status);
         aws_task_run(task, status);
+        AWS_TRACE_EVENT(AWS_TRACE_EVENT_TASK_RUN_END, task_address, status);
     }
 }
 
@@ -0,0 +1,504 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/trace.h>
+
+#include <aws/common/clock.h>
+#include <aws/common/linked_list.h>
+#include <aws/common/mutex.h>
+#include <aws/common/thread.h>
+
+#include <aws/common/private/trace.h>
+
+#include <stdio.h>
+#include <string.h>
+
+struct aws_atomic_var aws_trace_private_enabled = AWS_ATOMIC_INIT_INT(0);
+struct aws_atomic_var aws_trace_private_allocations_enabled = AWS_ATOMIC_INIT_INT(0);
+
+/* One thread's events. Only the owning thread writes events and sequence. */
+struct trace_ring {
+    struct aws_linked_list_node node;
+    uint64_t thread_id;
+    size_t mask;
+    /*
+     * Twice the number of events recorded, plus one while the next is being written. Event i lives in
+     * events[i & mask] until event i + mask + 1 replaces it.
+     */
+    struct aws_atomic_var sequence;
+    /* events before this index were discarded by aws_trace_clear() */
+    struct aws_atomic_var discard_before;
+    struct aws_trace_event events[];
+};
+
+struct trace_event_info {
+    char name[AWS_TRACE_MAX_EVENT_NAME_LEN + 1];
+    enum aws_trace_phase phase;
+};
+
+/* Guards everything below except s_generation. */
+static struct aws_mutex s_lock = AWS_MUTEX_INIT;
+static struct aws_allocator *s_allocator;
+static size_t s_ring_capacity;
+static uint64_t s_base_ticks;
+/* rings of running threads */
+static struct aws_linked_list s_rings;
+/* rings of exited threads not dumped yet, oldest first */
+static struct aws_linked_list s_retired_rings;
+/* rings of exited threads already dumped, handed to the next threads that need one */
+static struct aws_linked_list s_spare_rings;
+/* s_retired_rings and s_spare_rings together never hold more than AWS_TRACE_MAX_RETIRED_RINGS rings */
+static size_t s_retired_count;
+static size_t s_spare_count;
+static struct trace_event_info s_events[AWS_TRACE_MAX_EVENTS];
+
+/* Bumped by init and clean up, so that threads notice their ring is gone. */
+static struct aws_atomic_var s_generation = AWS_ATOMIC_INIT_INT(0);
+
+static AWS_THREAD_LOCAL struct trace_ring *tl_ring;
+static AWS_THREAD_LOCAL size_t tl_generation;
+/*
+ * Set while this thread holds s_lock. Allocations made under it are traced too, and must not try to attach a ring,
+ * which takes s_lock again.
+ */
+static AWS_THREAD_LOCAL bool tl_holds_lock;
+
+static void s_lock_rings(void) {
+    aws_mutex_lock(&s_lock);
+    tl_holds_lock = true;
+}
+
+static void s_unlock_rings(void) {
+    tl_holds_lock = false;
+    aws_mutex_unlock(&s_lock);
+}
+
+/* Longest line written for one event: the fixed text, a name and five 20-digit numbers. */
+#define S_MAX_EVENT_JSON_LEN (128 + AWS_TRACE_MAX_EVENT_NAME_LEN + 5 * 20)
+
+static void s_register_common_events(void) {
+    static const struct {
+        enum aws_trace_common_event id;
+        const char *name;
+        enum aws_trace_phase phase;
+    } common_events[] = {
+        {AWS_TRACE_EVENT_TASK_RUN_BEGIN, "task_run", AWS_TRACE_PHASE_BEGIN},
+        {AWS_TRACE_EVENT_TASK_RUN_END, "task_run", AWS_TRACE_PHASE_END},
+        {AWS_TRACE_EVENT_LOCK_WAIT, "lock_wait", AWS_TRACE_PHASE_INSTANT},
+        {AWS_TRACE_EVENT_MEM_ACQUIRE, "mem_acquire", AWS_TRACE_PHASE_INSTANT},
+        {AWS_TRACE_EVENT_MEM_RELEASE, "mem_release", AWS_TRACE_PHASE_INSTANT},
+    };
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(common_events); ++i) {
+        struct trace_event_info *info = &s_events[common_events[i].id];
+        strcpy(info->name, common_events[i].name);
+        info->phase = common_events[i].phase;
+    }
+}
+
+int aws_trace_init(struct aws_allocator *allocator, size_t events_per_thread) {
+    if (!events_per_thread || events_per_thread > SIZE_MAX / 2 / sizeof(struct aws_trace_event)) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    size_t capacity = 1;
+    while (capacity < events_per_thread) {
+        capacity <<= 1;
+    }
+
+    s_lock_rings();
+    if (s_allocator) {
+        s_unlock_rings();
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    s_allocator = allocator;
+    s_ring_capacity = capacity;
+    s_base_ticks = aws_fast_clock_get_ticks();
+    aws_linked_list_init(&s_rings);
+    aws_linked_list_init(&s_retired_rings);
+    aws_linked_list_init(&s_spare_rings);
+    s_retired_count = 0;
+    s_spare_count = 0;
+    AWS_ZERO_ARRAY(s_events);
+    s_register_common_events();
+    aws_atomic_fetch_add(&s_generation, 1);
+    s_unlock_rings();
+
+    return AWS_OP_SUCCESS;
+}
+
+/* Must hold s_lock. */
+static void s_release_rings(struct aws_linked_list *rings) {
+    while (!aws_linked_list_empty(rings)) {
+        struct aws_linked_list_node *node = aws_linked_list_pop_front(rings);
+        aws_mem_release(s_allocator, AWS_CONTAINER_OF(node, struct trace_ring, node));
+    }
+}
+
+void aws_trace_clean_up(void) {
+    aws_trace_set_enabled(false);
+
+    s_lock_rings();
+    if (s_allocator) {
+        s_release_rings(&s_rings);
+        s_release_rings(&s_retired_rings);
+        s_release_rings(&s_spare_rings);
+        s_allocator = NULL;
+        aws_atomic_fetch_add(&s_generation, 1);
+    }
+    s_unlock_rings();
+}
+
+void aws_trace_set_enabled(bool enabled) {
+    aws_atomic_store_int(&aws_trace_private_enabled, enabled ? 1 : 0);
+}
+
+void aws_trace_set_allocations_enabled(bool enabled) {
+    aws_atomic_store_int(&aws_trace_private_allocations_enabled, enabled ? 1 : 0);
+}
+
+int aws_trace_register_event(uint32_t event_id, const char *name, enum aws_trace_phase phase) {
+    size_t name_len = strlen(name);
+    if (event_id >= AWS_TRACE_MAX_EVENTS || name_len == 0 || name_len > AWS_TRACE_MAX_EVENT_NAME_LEN) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+    /* names are written to the JSON as is */
+    for (size_t i = 0; i < name_len; ++i) {
+        if (name[i] == '"' || name[i] == '\\' || (unsigned char)name[i] < 0x20) {
+            return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        }
+    }
+
+    s_lock_rings();
+    if (!s_allocator) {
+        s_unlock_rings();
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+    memcpy(s_events[event_id].name, name, name_len + 1);
+    s_events[event_id].phase = phase;
+    s_unlock_rings();
+
+    return AWS_OP_SUCCESS;
+}
+
+/* Gives the calling thread a ring in the current generation, or returns NULL if tracing isn't initialized. */
+static struct trace_ring *s_attach_ring(void) {
+    struct trace_ring *ring = NULL;
+
+    s_lock_rings();
+    if (s_allocator) {
+        if (!aws_linked_list_empty(&s_spare_rings)) {
+            ring = AWS_CONTAINER_OF(aws_linked_list_pop_front(&s_spare_rings), struct trace_ring, node);
+            --s_spare_count;
+        } else {
+            size_t size = sizeof(struct trace_ring) + s_ring_capacity * sizeof(struct aws_trace_event);
+            ring = aws_mem_acquire(s_allocator, size);
+        }
+        if (ring) {
+            ring->thread_id = aws_thread_current_thread_id();
+            ring->mask = s_ring_capacity - 1;
+            aws_atomic_init_int(&ring->sequence, 0);
+            aws_atomic_init_int(&ring->discard_before, 0);
+            aws_linked_list_push_back(&s_rings, &ring->node);
+            /* without the hook the ring simply stays with the running threads until aws_trace_clean_up() */
+            aws_trace_private_watch_thread_exit(ring);
+        }
+    }
+    tl_ring = ring;
+    tl_generation = aws_atomic_load_int(&s_generation);
+    s_unlock_rings();
+
+    return ring;
+}
+
+void aws_trace_private_retire_thread_ring(void *ring) {
+    if (tl_ring == ring) {
+        tl_ring = NULL;
+    }
+
+    s_lock_rings();
+    if (s_allocator) {
+        /*
+         * ring may be left over from before a clean up, its memory since reused for another thread's ring, so it is
+         * only trusted if a running thread still has it and that thread is this one
+         */
+        for (struct aws_linked_list_node *node = aws_linked_list_begin(&s_rings); node != aws_linked_list_end(&s_rings);
+             node = aws_linked_list_next(node)) {
+            struct trace_ring *candidate = AWS_CONTAINER_OF(node, struct trace_ring, node);
+            if (candidate == ring) {
+                if (candidate->thread_id == aws_thread_current_thread_id()) {
+                    aws_linked_list_remove(node);
+                    aws_linked_list_push_back(&s_retired_rings, node);
+                    ++s_retired_count;
+                }
+                break;
+            }
+        }
+
+        /* over the limit, spare rings go first, then the oldest undumped ones */
+        while (s_retired_count + s_spare_count > AWS_TRACE_MAX_RETIRED_RINGS) {
+            struct aws_linked_list_node *node = NULL;
+            if (s_spare_count) {
+                node = aws_linked_list_pop_front(&s_spare_rings);
+                --s_spare_count;
+            } else {
+                node = aws_linked_list_pop_front(&s_retired_rings);
+                --s_retired_count;
+            }
+            aws_mem_release(s_allocator, AWS_CONTAINER_OF(node, struct trace_ring, node));
+        }
+    }
+    s_unlock_rings();
+}
+
+void aws_trace_record(uint32_t event_id, uint64_t arg0, uint64_t arg1) {
+    if (event_id >= AWS_TRACE_MAX_EVENTS) {
+        return;
+    }
+
+    struct trace_ring *ring = tl_ring;
+    if (AWS_UNLIKELY(!ring || tl_generation != aws_atomic_load_int_explicit(&s_generation, aws_memory_order_relaxed))) {
+        if (tl_holds_lock) {
+            return;
+        }
+        ring = s_attach_ring();
+        if (!ring) {
+            return;
+        }
+    }
+
+    size_t sequence = aws_atomic_load_int_explicit(&ring->sequence, aws_memory_order_relaxed);
+    aws_atomic_store_int_explicit(&ring->sequence, sequence + 1, aws_memory_order_relaxed);
+    /* the odd sequence must be visible before this event starts overwriting an old one; see s_snapshot() */
+    aws_atomic_thread_fence(aws_memory_order_release);
+
+    struct aws_trace_event *event = &ring->events[(sequence >> 1) & ring->mask];
+    event->timestamp = aws_fast_clock_get_ticks();
+    event->arg0 = arg0;
+    event->arg1 = arg1;
+    event->event_id = event_id;
+    event->reserved = 0;
+
+    aws_atomic_store_int_explicit(&ring->sequence, sequence + 2, aws_memory_order_release);
+}
+
+/*
+ * Copies up to max_events of the newest events in ring, oldest first, and returns how many were copied. Safe against
+ * the owning thread recording concurrently: like a seqlock reader, it copies optimistically and then drops whatever the
+ * writer may have overwritten while it was copying.
+ */
+static size_t s_snapshot(struct trace_ring *ring, struct aws_trace_event *events, size_t max_events) {
+    size_t capacity = ring->mask + 1;
+    /* events before head are complete */
+    size_t head = aws_atomic_load_int_explicit(&ring->sequence, aws_memory_order_acquire) >> 1;
+    size_t start = aws_atomic_load_int(&ring->discard_before);
+
+    /* a clear during the event in progress discards it too */
+    if (start >= head) {
+        return 0;
+    }
+    if (head - start > capacity) {
+        start = head > capacity ? head - capacity : 0;
+    }
+    if (head - start > max_events) {
+        start = head - max_events;
+    }
+
+    for (size_t i = start; i < head; ++i) {
+        events[i - start] = ring->events[i & ring->mask];
+    }
+
+    /* keeps the event reads from moving below the second read of the sequence */
+    aws_atomic_thread_fence(aws_memory_order_acquire);
+    size_t sequence = aws_atomic_load_int_explicit(&ring->sequence, aws_memory_order_relaxed);
+
+    /* events written or being written since the first read have replaced the oldest ones */
+    size_t end = (sequence + 1) >> 1;
+    size_t first_intact = end > capacity ? end - capacity : 0;
+    if (first_intact <= start) {
+        return head - start;
+    }
+    if (first_intact >= head) {
+        return 0;
+    }
+
+    size_t dropped = first_intact - start;
+    memmove(events, events + dropped, (head - first_intact) * sizeof(struct aws_trace_event));
+    return head - first_intact;
+}
+
+size_t aws_trace_get_thread_events(struct aws_trace_event *events, size_t max_events) {
+    struct trace_ring *ring = tl_ring;
+    if (!ring || tl_generation != aws_atomic_load_int(&s_generation)) {
+        return 0;
+    }
+
+    return s_snapshot(ring, events, max_events);
+}
+
+/* Must hold s_lock. */
+static void s_clear_rings(struct aws_linked_list *rings) {
+    for (struct aws_linked_list_node *node = aws_linked_list_begin(rings); node != aws_linked_list_end(rings);
+         node = aws_linked_list_next(node)) {
+        struct trace_ring *ring = AWS_CONTAINER_OF(node, struct trace_ring, node);
+        size_t sequence = aws_atomic_load_int(&ring->sequence);
+        /* an event being written now counts as recorded before the clear */
+        aws_atomic_store_int(&ring->discard_before, (sequence + 1) >> 1);
+    }
+}
+
+void aws_trace_clear(void) {
+    s_lock_rings();
+    if (s_allocator) {
+        s_clear_rings(&s_rings);
+        s_clear_rings(&s_retired_rings);
+    }
+    s_unlock_rings();
+}
+
+/* Appends len bytes to output, doubling its capacity as needed. */
+static int s_append(struct aws_byte_buf *output, const char *bytes, size_t len) {
+    if (output->capacity - output->len < len) {
+        size_t new_capacity = output->capacity;
+        while (new_capacity - output->len < len) {
+            if (aws_mul_size_checked(new_capacity, 2, &new_capacity)) {
+                return AWS_OP_ERR;
+            }
+        }
+        void *buffer = output->buffer;
+        if (aws_mem_realloc(output->allocator, &buffer, output->capacity, new_capacity)) {
+            return AWS_OP_ERR;
+        }
+        output->buffer = buffer;
+        output->capacity = new_capacity;
+    }
+
+    memcpy(output->buffer + output->len, bytes, len);
+    output->len += len;
+    return AWS_OP_SUCCESS;
+}
+
+static const char s_phase_chars[] = {
+    [AWS_TRACE_PHASE_INSTANT] = 'i',
+    [AWS_TRACE_PHASE_BEGIN] = 'B',
+    [AWS_TRACE_PHASE_END] = 'E',
+    [AWS_TRACE_PHASE_COUNTER] = 'C',
+};
+
+/* Must hold s_lock. */
+static int s_write_event(struct aws_byte_buf *output, const struct aws_trace_event *event, uint64_t tid, bool first) {
+    char unnamed[32];
+    const char *name = s_events[event->event_id].name;
+    enum aws_trace_phase phase = s_events[event->event_id].phase;
+    if (!name[0]) {
+        snprintf(unnamed, sizeof(unnamed), "event_%u", (unsigned)event->event_id);
+        name = unnamed;
+        phase = AWS_TRACE_PHASE_INSTANT;
+    }
+
+    /* events recorded before init can't exist, but a stale tick reading would wrap */
+    uint64_t ticks = event->timestamp > s_base_ticks ? event->timestamp - s_base_ticks : 0;
+    uint64_t ns = aws_fast_clock_ticks_to_ns(ticks);
+
+    char line[S_MAX_EVENT_JSON_LEN];
+    int len = snprintf(
+        line,
+        sizeof(line),
+        "%s{\"name\":\"%s\",\"cat\":\"aws\",\"ph\":\"%c\",%s\"ts\":%llu.%03u,\"pid\":0,\"tid\":%llu,"
+        "\"args\":{\"arg0\":%llu,\"arg1\":%llu}}",
+        first ? "\n" : ",\n",
+        name,
+        s_phase_chars[phase],
+        phase == AWS_TRACE_PHASE_INSTANT ? "\"s\":\"t\"," : "",
+        (unsigned long long)(ns / 1000),
+        (unsigned)(ns % 1000),
+        (unsigned long long)tid,
+        (unsigned long long)event->arg0,
+        (unsigned long long)event->arg1);
+
+    return s_append(output, line, (size_t)len);
+}
+
+/* Must hold s_lock. */
+static int s_write_ring_events(
+    struct aws_byte_buf *output,
+    struct aws_linked_list *rings,
+    struct aws_trace_event *events,
+    bool *first) {
+
+    for (struct aws_linked_list_node *node = aws_linked_list_begin(rings); node != aws_linked_list_end(rings);
+         node = aws_linked_list_next(node)) {
+        struct trace_ring *ring = AWS_CONTAINER_OF(node, struct trace_ring, node);
+        size_t count = s_snapshot(ring, events, s_ring_capacity);
+        for (size_t i = 0; i < count; ++i) {
+            if (s_write_event(output, &events[i], ring->thread_id, *first)) {
+                return AWS_OP_ERR;
+            }
+            *first = false;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_trace_dump_json(struct aws_byte_buf *output, struct aws_allocator *allocator) {
+    if (aws_byte_buf_init(output, allocator, 4096)) {
+        return AWS_OP_ERR;
+    }
+
+    static const char header[] = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    static const char footer[] = "\n]}\n";
+    if (s_append(output, header, sizeof(header) - 1)) {
+        goto error;
+    }
+
+    s_lock_rings();
+    if (s_allocator) {
+        struct aws_trace_event *events = aws_mem_acquire(allocator, s_ring_capacity * sizeof(struct aws_trace_event));
+        if (!events) {
+            s_unlock_rings();
+            goto error;
+        }
+
+        bool first = true;
+        if (s_write_ring_events(output, &s_rings, events, &first) ||
+            s_write_ring_events(output, &s_retired_rings, events, &first)) {
+            aws_mem_release(allocator, events);
+            s_unlock_rings();
+            goto error;
+        }
+
+        /* exited threads' events have now been dumped once: their rings can go to new threads */
+        while (!aws_linked_list_empty(&s_retired_rings)) {
+            aws_linked_list_push_back(&s_spare_rings, aws_linked_list_pop_front(&s_retired_rings));
+        }
+        s_spare_count += s_retired_count;
+        s_retired_count = 0;
+
+        aws_mem_release(allocator, events);
+    }
+    s_unlock_rings();
+
+    if (s_append(output, footer, sizeof(footer) - 1)) {
+        goto error;
+    }
+
+    return AWS_OP_SUCCESS;
+
+error:
+    aws_byte_buf_clean_up(output);
+    return AWS_OP_ERR;
+}
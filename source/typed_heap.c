@@ -0,0 +1,100 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/typed_heap.h>
+
+#include <aws/common/math.h>
+
+#define S_MIN_GROWTH_CAPACITY 16
+
+int aws_typed_heap_private_reserve(
+    struct aws_allocator *alloc,
+    void **items,
+    struct aws_priority_queue_node ***backpointers,
+    size_t item_size,
+    size_t *capacity,
+    size_t min_capacity) {
+
+    size_t old_capacity = *capacity;
+    if (min_capacity <= old_capacity) {
+        return AWS_OP_SUCCESS;
+    }
+
+    size_t new_capacity = min_capacity;
+    if (old_capacity) {
+        /* grow geometrically so that a sequence of pushes is amortized O(1) in allocation work */
+        size_t doubled;
+        if (!aws_mul_size_checked(old_capacity, 2, &doubled) && doubled > new_capacity) {
+            new_capacity = doubled;
+        }
+    } else if (new_capacity < S_MIN_GROWTH_CAPACITY) {
+        new_capacity = S_MIN_GROWTH_CAPACITY;
+    }
+
+    size_t old_size = old_capacity * item_size;
+    size_t new_size;
+    if (aws_mul_size_checked(new_capacity, item_size, &new_size)) {
+        return AWS_OP_ERR;
+    }
+
+    size_t old_bp_size = old_capacity * sizeof(struct aws_priority_queue_node *);
+    size_t new_bp_size = 0;
+    bool grow_backpointers = backpointers && *backpointers;
+    if (grow_backpointers &&
+        aws_mul_size_checked(new_capacity, sizeof(struct aws_priority_queue_node *), &new_bp_size)) {
+        return AWS_OP_ERR;
+    }
+
+    /* Grow the backpointers first: if growing items then fails, the larger backpointer array is harmless. */
+    if (grow_backpointers) {
+        if (aws_mem_realloc(alloc, (void **)backpointers, old_bp_size, new_bp_size)) {
+            return AWS_OP_ERR;
+        }
+        memset((uint8_t *)*backpointers + old_bp_size, 0, new_bp_size - old_bp_size);
+    }
+
+    if (*items) {
+        if (aws_mem_realloc(alloc, items, old_size, new_size)) {
+            return AWS_OP_ERR;
+        }
+    } else {
+        *items = aws_mem_acquire(alloc, new_size);
+        if (!*items) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    *capacity = new_capacity;
+    return AWS_OP_SUCCESS;
+}
+
+int aws_typed_heap_private_init_backpointers(
+    struct aws_allocator *alloc,
+    struct aws_priority_queue_node ***backpointers,
+    size_t capacity) {
+
+    size_t size;
+    if (aws_mul_size_checked(capacity, sizeof(struct aws_priority_queue_node *), &size)) {
+        return AWS_OP_ERR;
+    }
+
+    *backpointers = aws_mem_acquire(alloc, size);
+    if (!*backpointers) {
+        return AWS_OP_ERR;
+    }
+
+    memset(*backpointers, 0, size);
+    return AWS_OP_SUCCESS;
+}
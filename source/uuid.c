@@ -15,95 +15,113 @@
 #include <aws/common/uuid.h>
 
 #include <aws/common/byte_buf.h>
+#include <aws/common/clock.h>
 #include <aws/common/device_random.h>
+#include <aws/common/hash_table.h>
+#include <aws/common/math.h>
+#include <aws/common/mutex.h>
 
-#include <inttypes.h>
-#include <stdio.h>
+#include <aws/common/private/hex.h>
 
-#define HEX_CHAR_FMT "%02" SCNx8
+/* The 8-4-4-4-12 groups of a UUID string, as offsets into the string and into uuid_data. */
+static const struct {
+    uint8_t str_offset;
+    uint8_t data_offset;
+    uint8_t len;
+} s_uuid_groups[] = {
+    {0, 0, 4},
+    {9, 4, 2},
+    {14, 6, 2},
+    {19, 8, 2},
+    {24, 10, 6},
+};
 
-#define UUID_FORMAT                                                                                                    \
-    HEX_CHAR_FMT HEX_CHAR_FMT HEX_CHAR_FMT HEX_CHAR_FMT                                                                \
-        "-" HEX_CHAR_FMT HEX_CHAR_FMT "-" HEX_CHAR_FMT HEX_CHAR_FMT "-" HEX_CHAR_FMT HEX_CHAR_FMT                      \
-        "-" HEX_CHAR_FMT HEX_CHAR_FMT HEX_CHAR_FMT HEX_CHAR_FMT HEX_CHAR_FMT HEX_CHAR_FMT
-
-#include <stdio.h>
-
-#ifdef _MSC_VER
-/* disables warning non const declared initializers for Microsoft compilers */
-#    pragma warning(disable : 4204)
-#    pragma warning(disable : 4706)
-/* sprintf warning (we already check the bounds in this case). */
-#    pragma warning(disable : 4996)
-#endif
+/* 36, the length of a UUID string without its terminator. */
+#define UUID_STR_CHARS (AWS_UUID_STR_LEN - 1)
 
 int aws_uuid_init(struct aws_uuid *uuid) {
     struct aws_byte_buf buf = aws_byte_buf_from_empty_array(uuid->uuid_data, sizeof(uuid->uuid_data));
 
-    return aws_device_random_buffer(&buf);
+    if (aws_device_random_buffer(&buf)) {
+        return AWS_OP_ERR;
+    }
+
+    /* version 4 in the high nibble of byte 6, RFC 9562 variant in the top two bits of byte 8 */
+    uuid->uuid_data[6] = (uint8_t)((uuid->uuid_data[6] & 0x0F) | 0x40);
+    uuid->uuid_data[8] = (uint8_t)((uuid->uuid_data[8] & 0x3F) | 0x80);
+    return AWS_OP_SUCCESS;
 }
 
 int aws_uuid_init_from_str(struct aws_uuid *uuid, const struct aws_byte_cursor *uuid_str) {
-    if (uuid_str->len < AWS_UUID_STR_LEN - 1) {
+    if (uuid_str->len < UUID_STR_CHARS) {
         return aws_raise_error(AWS_ERROR_INVALID_BUFFER_SIZE);
     }
 
-    char cpy[AWS_UUID_STR_LEN] = {0};
-    memcpy(cpy, uuid_str->ptr, AWS_UUID_STR_LEN - 1);
-
     AWS_ZERO_STRUCT(*uuid);
 
-    if (16 != sscanf(
-                  cpy,
-                  UUID_FORMAT,
-                  &uuid->uuid_data[0],
-                  &uuid->uuid_data[1],
-                  &uuid->uuid_data[2],
-                  &uuid->uuid_data[3],
-                  &uuid->uuid_data[4],
-                  &uuid->uuid_data[5],
-                  &uuid->uuid_data[6],
-                  &uuid->uuid_data[7],
-                  &uuid->uuid_data[8],
-                  &uuid->uuid_data[9],
-                  &uuid->uuid_data[10],
-                  &uuid->uuid_data[11],
-                  &uuid->uuid_data[12],
-                  &uuid->uuid_data[13],
-                  &uuid->uuid_data[14],
-                  &uuid->uuid_data[15])) {
+    const uint8_t *str = uuid_str->ptr;
+    if (str[8] != '-' || str[13] != '-' || str[18] != '-' || str[23] != '-') {
+        return aws_raise_error(AWS_ERROR_MALFORMED_INPUT_STRING);
+    }
+
+    bool valid = true;
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_uuid_groups); ++i) {
+        valid &= aws_hex_private_decode_bytes(
+            str + s_uuid_groups[i].str_offset,
+            s_uuid_groups[i].len,
+            uuid->uuid_data + s_uuid_groups[i].data_offset);
+    }
+
+    if (!valid) {
+        AWS_ZERO_STRUCT(*uuid);
         return aws_raise_error(AWS_ERROR_MALFORMED_INPUT_STRING);
     }
 
     return AWS_OP_SUCCESS;
 }
 
+/* Writes the 36 characters of uuid to out. */
+static void s_uuid_write_str(const struct aws_uuid *uuid, uint8_t *out) {
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_uuid_groups); ++i) {
+        aws_hex_private_encode_bytes(
+            uuid->uuid_data + s_uuid_groups[i].data_offset, s_uuid_groups[i].len, out + s_uuid_groups[i].str_offset);
+    }
+    out[8] = '-';
+    out[13] = '-';
+    out[18] = '-';
+    out[23] = '-';
+}
+
 int aws_uuid_to_str(const struct aws_uuid *uuid, struct aws_byte_buf *output) {
     if (output->capacity - output->len < AWS_UUID_STR_LEN) {
         return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
     }
 
-    sprintf(
-        (char *)(output->buffer + output->len),
-        UUID_FORMAT,
-        uuid->uuid_data[0],
-        uuid->uuid_data[1],
-        uuid->uuid_data[2],
-        uuid->uuid_data[3],
-        uuid->uuid_data[4],
-        uuid->uuid_data[5],
-        uuid->uuid_data[6],
-        uuid->uuid_data[7],
-        uuid->uuid_data[8],
-        uuid->uuid_data[9],
-        uuid->uuid_data[10],
-        uuid->uuid_data[11],
-        uuid->uuid_data[12],
-        uuid->uuid_data[13],
-        uuid->uuid_data[14],
-        uuid->uuid_data[15]);
-
-    output->len += AWS_UUID_STR_LEN - 1;
+    uint8_t *out = output->buffer + output->len;
+    s_uuid_write_str(uuid, out);
+    out[UUID_STR_CHARS] = '\0';
+
+    output->len += UUID_STR_CHARS;
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_uuid_array_to_str(const struct aws_uuid *uuids, size_t count, struct aws_byte_buf *output) {
+    size_t required = 0;
+    if (aws_mul_size_checked(count, UUID_STR_CHARS, &required)) {
+        return AWS_OP_ERR;
+    }
+
+    if (output->capacity - output->len < required) {
+        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+    }
+
+    uint8_t *out = output->buffer + output->len;
+    for (size_t i = 0; i < count; ++i) {
+        s_uuid_write_str(&uuids[i], out + i * UUID_STR_CHARS);
+    }
+
+    output->len += required;
 
     return AWS_OP_SUCCESS;
 }
@@ -111,3 +129,233 @@ int aws_uuid_to_str(const struct aws_uuid *uuid, struct aws_byte_buf *output) {
 bool aws_uuid_equals(const struct aws_uuid *a, const struct aws_uuid *b) {
     return 0 == memcmp(a->uuid_data, b->uuid_data, sizeof(a->uuid_data));
 }
+
+int aws_uuid_compare(const struct aws_uuid *a, const struct aws_uuid *b) {
+    return memcmp(a->uuid_data, b->uuid_data, sizeof(a->uuid_data));
+}
+
+uint64_t aws_hash_uuid(const void *item) {
+    const struct aws_uuid *uuid = item;
+    struct aws_byte_cursor cursor = aws_byte_cursor_from_array(uuid->uuid_data, sizeof(uuid->uuid_data));
+    return aws_hash_byte_cursor_ptr(&cursor);
+}
+
+bool aws_hash_callback_uuid_eq(const void *a, const void *b) {
+    return aws_uuid_equals(a, b);
+}
+
+/*
+ * UUIDv7 and ULID share a layout: a 48-bit millisecond timestamp, then random bits (74 for UUIDv7, once the version and
+ * variant are taken out, and 80 for ULID). Each kind keeps the last value it handed out, with the random bits as one
+ * number split into its high 16 and low 64 bits, so that the next value in the same millisecond can be the last one
+ * plus one, as in RFC 9562's monotonic random method and the ULID spec.
+ */
+struct time_ordered_id {
+    uint64_t ms;
+    uint64_t random_high;
+    uint64_t random_low;
+};
+
+struct time_ordered_generator {
+    struct time_ordered_id last;
+    /* bits of random_high in use: 10 for UUIDv7, 16 for ULID */
+    uint8_t random_high_bits;
+    void (*write)(const struct time_ordered_id *id, uint8_t *out);
+};
+
+static void s_write_ms(uint64_t ms, uint8_t *out) {
+    for (size_t i = 0; i < 6; ++i) {
+        out[i] = (uint8_t)(ms >> (40 - 8 * i));
+    }
+}
+
+static void s_write_u64(uint64_t value, uint8_t *out) {
+    for (size_t i = 0; i < 8; ++i) {
+        out[i] = (uint8_t)(value >> (56 - 8 * i));
+    }
+}
+
+static void s_write_uuid_v7(const struct time_ordered_id *id, uint8_t *out) {
+    /* 12 bits of rand_a after the version nibble, then the variant and 62 bits of rand_b */
+    uint64_t rand_a = id->random_high << 2 | id->random_low >> 62;
+    s_write_ms(id->ms, out);
+    out[6] = (uint8_t)(0x70 | rand_a >> 8);
+    out[7] = (uint8_t)rand_a;
+    s_write_u64((id->random_low & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL, out + 8);
+}
+
+static void s_write_ulid(const struct time_ordered_id *id, uint8_t *out) {
+    s_write_ms(id->ms, out);
+    out[6] = (uint8_t)(id->random_high >> 8);
+    out[7] = (uint8_t)id->random_high;
+    s_write_u64(id->random_low, out + 8);
+}
+
+/* Adds one to the random bits of id. Returns false if they wrapped around to 0. */
+static bool s_increment_random(struct time_ordered_id *id, uint64_t random_high_mask) {
+    if (++id->random_low != 0) {
+        return true;
+    }
+
+    id->random_high = (id->random_high + 1) & random_high_mask;
+    return id->random_high != 0;
+}
+
+static struct aws_mutex s_time_ordered_lock = AWS_MUTEX_INIT;
+static struct time_ordered_generator s_uuid_v7_generator = {.random_high_bits = 10, .write = s_write_uuid_v7};
+static struct time_ordered_generator s_ulid_generator = {.random_high_bits = 16, .write = s_write_ulid};
+
+static int s_time_ordered_init(struct time_ordered_generator *generator, uint8_t *out, size_t stride, size_t count) {
+    if (count == 0) {
+        return AWS_OP_SUCCESS;
+    }
+
+    /* drawn before taking the lock, and used whenever the millisecond changes */
+    uint64_t random[2] = {0};
+    struct aws_byte_buf random_buf = aws_byte_buf_from_empty_array((uint8_t *)random, sizeof(random));
+    uint64_t now = 0;
+    if (aws_device_random_buffer(&random_buf) || aws_sys_clock_get_ticks(&now)) {
+        return AWS_OP_ERR;
+    }
+
+    uint64_t random_high_mask = (1ULL << generator->random_high_bits) - 1;
+    struct time_ordered_id fresh;
+    AWS_ZERO_STRUCT(fresh);
+    fresh.ms = aws_timestamp_convert(now, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_MILLIS, NULL) & 0xFFFFFFFFFFFFULL;
+    fresh.random_high = random[0] & random_high_mask;
+    fresh.random_low = random[1];
+
+    if (aws_mutex_lock(&s_time_ordered_lock)) {
+        return AWS_OP_ERR;
+    }
+
+    struct time_ordered_id *last = &generator->last;
+    for (size_t i = 0; i < count; ++i) {
+        if (fresh.ms > last->ms) {
+            *last = fresh;
+        } else if (!s_increment_random(last, random_high_mask)) {
+            /* the random bits ran out within one millisecond: borrow the next one */
+            last->ms++;
+            last->random_high = fresh.random_high;
+            last->random_low = fresh.random_low;
+        }
+        generator->write(last, out + i * stride);
+    }
+
+    aws_mutex_unlock(&s_time_ordered_lock);
+    return AWS_OP_SUCCESS;
+}
+
+int aws_uuid_init_v7(struct aws_uuid *uuid) {
+    return aws_uuid_init_v7_batch(uuid, 1);
+}
+
+int aws_uuid_init_v7_batch(struct aws_uuid *uuids, size_t count) {
+    return s_time_ordered_init(&s_uuid_v7_generator, uuids->uuid_data, sizeof(struct aws_uuid), count);
+}
+
+int aws_ulid_init(struct aws_ulid *ulid) {
+    return aws_ulid_init_batch(ulid, 1);
+}
+
+int aws_ulid_init_batch(struct aws_ulid *ulids, size_t count) {
+    return s_time_ordered_init(&s_ulid_generator, ulids->ulid_data, sizeof(struct aws_ulid), count);
+}
+
+static const char s_crockford_alphabet[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
+/* 26 characters of 5 bits are 130 bits, so the string starts with 2 bits of padding. */
+#define ULID_STR_CHARS (AWS_ULID_STR_LEN - 1)
+
+int aws_ulid_to_str(const struct aws_ulid *ulid, struct aws_byte_buf *output) {
+    if (output->capacity - output->len < AWS_ULID_STR_LEN) {
+        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+    }
+
+    uint8_t *out = output->buffer + output->len;
+    uint32_t bits = 0;
+    size_t bit_count = 2;
+    size_t written = 0;
+    for (size_t i = 0; i < sizeof(ulid->ulid_data); ++i) {
+        bits = bits << 8 | ulid->ulid_data[i];
+        bit_count += 8;
+        while (bit_count >= 5) {
+            bit_count -= 5;
+            out[written++] = (uint8_t)s_crockford_alphabet[bits >> bit_count & 0x1F];
+        }
+    }
+    out[ULID_STR_CHARS] = '\0';
+
+    output->len += ULID_STR_CHARS;
+    return AWS_OP_SUCCESS;
+}
+
+/* Returns the value of a Crockford base32 character, or -1. */
+static int s_crockford_value(uint8_t c) {
+    if (c >= 'a' && c <= 'z') {
+        c = (uint8_t)(c - 'a' + 'A');
+    }
+
+    switch (c) {
+        case 'O':
+            return 0;
+        case 'I':
+        case 'L':
+            return 1;
+        default:
+            break;
+    }
+
+    const char *found = c ? strchr(s_crockford_alphabet, c) : NULL;
+    return found ? (int)(found - s_crockford_alphabet) : -1;
+}
+
+int aws_ulid_init_from_str(struct aws_ulid *ulid, const struct aws_byte_cursor *ulid_str) {
+    if (ulid_str->len < ULID_STR_CHARS) {
+        return aws_raise_error(AWS_ERROR_INVALID_BUFFER_SIZE);
+    }
+
+    AWS_ZERO_STRUCT(*ulid);
+
+    uint32_t bits = 0;
+    size_t bit_count = 0;
+    size_t written = 0;
+    for (size_t i = 0; i < ULID_STR_CHARS; ++i) {
+        int value = s_crockford_value(ulid_str->ptr[i]);
+        /* the first character only has room for 3 bits */
+        if (value < 0 || (i == 0 && value > 7)) {
+            AWS_ZERO_STRUCT(*ulid);
+            return aws_raise_error(AWS_ERROR_MALFORMED_INPUT_STRING);
+        }
+
+        bits = bits << 5 | (uint32_t)value;
+        bit_count += 5;
+        if (i == 0) {
+            bit_count -= 2;
+        }
+        if (bit_count >= 8) {
+            bit_count -= 8;
+            ulid->ulid_data[written++] = (uint8_t)(bits >> bit_count);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+bool aws_ulid_equals(const struct aws_ulid *a, const struct aws_ulid *b) {
+    return 0 == memcmp(a->ulid_data, b->ulid_data, sizeof(a->ulid_data));
+}
+
+int aws_ulid_compare(const struct aws_ulid *a, const struct aws_ulid *b) {
+    return memcmp(a->ulid_data, b->ulid_data, sizeof(a->ulid_data));
+}
+
+uint64_t aws_hash_ulid(const void *item) {
+    const struct aws_ulid *ulid = item;
+    struct aws_byte_cursor cursor = aws_byte_cursor_from_array(ulid->ulid_data, sizeof(ulid->ulid_data));
+    return aws_hash_byte_cursor_ptr(&cursor);
+}
+
+bool aws_hash_callback_ulid_eq(const void *a, const void *b) {
+    return aws_ulid_equals(a, b);
+}
@@ -83,3 +83,16 @@ int aws_sys_clock_get_ticks(uint64_t *timestamp) {
     *timestamp = (int_conv.QuadPart - (WINDOWS_TICK * EC_TO_UNIX_EPOCH)) * FILE_TIME_TO_NS;
     return AWS_OP_SUCCESS;
 }
+
+int aws_sys_clock_get_ticks_coarse(uint64_t *timestamp) {
+    FILETIME ticks;
+    /* unlike the precise variant, this returns the time as of the last timer interrupt */
+    GetSystemTimeAsFileTime(&ticks);
+
+    ULARGE_INTEGER int_conv;
+    int_conv.LowPart = ticks.dwLowDateTime;
+    int_conv.HighPart = ticks.dwHighDateTime;
+
+    *timestamp = (int_conv.QuadPart - (WINDOWS_TICK * EC_TO_UNIX_EPOCH)) * FILE_TIME_TO_NS;
+    return AWS_OP_SUCCESS;
+}
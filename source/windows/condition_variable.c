@@ -17,6 +17,7 @@
 
 #include <aws/common/clock.h>
 #include <aws/common/mutex.h>
+#include <aws/common/private/lock_profile.h>
 
 #include <Windows.h>
 
@@ -50,7 +51,17 @@ int aws_condition_variable_notify_all(struct aws_condition_variable *condition_v
 
 int aws_condition_variable_wait(struct aws_condition_variable *condition_variable, struct aws_mutex *mutex) {
 
-    if (SleepConditionVariableSRW(AWSCV_TO_WINDOWS(condition_variable), AWSMUTEX_TO_WINDOWS(mutex), INFINITE, 0)) {
+    if (mutex->profile) {
+        aws_lock_profile_private_released(mutex->profile);
+    }
+
+    BOOL res = SleepConditionVariableSRW(AWSCV_TO_WINDOWS(condition_variable), AWSMUTEX_TO_WINDOWS(mutex), INFINITE, 0);
+
+    if (mutex->profile) {
+        aws_lock_profile_private_reacquired(mutex->profile);
+    }
+
+    if (res) {
         return AWS_OP_SUCCESS;
     }
 
@@ -64,7 +75,17 @@ int aws_condition_variable_wait_for(
 
     DWORD time_ms = (DWORD)aws_timestamp_convert(time_to_wait, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_MILLIS, NULL);
 
-    if (SleepConditionVariableSRW(AWSCV_TO_WINDOWS(condition_variable), AWSMUTEX_TO_WINDOWS(mutex), time_ms, 0)) {
+    if (mutex->profile) {
+        aws_lock_profile_private_released(mutex->profile);
+    }
+
+    BOOL res = SleepConditionVariableSRW(AWSCV_TO_WINDOWS(condition_variable), AWSMUTEX_TO_WINDOWS(mutex), time_ms, 0);
+
+    if (mutex->profile) {
+        aws_lock_profile_private_reacquired(mutex->profile);
+    }
+
+    if (res) {
         return AWS_OP_SUCCESS;
     }
 
@@ -14,14 +14,19 @@
  */
 #include <aws/common/device_random.h>
 
-#include <aws/common/byte_buf.h>
 #include <aws/common/thread.h>
 
+#include <aws/common/private/device_random.h>
+
 #include <Windows.h>
 #include <bcrypt.h>
 
+#include <limits.h>
+
 static BCRYPT_ALG_HANDLE s_alg_handle = NULL;
 static aws_thread_once s_rand_init = AWS_THREAD_ONCE_STATIC_INIT;
+static DWORD s_thread_buffer_index = FLS_OUT_OF_INDEXES;
+static aws_thread_once s_thread_buffer_index_init = AWS_THREAD_ONCE_STATIC_INIT;
 
 static void s_init_rand(void) {
     NTSTATUS status = 0;
@@ -33,16 +38,42 @@ static void s_init_rand(void) {
     }
 }
 
-int aws_device_random_buffer(struct aws_byte_buf *output) {
+int aws_device_random_private_fill(uint8_t *dest, size_t len) {
     aws_thread_call_once(&s_rand_init, s_init_rand);
 
-    size_t offset = output->capacity - output->len;
-    NTSTATUS status = BCryptGenRandom(s_alg_handle, output->buffer + output->len, (ULONG)offset, 0);
+    while (len > 0) {
+        ULONG amount = len > ULONG_MAX ? ULONG_MAX : (ULONG)len;
+        NTSTATUS status = BCryptGenRandom(s_alg_handle, dest, amount, 0);
 
-    if (!BCRYPT_SUCCESS(status)) {
-        return aws_raise_error(AWS_ERROR_RANDOM_GEN_FAILED);
+        if (!BCRYPT_SUCCESS(status)) {
+            return aws_raise_error(AWS_ERROR_RANDOM_GEN_FAILED);
+        }
+
+        dest += amount;
+        len -= amount;
     }
 
-    output->len += offset;
     return AWS_OP_SUCCESS;
 }
+
+size_t aws_device_random_private_fork_generation(void) {
+    /* no fork on Windows */
+    return 0;
+}
+
+static void WINAPI s_on_thread_exit(void *buffer) {
+    if (buffer) {
+        aws_device_random_private_release_thread_buffer(buffer);
+    }
+}
+
+static void s_init_thread_buffer_index(void) {
+    /* fiber local storage, unlike TlsAlloc, runs a callback when the thread exits */
+    s_thread_buffer_index = FlsAlloc(s_on_thread_exit);
+}
+
+bool aws_device_random_private_watch_thread_exit(void *buffer) {
+    aws_thread_call_once(&s_thread_buffer_index_init, s_init_thread_buffer_index);
+
+    return s_thread_buffer_index != FLS_OUT_OF_INDEXES && FlsSetValue(s_thread_buffer_index, buffer);
+}
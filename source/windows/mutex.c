@@ -15,13 +15,16 @@
 
 #include <aws/common/mutex.h>
 
+#include <aws/common/private/lock_profile.h>
+
 #include <Windows.h>
 
-/* Ensure our condition variable and Windows' condition variables are the same size */
-AWS_STATIC_ASSERT(sizeof(SRWLOCK) == sizeof(struct aws_mutex));
+/* Ensure our mutex handle and Windows' SRW locks are the same size; the handle is the first member of aws_mutex */
+AWS_STATIC_ASSERT(sizeof(SRWLOCK) == sizeof(((struct aws_mutex *)0)->mutex_handle));
 
 int aws_mutex_init(struct aws_mutex *mutex) {
     InitializeSRWLock(AWSMUTEX_TO_WINDOWS(mutex));
+    mutex->profile = NULL;
     return AWS_OP_SUCCESS;
 }
 
@@ -31,9 +34,26 @@ int aws_mutex_init(struct aws_mutex *mutex) {
 #    pragma warning(disable : 4100)
 #endif
 
-void aws_mutex_clean_up(struct aws_mutex *mutex) {}
+void aws_mutex_clean_up(struct aws_mutex *mutex) {
+    if (mutex->profile) {
+        aws_lock_profile_private_destroy(mutex->profile);
+        mutex->profile = NULL;
+    }
+}
 
 int aws_mutex_lock(struct aws_mutex *mutex) {
+    if (AWS_UNLIKELY(mutex->profile != NULL)) {
+        bool contended = false;
+        uint64_t wait_start = 0;
+        if (!TryAcquireSRWLockExclusive(AWSMUTEX_TO_WINDOWS(mutex))) {
+            contended = true;
+            wait_start = aws_lock_profile_private_now();
+            AcquireSRWLockExclusive(AWSMUTEX_TO_WINDOWS(mutex));
+        }
+        aws_lock_profile_private_acquired(mutex->profile, true, contended, wait_start);
+        return AWS_OP_SUCCESS;
+    }
+
     AcquireSRWLockExclusive(AWSMUTEX_TO_WINDOWS(mutex));
     return AWS_OP_SUCCESS;
 }
@@ -42,13 +62,21 @@ int aws_mutex_try_lock(struct aws_mutex *mutex) {
     BOOL res = TryAcquireSRWLockExclusive(AWSMUTEX_TO_WINDOWS(mutex));
 
     if (!res) {
-        return AWS_OP_SUCCESS;
+        return aws_raise_error(AWS_ERROR_MUTEX_TIMEOUT);
+    }
+
+    if (AWS_UNLIKELY(mutex->profile != NULL)) {
+        aws_lock_profile_private_acquired(mutex->profile, true, false, 0);
     }
 
-    return aws_raise_error(AWS_ERROR_MUTEX_TIMEOUT);
+    return AWS_OP_SUCCESS;
 }
 
 int aws_mutex_unlock(struct aws_mutex *mutex) {
+    if (AWS_UNLIKELY(mutex->profile != NULL)) {
+        aws_lock_profile_private_released(mutex->profile);
+    }
+
     ReleaseSRWLockExclusive(AWSMUTEX_TO_WINDOWS(mutex));
     return AWS_OP_SUCCESS;
 }
@@ -15,31 +15,61 @@
 
 #include <aws/common/rw_lock.h>
 
+#include <aws/common/private/lock_profile.h>
+
 #include <Windows.h>
 #include <synchapi.h>
 
-/* Ensure our rwlock and Windows' rwlocks are the same size */
-AWS_STATIC_ASSERT(sizeof(SRWLOCK) == sizeof(struct aws_rw_lock));
+/* Ensure our rwlock handle and Windows' rwlocks are the same size; the handle is the first member of aws_rw_lock */
+AWS_STATIC_ASSERT(sizeof(SRWLOCK) == sizeof(((struct aws_rw_lock *)0)->lock_handle));
 
 int aws_rw_lock_init(struct aws_rw_lock *lock) {
 
     InitializeSRWLock(AWSSRW_TO_WINDOWS(lock));
+    lock->profile = NULL;
     return AWS_OP_SUCCESS;
 }
 
 void aws_rw_lock_clean_up(struct aws_rw_lock *lock) {
 
-    (void)lock;
+    if (lock->profile) {
+        aws_lock_profile_private_destroy(lock->profile);
+        lock->profile = NULL;
+    }
 }
 
 int aws_rw_lock_rlock(struct aws_rw_lock *lock) {
 
+    if (AWS_UNLIKELY(lock->profile != NULL)) {
+        bool contended = false;
+        uint64_t wait_start = 0;
+        if (!TryAcquireSRWLockShared(AWSSRW_TO_WINDOWS(lock))) {
+            contended = true;
+            wait_start = aws_lock_profile_private_now();
+            AcquireSRWLockShared(AWSSRW_TO_WINDOWS(lock));
+        }
+        aws_lock_profile_private_acquired(lock->profile, false, contended, wait_start);
+        return AWS_OP_SUCCESS;
+    }
+
     AcquireSRWLockShared(AWSSRW_TO_WINDOWS(lock));
     return AWS_OP_SUCCESS;
 }
 
 int aws_rw_lock_wlock(struct aws_rw_lock *lock) {
 
+    if (AWS_UNLIKELY(lock->profile != NULL)) {
+        bool contended = false;
+        uint64_t wait_start = 0;
+        if (!TryAcquireSRWLockExclusive(AWSSRW_TO_WINDOWS(lock))) {
+            contended = true;
+            wait_start = aws_lock_profile_private_now();
+            AcquireSRWLockExclusive(AWSSRW_TO_WINDOWS(lock));
+        }
+        aws_lock_profile_private_acquired(lock->profile, true, contended, wait_start);
+        return AWS_OP_SUCCESS;
+    }
+
     AcquireSRWLockExclusive(AWSSRW_TO_WINDOWS(lock));
     return AWS_OP_SUCCESS;
 }
@@ -47,6 +77,9 @@ int aws_rw_lock_wlock(struct aws_rw_lock *lock) {
 int aws_rw_lock_try_rlock(struct aws_rw_lock *lock) {
 
     if (TryAcquireSRWLockShared(AWSSRW_TO_WINDOWS(lock))) {
+        if (AWS_UNLIKELY(lock->profile != NULL)) {
+            aws_lock_profile_private_acquired(lock->profile, false, false, 0);
+        }
         return AWS_OP_SUCCESS;
     }
 
@@ -56,6 +89,9 @@ int aws_rw_lock_try_rlock(struct aws_rw_lock *lock) {
 int aws_rw_lock_try_wlock(struct aws_rw_lock *lock) {
 
     if (TryAcquireSRWLockExclusive(AWSSRW_TO_WINDOWS(lock))) {
+        if (AWS_UNLIKELY(lock->profile != NULL)) {
+            aws_lock_profile_private_acquired(lock->profile, true, false, 0);
+        }
         return AWS_OP_SUCCESS;
     }
 
@@ -71,6 +107,10 @@ int aws_rw_lock_runlock(struct aws_rw_lock *lock) {
 
 int aws_rw_lock_wunlock(struct aws_rw_lock *lock) {
 
+    if (AWS_UNLIKELY(lock->profile != NULL)) {
+        aws_lock_profile_private_released(lock->profile);
+    }
+
     ReleaseSRWLockExclusive(AWSSRW_TO_WINDOWS(lock));
 
     return AWS_OP_SUCCESS;
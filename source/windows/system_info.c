@@ -15,6 +15,8 @@
 
 #include <aws/common/system_info.h>
 
+#include <aws/common/private/cpu_topology.h>
+
 #include <windows.h>
 
 size_t aws_system_info_processor_count(void) {
@@ -22,3 +24,113 @@ size_t aws_system_info_processor_count(void) {
     GetSystemInfo(&info);
     return info.dwNumberOfProcessors;
 }
+
+static struct aws_cache_info *s_cache_for(struct aws_cpu_topology *topology, const CACHE_DESCRIPTOR *descriptor) {
+    switch (descriptor->Level) {
+        case 1:
+            if (descriptor->Type == CacheData || descriptor->Type == CacheUnified) {
+                return &topology->l1_data_cache;
+            }
+            return descriptor->Type == CacheInstruction ? &topology->l1_instruction_cache : NULL;
+        case 2:
+            return &topology->l2_cache;
+        case 3:
+            return &topology->l3_cache;
+        default:
+            return NULL;
+    }
+}
+
+static size_t s_mask_count(ULONG_PTR mask) {
+    size_t count = 0;
+    for (; mask; mask &= mask - 1) {
+        ++count;
+    }
+    return count;
+}
+
+/* Covers processor group 0, i.e. the first 64 logical processors, which is also what thread affinity can address. */
+int aws_system_info_cpu_topology_init(struct aws_cpu_topology *topology, struct aws_allocator *allocator) {
+    AWS_ZERO_STRUCT(*topology);
+    topology->allocator = allocator;
+
+    DWORD buffer_size = 0;
+    GetLogicalProcessorInformation(NULL, &buffer_size);
+    SYSTEM_LOGICAL_PROCESSOR_INFORMATION *infos = NULL;
+    if (buffer_size) {
+        infos = aws_mem_acquire(allocator, buffer_size);
+        if (!infos) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    ULONG_PTR online_mask = 0;
+    size_t info_count = 0;
+    if (infos && GetLogicalProcessorInformation(infos, &buffer_size)) {
+        info_count = buffer_size / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
+        for (size_t i = 0; i < info_count; ++i) {
+            if (infos[i].Relationship == RelationProcessorCore) {
+                online_mask |= infos[i].ProcessorMask;
+            }
+        }
+    }
+
+    if (!online_mask) {
+        if (infos) {
+            aws_mem_release(allocator, infos);
+        }
+        if (aws_cpu_topology_private_init_flat(topology)) {
+            return AWS_OP_ERR;
+        }
+        aws_cpu_topology_private_summarize(topology);
+        return AWS_OP_SUCCESS;
+    }
+
+    topology->cpus = aws_mem_acquire(allocator, s_mask_count(online_mask) * sizeof(struct aws_cpu_info));
+    if (!topology->cpus) {
+        aws_mem_release(allocator, infos);
+        return AWS_OP_ERR;
+    }
+    for (uint32_t cpu_id = 0; cpu_id < sizeof(ULONG_PTR) * 8; ++cpu_id) {
+        if (online_mask & ((ULONG_PTR)1 << cpu_id)) {
+            topology->cpus[topology->logical_cpu_count++] = (struct aws_cpu_info){.cpu_id = cpu_id};
+        }
+    }
+
+    uint32_t core_index = 0;
+    uint32_t package_id = 0;
+    for (size_t i = 0; i < info_count; ++i) {
+        const SYSTEM_LOGICAL_PROCESSOR_INFORMATION *info = &infos[i];
+        for (size_t j = 0; j < topology->logical_cpu_count; ++j) {
+            struct aws_cpu_info *cpu = &topology->cpus[j];
+            if (!(info->ProcessorMask & ((ULONG_PTR)1 << cpu->cpu_id))) {
+                continue;
+            }
+            if (info->Relationship == RelationProcessorCore) {
+                cpu->core_index = core_index;
+            } else if (info->Relationship == RelationProcessorPackage) {
+                cpu->package_id = package_id;
+            } else if (info->Relationship == RelationNumaNode) {
+                cpu->numa_node = (uint32_t)info->NumaNode.NodeNumber;
+            }
+        }
+
+        if (info->Relationship == RelationProcessorCore) {
+            ++core_index;
+        } else if (info->Relationship == RelationProcessorPackage) {
+            ++package_id;
+        } else if (info->Relationship == RelationCache && (info->ProcessorMask & 1)) {
+            /* caches as seen from CPU 0, like on other platforms */
+            struct aws_cache_info *cache = s_cache_for(topology, &info->Cache);
+            if (cache) {
+                cache->size = info->Cache.Size;
+                cache->line_size = info->Cache.LineSize;
+                cache->shared_cpu_count = s_mask_count(info->ProcessorMask);
+            }
+        }
+    }
+
+    aws_mem_release(allocator, infos);
+    aws_cpu_topology_private_summarize(topology);
+    return AWS_OP_SUCCESS;
+}
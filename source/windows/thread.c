@@ -70,6 +70,62 @@ int aws_thread_init(struct aws_thread *thread, struct aws_allocator *allocator)
     return AWS_OP_SUCCESS;
 }
 
+typedef HRESULT(WINAPI *set_thread_description_fn)(HANDLE thread, PCWSTR description);
+
+/* SetThreadDescription only exists on Windows 10 1607 and later, so it is looked up at runtime. */
+static void s_set_thread_name(HANDLE thread_handle, const char *name) {
+    set_thread_description_fn set_description =
+        (set_thread_description_fn)GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "SetThreadDescription");
+    if (!set_description) {
+        return;
+    }
+
+    wchar_t wide_name[AWS_THREAD_NAME_RECOMMENDED_MAX + 1];
+    if (MultiByteToWideChar(CP_UTF8, 0, name, -1, wide_name, AWS_ARRAY_SIZE(wide_name)) == 0) {
+        /* too long: keep what fits */
+        wide_name[AWS_ARRAY_SIZE(wide_name) - 1] = L'\0';
+    }
+    set_description(thread_handle, wide_name);
+}
+
+static void s_set_thread_priority(HANDLE thread_handle, enum aws_thread_priority priority) {
+    static const int s_priorities[] = {
+        [AWS_THREAD_PRIORITY_DEFAULT] = THREAD_PRIORITY_NORMAL,
+        [AWS_THREAD_PRIORITY_LOWEST] = THREAD_PRIORITY_LOWEST,
+        [AWS_THREAD_PRIORITY_LOW] = THREAD_PRIORITY_BELOW_NORMAL,
+        [AWS_THREAD_PRIORITY_HIGH] = THREAD_PRIORITY_ABOVE_NORMAL,
+        [AWS_THREAD_PRIORITY_HIGHEST] = THREAD_PRIORITY_HIGHEST,
+    };
+
+    if ((size_t)priority < AWS_ARRAY_SIZE(s_priorities)) {
+        SetThreadPriority(thread_handle, s_priorities[priority]);
+    }
+}
+
+/* CPU indices map onto processor group 0, which holds the first 64 logical processors. */
+static int s_set_thread_affinity(HANDLE thread_handle, const struct aws_thread_options *options) {
+    if (options->cpu_affinity_count) {
+        DWORD_PTR mask = 0;
+        for (size_t i = 0; i < options->cpu_affinity_count; ++i) {
+            if (options->cpu_affinity[i] >= sizeof(DWORD_PTR) * 8) {
+                return aws_raise_error(AWS_ERROR_THREAD_INVALID_SETTINGS);
+            }
+            mask |= (DWORD_PTR)1 << options->cpu_affinity[i];
+        }
+        if (!SetThreadAffinityMask(thread_handle, mask)) {
+            return aws_raise_error(AWS_ERROR_THREAD_INVALID_SETTINGS);
+        }
+    } else if (options->prefer_numa_node) {
+        GROUP_AFFINITY node_affinity;
+        if (!GetNumaNodeProcessorMaskEx(options->numa_node, &node_affinity) ||
+            !SetThreadGroupAffinity(thread_handle, &node_affinity, NULL)) {
+            return aws_raise_error(AWS_ERROR_THREAD_INVALID_SETTINGS);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
 int aws_thread_launch(
     struct aws_thread *thread,
     void (*func)(void *arg),
@@ -84,16 +140,41 @@ int aws_thread_launch(
 
     struct thread_wrapper *thread_wrapper =
         (struct thread_wrapper *)aws_mem_acquire(thread->allocator, sizeof(struct thread_wrapper));
+    if (!thread_wrapper) {
+        return AWS_OP_ERR;
+    }
     thread_wrapper->allocator = thread->allocator;
     thread_wrapper->arg = arg;
     thread_wrapper->func = func;
-    thread->thread_handle =
-        CreateThread(0, stack_size, thread_wrapper_fn, (LPVOID)thread_wrapper, 0, &thread->thread_id);
+
+    /* start suspended so that placement and priority are in effect before the thread runs anything */
+    thread->thread_handle = CreateThread(
+        0, stack_size, thread_wrapper_fn, (LPVOID)thread_wrapper, CREATE_SUSPENDED, &thread->thread_id);
 
     if (!thread->thread_handle) {
+        aws_mem_release(thread->allocator, thread_wrapper);
         return aws_raise_error(AWS_ERROR_THREAD_INSUFFICIENT_RESOURCE);
     }
 
+    if (options) {
+        if (s_set_thread_affinity(thread->thread_handle, options)) {
+            /* the thread never ran, so its wrapper is still ours */
+            TerminateThread(thread->thread_handle, 0);
+            CloseHandle(thread->thread_handle);
+            thread->thread_handle = 0;
+            aws_mem_release(thread->allocator, thread_wrapper);
+            return AWS_OP_ERR;
+        }
+        if (options->name) {
+            s_set_thread_name(thread->thread_handle, options->name);
+        }
+        if (options->priority != AWS_THREAD_PRIORITY_DEFAULT) {
+            s_set_thread_priority(thread->thread_handle, options->priority);
+        }
+    }
+
+    ResumeThread(thread->thread_handle);
+
     thread->detach_state = AWS_THREAD_JOINABLE;
     return AWS_OP_SUCCESS;
 }
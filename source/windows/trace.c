@@ -0,0 +1,40 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+#include <aws/common/trace.h>
+
+#include <aws/common/thread.h>
+
+#include <aws/common/private/trace.h>
+
+#include <Windows.h>
+
+static DWORD s_thread_ring_index = FLS_OUT_OF_INDEXES;
+static aws_thread_once s_thread_ring_index_init = AWS_THREAD_ONCE_STATIC_INIT;
+
+static void WINAPI s_on_thread_exit(void *ring) {
+    if (ring) {
+        aws_trace_private_retire_thread_ring(ring);
+    }
+}
+
+static void s_init_thread_ring_index(void) {
+    s_thread_ring_index = FlsAlloc(s_on_thread_exit);
+}
+
+bool aws_trace_private_watch_thread_exit(void *ring) {
+    aws_thread_call_once(&s_thread_ring_index_init, s_init_thread_ring_index);
+
+    return s_thread_ring_index != FLS_OUT_OF_INDEXES && FlsSetValue(s_thread_ring_index, ring);
+}
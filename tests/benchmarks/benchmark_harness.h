@@ -0,0 +1,54 @@
+#ifndef AWS_BENCHMARKS_BENCHMARK_HARNESS_H
+#define AWS_BENCHMARKS_BENCHMARK_HARNESS_H
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/clock.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Minimal helpers shared by the micro-benchmarks in this directory. Each benchmark is a standalone executable;
+ * results are printed one per line as "<name> <ns per op> ns/op [<MB/s> MB/s]".
+ */
+
+static inline uint64_t aws_benchmark_now(void) {
+    uint64_t now = 0;
+    if (aws_high_res_clock_get_ticks(&now)) {
+        fprintf(stderr, "failed to read the high resolution clock\n");
+        abort();
+    }
+    return now;
+}
+
+static inline void aws_benchmark_report(const char *name, uint64_t elapsed_ns, uint64_t ops, uint64_t bytes) {
+    double ns_per_op = ops ? (double)elapsed_ns / (double)ops : 0.0;
+    if (bytes && elapsed_ns) {
+        double mb_per_sec = ((double)bytes / (1024.0 * 1024.0)) / ((double)elapsed_ns / 1e9);
+        printf("%-48s %10.2f ns/op %10.1f MB/s\n", name, ns_per_op, mb_per_sec);
+    } else {
+        printf("%-48s %10.2f ns/op\n", name, ns_per_op);
+    }
+}
+
+/*
+ * Keeps the optimizer from discarding a computed value.
+ */
+static volatile uint64_t aws_benchmark_sink;
+
+#define AWS_BENCHMARK_CONSUME(value) (aws_benchmark_sink += (uint64_t)(value))
+
+#endif /* AWS_BENCHMARKS_BENCHMARK_HARNESS_H */
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/byte_buf.h>
+
+#include "benchmark_harness.h"
+
+#include <ctype.h>
+
+/*
+ * Benchmarks case-insensitive equality and hashing over typical HTTP header names against a per-byte tolower() loop.
+ * Run with AWS_COMMON_AVX2=0 in the environment to measure the non-SIMD fallbacks.
+ */
+
+static bool s_naive_eq_case_insensitive(struct aws_byte_cursor a, struct aws_byte_cursor b) {
+    if (a.len != b.len) {
+        return false;
+    }
+    for (size_t i = 0; i < a.len; ++i) {
+        if (tolower(a.ptr[i]) != tolower(b.ptr[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static const char *s_header_names[][2] = {
+    {"Host", "host"},
+    {"Content-Type", "content-type"},
+    {"Content-Length", "content-length"},
+    {"x-amz-content-sha256", "X-Amz-Content-Sha256"},
+    {"x-amz-server-side-encryption-customer-algorithm", "X-Amz-Server-Side-Encryption-Customer-Algorithm"},
+};
+
+int main(void) {
+    const size_t iterations = 5000000;
+    char name[96];
+
+    for (size_t h = 0; h < AWS_ARRAY_SIZE(s_header_names); ++h) {
+        struct aws_byte_cursor a = aws_byte_cursor_from_c_str(s_header_names[h][0]);
+        struct aws_byte_cursor b = aws_byte_cursor_from_c_str(s_header_names[h][1]);
+
+        uint64_t start = aws_benchmark_now();
+        for (size_t i = 0; i < iterations; ++i) {
+            AWS_BENCHMARK_CONSUME(aws_byte_cursor_eq_case_insensitive(&a, &b));
+        }
+        snprintf(name, sizeof(name), "eq_case_insensitive/%zu", a.len);
+        aws_benchmark_report(name, aws_benchmark_now() - start, iterations, (uint64_t)iterations * a.len);
+
+        start = aws_benchmark_now();
+        for (size_t i = 0; i < iterations; ++i) {
+            AWS_BENCHMARK_CONSUME(s_naive_eq_case_insensitive(a, b));
+        }
+        snprintf(name, sizeof(name), "naive_eq_case_insensitive/%zu", a.len);
+        aws_benchmark_report(name, aws_benchmark_now() - start, iterations, (uint64_t)iterations * a.len);
+
+        start = aws_benchmark_now();
+        for (size_t i = 0; i < iterations; ++i) {
+            AWS_BENCHMARK_CONSUME(aws_hash_byte_cursor_ptr_case_insensitive(&a));
+        }
+        snprintf(name, sizeof(name), "hash_case_insensitive/%zu", a.len);
+        aws_benchmark_report(name, aws_benchmark_now() - start, iterations, (uint64_t)iterations * a.len);
+    }
+
+    return 0;
+}
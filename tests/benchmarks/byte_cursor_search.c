@@ -0,0 +1,127 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/byte_buf.h>
+
+#include "benchmark_harness.h"
+
+/*
+ * Benchmarks the aws_byte_cursor search and split primitives against naive per-byte loops.
+ * Run with AWS_COMMON_AVX2=0 in the environment to measure the non-SIMD fallbacks.
+ */
+
+static size_t s_naive_find_any_of(struct aws_byte_cursor input, struct aws_byte_cursor byte_set) {
+    for (size_t i = 0; i < input.len; ++i) {
+        for (size_t j = 0; j < byte_set.len; ++j) {
+            if (input.ptr[i] == byte_set.ptr[j]) {
+                return i;
+            }
+        }
+    }
+    return input.len;
+}
+
+static size_t s_naive_find_substring(struct aws_byte_cursor input, struct aws_byte_cursor to_find) {
+    for (size_t i = 0; i + to_find.len <= input.len; ++i) {
+        if (!memcmp(input.ptr + i, to_find.ptr, to_find.len)) {
+            return i;
+        }
+    }
+    return input.len;
+}
+
+static void s_bench_input_size(size_t input_len, size_t iterations) {
+    char name[64];
+    uint8_t *input_storage = malloc(input_len);
+    memset(input_storage, 'a', input_len);
+    /* place the match at the very end so the whole input is scanned */
+    memcpy(input_storage + input_len - 6, "</Key>", 6);
+    struct aws_byte_cursor input = aws_byte_cursor_from_array(input_storage, input_len);
+
+    struct aws_byte_cursor byte_set = aws_byte_cursor_from_c_str("<>/");
+    struct aws_byte_cursor to_find = aws_byte_cursor_from_c_str("</Key>");
+    struct aws_byte_cursor result;
+
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < iterations; ++i) {
+        AWS_BENCHMARK_CONSUME(aws_byte_cursor_find_byte(&input, '<', &result));
+    }
+    snprintf(name, sizeof(name), "find_byte/%zu", input_len);
+    aws_benchmark_report(name, aws_benchmark_now() - start, iterations, (uint64_t)iterations * input_len);
+
+    start = aws_benchmark_now();
+    for (size_t i = 0; i < iterations; ++i) {
+        AWS_BENCHMARK_CONSUME(aws_byte_cursor_find_any_of(&input, &byte_set, &result));
+    }
+    snprintf(name, sizeof(name), "find_any_of/%zu", input_len);
+    aws_benchmark_report(name, aws_benchmark_now() - start, iterations, (uint64_t)iterations * input_len);
+
+    start = aws_benchmark_now();
+    for (size_t i = 0; i < iterations; ++i) {
+        AWS_BENCHMARK_CONSUME(s_naive_find_any_of(input, byte_set));
+    }
+    snprintf(name, sizeof(name), "naive_find_any_of/%zu", input_len);
+    aws_benchmark_report(name, aws_benchmark_now() - start, iterations, (uint64_t)iterations * input_len);
+
+    start = aws_benchmark_now();
+    for (size_t i = 0; i < iterations; ++i) {
+        AWS_BENCHMARK_CONSUME(aws_byte_cursor_find_substring(&input, &to_find, &result));
+    }
+    snprintf(name, sizeof(name), "find_substring/%zu", input_len);
+    aws_benchmark_report(name, aws_benchmark_now() - start, iterations, (uint64_t)iterations * input_len);
+
+    start = aws_benchmark_now();
+    for (size_t i = 0; i < iterations; ++i) {
+        AWS_BENCHMARK_CONSUME(s_naive_find_substring(input, to_find));
+    }
+    snprintf(name, sizeof(name), "naive_find_substring/%zu", input_len);
+    aws_benchmark_report(name, aws_benchmark_now() - start, iterations, (uint64_t)iterations * input_len);
+
+    free(input_storage);
+}
+
+static void s_bench_split(size_t iterations) {
+    struct aws_allocator *allocator = aws_default_allocator();
+    struct aws_byte_cursor input =
+        aws_byte_cursor_from_c_str("max-age=0,no-cache,no-store,must-revalidate,private,proxy-revalidate,s-maxage=60");
+
+    struct aws_array_list output;
+    if (aws_array_list_init_dynamic(&output, allocator, 16, sizeof(struct aws_byte_cursor))) {
+        abort();
+    }
+
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < iterations; ++i) {
+        aws_array_list_clear(&output);
+        if (aws_byte_cursor_split_on_char(&input, ',', &output)) {
+            abort();
+        }
+        AWS_BENCHMARK_CONSUME(aws_array_list_length(&output));
+    }
+    aws_benchmark_report("split_on_char/cache-control", aws_benchmark_now() - start, iterations, 0);
+
+    aws_array_list_clean_up(&output);
+}
+
+int main(void) {
+    const size_t sizes[] = {16, 64, 256, 4096, 65536};
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(sizes); ++i) {
+        size_t iterations = (64 * 1024 * 1024) / sizes[i];
+        s_bench_input_size(sizes[i], iterations > 1000000 ? 1000000 : iterations);
+    }
+
+    s_bench_split(1000000);
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/clock.h>
+
+#include "benchmark_harness.h"
+
+/*
+ * Per-call cost of each way of reading the time.
+ */
+
+#define ITERATIONS 5000000
+
+static void s_bench_high_res_clock(void) {
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        uint64_t now = 0;
+        aws_high_res_clock_get_ticks(&now);
+        AWS_BENCHMARK_CONSUME(now);
+    }
+    aws_benchmark_report("high_res_clock_get_ticks", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_sys_clock(void) {
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        uint64_t now = 0;
+        aws_sys_clock_get_ticks(&now);
+        AWS_BENCHMARK_CONSUME(now);
+    }
+    aws_benchmark_report("sys_clock_get_ticks", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_sys_clock_coarse(void) {
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        uint64_t now = 0;
+        aws_sys_clock_get_ticks_coarse(&now);
+        AWS_BENCHMARK_CONSUME(now);
+    }
+    aws_benchmark_report("sys_clock_get_ticks_coarse", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_sys_clock_cached(void) {
+    aws_sys_clock_cache_refresh();
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        uint64_t now = 0;
+        aws_sys_clock_get_ticks_cached(&now);
+        AWS_BENCHMARK_CONSUME(now);
+    }
+    aws_benchmark_report("sys_clock_get_ticks_cached", aws_benchmark_now() - start, ITERATIONS, 0);
+    aws_sys_clock_cache_clear();
+}
+
+static void s_bench_fast_clock(void) {
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        AWS_BENCHMARK_CONSUME(aws_fast_clock_get_ticks());
+    }
+    aws_benchmark_report("fast_clock_get_ticks", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_fast_clock_to_ns(void) {
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        AWS_BENCHMARK_CONSUME(aws_fast_clock_ticks_to_ns(aws_fast_clock_get_ticks()));
+    }
+    aws_benchmark_report("fast_clock_get_ticks+ticks_to_ns", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+int main(void) {
+    printf(
+        "fast clock: %s, %llu ticks/s\n",
+        aws_fast_clock_is_hardware_counter() ? "hardware counter" : "high res clock fallback",
+        (unsigned long long)aws_fast_clock_get_frequency());
+
+    s_bench_high_res_clock();
+    s_bench_sys_clock();
+    s_bench_sys_clock_coarse();
+    s_bench_sys_clock_cached();
+    s_bench_fast_clock();
+    s_bench_fast_clock_to_ns();
+    return 0;
+}
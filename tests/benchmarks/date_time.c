@@ -0,0 +1,139 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/byte_buf.h>
+#include <aws/common/date_time.h>
+
+#include "benchmark_harness.h"
+
+/*
+ * Cost of initializing an aws_date_time, and of reading broken-down fields from one.
+ */
+
+#define ITERATIONS 1000000
+
+static void s_bench_init_epoch_secs(void) {
+    struct aws_date_time dt;
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        aws_date_time_init_epoch_secs(&dt, 1540000000.0 + (double)i);
+        AWS_BENCHMARK_CONSUME(dt.timestamp);
+    }
+    aws_benchmark_report("date_time_init_epoch_secs", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_init_now(void) {
+    struct aws_date_time dt;
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        aws_date_time_init_now(&dt);
+        AWS_BENCHMARK_CONSUME(dt.timestamp);
+    }
+    aws_benchmark_report("date_time_init_now", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_init_and_read_gmt(void) {
+    struct aws_date_time dt;
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        aws_date_time_init_epoch_secs(&dt, 1540000000.0 + (double)i);
+        AWS_BENCHMARK_CONSUME(aws_date_time_hour(&dt, false));
+    }
+    aws_benchmark_report("date_time_init+gmt_hour", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_init_and_read_local(void) {
+    struct aws_date_time dt;
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        aws_date_time_init_epoch_secs(&dt, 1540000000.0 + (double)i);
+        AWS_BENCHMARK_CONSUME(aws_date_time_hour(&dt, true));
+    }
+    aws_benchmark_report("date_time_init+local_hour", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_to_utc_str(const char *name, enum aws_date_format fmt) {
+    struct aws_date_time dt;
+    aws_date_time_init_epoch_secs(&dt, 1540000000.0);
+    uint8_t storage[AWS_DATE_TIME_STR_MAX_LEN];
+    struct aws_byte_buf output = aws_byte_buf_from_empty_array(storage, sizeof(storage));
+
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        aws_date_time_to_utc_time_str(&dt, fmt, &output);
+        AWS_BENCHMARK_CONSUME(output.len);
+    }
+    aws_benchmark_report(name, aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_to_utc_str_with_millis(void) {
+    struct aws_date_time dt;
+    aws_date_time_init_epoch_millis(&dt, 1540000000123);
+    uint8_t storage[AWS_DATE_TIME_STR_MAX_LEN];
+    struct aws_byte_buf output = aws_byte_buf_from_empty_array(storage, sizeof(storage));
+
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        aws_date_time_to_utc_time_str_with_fraction(&dt, AWS_DATE_FORMAT_ISO_8601, 3, &output);
+        AWS_BENCHMARK_CONSUME(output.len);
+    }
+    aws_benchmark_report("to_utc_time_str_with_fraction/iso8601/3", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_str_cache(void) {
+    struct aws_date_time dt;
+    struct aws_date_time_str_cache cache;
+    struct aws_byte_cursor output;
+    aws_date_time_str_cache_init(&cache, AWS_DATE_FORMAT_RFC822, false);
+
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        /* a new second every 1000 calls, like a busy server */
+        aws_date_time_init_epoch_secs(&dt, 1540000000.0 + (double)(i / 1000));
+        aws_date_time_str_cache_get_utc(&cache, &dt, &output);
+        AWS_BENCHMARK_CONSUME(output.len);
+    }
+    aws_benchmark_report("init+str_cache_get_utc/rfc822", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_parse(const char *name, const char *date, enum aws_date_format fmt) {
+    struct aws_date_time dt;
+    struct aws_byte_buf date_buf = aws_byte_buf_from_c_str(date);
+
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        aws_date_time_init_from_str(&dt, &date_buf, fmt);
+        AWS_BENCHMARK_CONSUME(dt.timestamp);
+    }
+    aws_benchmark_report(name, aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+int main(void) {
+    s_bench_init_epoch_secs();
+    s_bench_init_now();
+    s_bench_init_and_read_gmt();
+    s_bench_init_and_read_local();
+    s_bench_to_utc_str("to_utc_time_str/rfc822", AWS_DATE_FORMAT_RFC822);
+    s_bench_to_utc_str("to_utc_time_str/iso8601", AWS_DATE_FORMAT_ISO_8601);
+    s_bench_to_utc_str("to_utc_time_str/iso8601_basic", AWS_DATE_FORMAT_ISO_8601_BASIC);
+    s_bench_to_utc_str_with_millis();
+    s_bench_str_cache();
+    s_bench_parse("init_from_str/rfc822", "Wed, 02 Oct 2002 08:05:09 GMT", AWS_DATE_FORMAT_RFC822);
+    s_bench_parse("init_from_str/iso8601", "2002-10-02T08:05:09Z", AWS_DATE_FORMAT_ISO_8601);
+    s_bench_parse("init_from_str/iso8601_millis", "2002-10-02T08:05:09.123Z", AWS_DATE_FORMAT_ISO_8601);
+    s_bench_parse("init_from_str/iso8601_basic", "20021002T080509Z", AWS_DATE_FORMAT_ISO_8601_BASIC);
+    s_bench_parse("init_from_str/auto_detect_rfc822", "Wed, 02 Oct 2002 08:05:09 GMT", AWS_DATE_FORMAT_AUTO_DETECT);
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/adaptive_mutex.h>
+#include <aws/common/mutex.h>
+#include <aws/common/thread.h>
+
+#include "benchmark_harness.h"
+
+/*
+ * Benchmarks aws_mutex against aws_adaptive_mutex guarding a very short critical section (a counter increment) with
+ * 1 to 16 threads hammering the same lock. Reported time is wall clock divided by the total number of acquisitions.
+ */
+
+#define MAX_THREADS 16
+#define OPS_PER_THREAD 500000
+
+struct bench_state {
+    struct aws_mutex mutex;
+    struct aws_adaptive_mutex adaptive_mutex;
+    volatile uint64_t counter;
+};
+
+static void s_mutex_thread_fn(void *arg) {
+    struct bench_state *state = arg;
+    for (size_t i = 0; i < OPS_PER_THREAD; ++i) {
+        aws_mutex_lock(&state->mutex);
+        state->counter++;
+        aws_mutex_unlock(&state->mutex);
+    }
+}
+
+static void s_adaptive_mutex_thread_fn(void *arg) {
+    struct bench_state *state = arg;
+    for (size_t i = 0; i < OPS_PER_THREAD; ++i) {
+        aws_adaptive_mutex_lock(&state->adaptive_mutex);
+        state->counter++;
+        aws_adaptive_mutex_unlock(&state->adaptive_mutex);
+    }
+}
+
+static void s_run(const char *label, void (*thread_fn)(void *), struct bench_state *state, size_t thread_count) {
+    struct aws_allocator *alloc = aws_default_allocator();
+    struct aws_thread threads[MAX_THREADS];
+    char name[96];
+
+    state->counter = 0;
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < thread_count; ++i) {
+        aws_thread_init(&threads[i], alloc);
+        aws_thread_launch(&threads[i], thread_fn, state, NULL);
+    }
+    for (size_t i = 0; i < thread_count; ++i) {
+        aws_thread_join(&threads[i]);
+        aws_thread_clean_up(&threads[i]);
+    }
+    uint64_t elapsed = aws_benchmark_now() - start;
+
+    if (state->counter != (uint64_t)thread_count * OPS_PER_THREAD) {
+        fprintf(stderr, "%s lost increments\n", label);
+        abort();
+    }
+
+    snprintf(name, sizeof(name), "%s/threads/%zu", label, thread_count);
+    aws_benchmark_report(name, elapsed, state->counter, 0);
+}
+
+int main(void) {
+    struct bench_state state;
+    AWS_ZERO_STRUCT(state);
+    aws_mutex_init(&state.mutex);
+    aws_adaptive_mutex_init(&state.adaptive_mutex);
+
+    for (size_t thread_count = 1; thread_count <= MAX_THREADS; thread_count *= 2) {
+        s_run("mutex", s_mutex_thread_fn, &state, thread_count);
+        s_run("adaptive_mutex", s_adaptive_mutex_thread_fn, &state, thread_count);
+    }
+
+    aws_adaptive_mutex_clean_up(&state.adaptive_mutex);
+    aws_mutex_clean_up(&state.mutex);
+    return 0;
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/priority_queue.h>
+#include <aws/common/typed_heap.h>
+
+#include "benchmark_harness.h"
+
+/*
+ * Benchmarks aws_priority_queue against an AWS_TYPED_HEAP_DEFINE heap holding the same scheduler-like elements
+ * (a timestamp and a pointer), for bulk push then pop, a steady-state push/pop mix, and push_ref followed by
+ * removal through backpointers. aws_priority_queue is also measured building with push_batch and draining with
+ * pop_up_to.
+ */
+
+struct bench_item {
+    uint64_t timestamp;
+    void *payload;
+};
+
+static int s_compare_items(const void *a, const void *b) {
+    const struct bench_item *item_a = a;
+    const struct bench_item *item_b = b;
+    return item_a->timestamp > item_b->timestamp;
+}
+
+static bool s_item_earlier(const struct bench_item *a, const struct bench_item *b) {
+    return a->timestamp < b->timestamp;
+}
+
+AWS_TYPED_HEAP_DEFINE(bench_heap, struct bench_item, s_item_earlier)
+
+static uint64_t s_rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t s_next_random(void) {
+    /* xorshift64 */
+    s_rng_state ^= s_rng_state << 13;
+    s_rng_state ^= s_rng_state >> 7;
+    s_rng_state ^= s_rng_state << 17;
+    return s_rng_state;
+}
+
+static void s_bench_priority_queue(struct aws_allocator *alloc, size_t count, struct aws_priority_queue_node *nodes) {
+    char name[96];
+    struct aws_priority_queue queue;
+    struct bench_item item = {0, NULL};
+
+    aws_priority_queue_init_dynamic(&queue, alloc, 16, sizeof(struct bench_item), s_compare_items);
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < count; ++i) {
+        item.timestamp = s_next_random();
+        aws_priority_queue_push(&queue, &item);
+    }
+    while (aws_priority_queue_size(&queue)) {
+        aws_priority_queue_pop(&queue, &item);
+        AWS_BENCHMARK_CONSUME(item.timestamp);
+    }
+    snprintf(name, sizeof(name), "priority_queue/push_pop/%zu", count);
+    aws_benchmark_report(name, aws_benchmark_now() - start, count, 0);
+
+    for (size_t i = 0; i < count; ++i) {
+        item.timestamp = s_next_random();
+        aws_priority_queue_push(&queue, &item);
+    }
+    start = aws_benchmark_now();
+    for (size_t i = 0; i < count; ++i) {
+        aws_priority_queue_pop(&queue, &item);
+        item.timestamp += s_next_random() >> 40;
+        aws_priority_queue_push(&queue, &item);
+    }
+    snprintf(name, sizeof(name), "priority_queue/steady_mix/%zu", count);
+    aws_benchmark_report(name, aws_benchmark_now() - start, count, 0);
+    aws_priority_queue_clean_up(&queue);
+
+    aws_priority_queue_init_dynamic(&queue, alloc, 16, sizeof(struct bench_item), s_compare_items);
+    start = aws_benchmark_now();
+    for (size_t i = 0; i < count; ++i) {
+        item.timestamp = s_next_random();
+        aws_priority_queue_push_ref(&queue, &item, &nodes[i]);
+    }
+    for (size_t i = 0; i < count; i += 2) {
+        aws_priority_queue_remove(&queue, &item, &nodes[i]);
+    }
+    while (aws_priority_queue_size(&queue)) {
+        aws_priority_queue_pop(&queue, &item);
+        AWS_BENCHMARK_CONSUME(item.timestamp);
+    }
+    snprintf(name, sizeof(name), "priority_queue/push_ref_remove/%zu", count);
+    aws_benchmark_report(name, aws_benchmark_now() - start, count, 0);
+    aws_priority_queue_clean_up(&queue);
+
+    /* bulk build and threshold drain of the same number of items as push_pop above */
+    struct bench_item *batch = aws_mem_acquire(alloc, count * sizeof(*batch));
+    for (size_t i = 0; i < count; ++i) {
+        batch[i].timestamp = s_next_random();
+        batch[i].payload = NULL;
+    }
+    struct aws_array_list drained;
+    aws_array_list_init_dynamic(&drained, alloc, count, sizeof(struct bench_item));
+    aws_priority_queue_init_dynamic(&queue, alloc, 16, sizeof(struct bench_item), s_compare_items);
+    start = aws_benchmark_now();
+    aws_priority_queue_push_batch(&queue, batch, count);
+    item.timestamp = UINT64_MAX;
+    aws_priority_queue_pop_up_to(&queue, &item, &drained);
+    AWS_BENCHMARK_CONSUME(aws_array_list_length(&drained));
+    snprintf(name, sizeof(name), "priority_queue/push_batch_pop_up_to/%zu", count);
+    aws_benchmark_report(name, aws_benchmark_now() - start, count, 0);
+    aws_mem_release(alloc, batch);
+    aws_priority_queue_clean_up(&queue);
+    aws_array_list_clean_up(&drained);
+}
+
+static void s_bench_typed_heap(struct aws_allocator *alloc, size_t count, struct aws_priority_queue_node *nodes) {
+    char name[96];
+    struct bench_heap heap;
+    struct bench_item item = {0, NULL};
+
+    bench_heap_init(&heap, alloc, 16);
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < count; ++i) {
+        item.timestamp = s_next_random();
+        bench_heap_push(&heap, item);
+    }
+    while (bench_heap_size(&heap)) {
+        bench_heap_pop(&heap, &item);
+        AWS_BENCHMARK_CONSUME(item.timestamp);
+    }
+    snprintf(name, sizeof(name), "typed_heap/push_pop/%zu", count);
+    aws_benchmark_report(name, aws_benchmark_now() - start, count, 0);
+
+    for (size_t i = 0; i < count; ++i) {
+        item.timestamp = s_next_random();
+        bench_heap_push(&heap, item);
+    }
+    start = aws_benchmark_now();
+    for (size_t i = 0; i < count; ++i) {
+        bench_heap_pop(&heap, &item);
+        item.timestamp += s_next_random() >> 40;
+        bench_heap_push(&heap, item);
+    }
+    snprintf(name, sizeof(name), "typed_heap/steady_mix/%zu", count);
+    aws_benchmark_report(name, aws_benchmark_now() - start, count, 0);
+    bench_heap_clean_up(&heap);
+
+    bench_heap_init(&heap, alloc, 16);
+    start = aws_benchmark_now();
+    for (size_t i = 0; i < count; ++i) {
+        item.timestamp = s_next_random();
+        bench_heap_push_ref(&heap, item, &nodes[i]);
+    }
+    for (size_t i = 0; i < count; i += 2) {
+        bench_heap_remove(&heap, &item, &nodes[i]);
+    }
+    while (bench_heap_size(&heap)) {
+        bench_heap_pop(&heap, &item);
+        AWS_BENCHMARK_CONSUME(item.timestamp);
+    }
+    snprintf(name, sizeof(name), "typed_heap/push_ref_remove/%zu", count);
+    aws_benchmark_report(name, aws_benchmark_now() - start, count, 0);
+    bench_heap_clean_up(&heap);
+}
+
+int main(void) {
+    struct aws_allocator *alloc = aws_default_allocator();
+    const size_t counts[] = {1000, 100000, 1000000};
+
+    for (size_t c = 0; c < AWS_ARRAY_SIZE(counts); ++c) {
+        struct aws_priority_queue_node *nodes = aws_mem_acquire(alloc, counts[c] * sizeof(*nodes));
+        if (!nodes) {
+            return 1;
+        }
+
+        s_bench_priority_queue(alloc, counts[c], nodes);
+        s_bench_typed_heap(alloc, counts[c], nodes);
+
+        aws_mem_release(alloc, nodes);
+    }
+
+    return 0;
+}
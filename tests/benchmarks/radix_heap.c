@@ -0,0 +1,138 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/priority_queue.h>
+#include <aws/common/radix_heap.h>
+
+#include "benchmark_harness.h"
+
+/*
+ * Benchmarks aws_radix_heap against aws_priority_queue as a timer queue with 10^5 to 10^7 pending timers. The queue
+ * holds pointers to timers, as aws_task_scheduler does. Each operation pops the earliest timer, advances "now" to its
+ * deadline and re-arms it a random delay later; every 8th operation also cancels a pending timer and re-arms it.
+ */
+
+struct bench_timer {
+    struct aws_radix_heap_node radix_node;
+    struct aws_priority_queue_node queue_node;
+    uint64_t deadline;
+};
+
+static int s_compare_timers(const void *a, const void *b) {
+    const struct bench_timer *timer_a = *(const struct bench_timer *const *)a;
+    const struct bench_timer *timer_b = *(const struct bench_timer *const *)b;
+    return timer_a->deadline > timer_b->deadline;
+}
+
+static uint64_t s_rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t s_next_random(void) {
+    /* xorshift64 */
+    s_rng_state ^= s_rng_state << 13;
+    s_rng_state ^= s_rng_state >> 7;
+    s_rng_state ^= s_rng_state << 17;
+    return s_rng_state;
+}
+
+/* up to ~1 second of nanoseconds */
+static uint64_t s_next_delay(void) {
+    return s_next_random() >> 34;
+}
+
+static void s_bench_priority_queue(
+    struct aws_allocator *alloc,
+    struct bench_timer *timers,
+    size_t count,
+    size_t operations) {
+    char name[96];
+    struct aws_priority_queue queue;
+    aws_priority_queue_init_dynamic(&queue, alloc, count, sizeof(struct bench_timer *), s_compare_timers);
+
+    for (size_t i = 0; i < count; ++i) {
+        struct bench_timer *timer = &timers[i];
+        timer->deadline = s_next_delay();
+        aws_priority_queue_push_ref(&queue, &timer, &timer->queue_node);
+    }
+
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < operations; ++i) {
+        struct bench_timer *timer = NULL;
+        aws_priority_queue_pop(&queue, &timer);
+        uint64_t now = timer->deadline;
+        timer->deadline = now + s_next_delay();
+        aws_priority_queue_push_ref(&queue, &timer, &timer->queue_node);
+
+        if ((i & 7) == 0) {
+            struct bench_timer *cancelled = &timers[s_next_random() % count];
+            aws_priority_queue_remove(&queue, &timer, &cancelled->queue_node);
+            cancelled->deadline = now + s_next_delay();
+            aws_priority_queue_push_ref(&queue, &cancelled, &cancelled->queue_node);
+        }
+    }
+    snprintf(name, sizeof(name), "priority_queue/timers/%zu", count);
+    aws_benchmark_report(name, aws_benchmark_now() - start, operations, 0);
+
+    aws_priority_queue_clean_up(&queue);
+}
+
+static void s_bench_radix_heap(struct bench_timer *timers, size_t count, size_t operations) {
+    char name[96];
+    struct aws_radix_heap heap;
+    aws_radix_heap_init(&heap, 0);
+
+    for (size_t i = 0; i < count; ++i) {
+        timers[i].deadline = s_next_delay();
+        aws_radix_heap_push(&heap, &timers[i].radix_node, timers[i].deadline);
+    }
+
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < operations; ++i) {
+        struct aws_radix_heap_node *node = NULL;
+        aws_radix_heap_pop(&heap, &node);
+        struct bench_timer *timer = AWS_CONTAINER_OF(node, struct bench_timer, radix_node);
+        uint64_t now = timer->deadline;
+        timer->deadline = now + s_next_delay();
+        aws_radix_heap_push(&heap, &timer->radix_node, timer->deadline);
+
+        if ((i & 7) == 0) {
+            struct bench_timer *cancelled = &timers[s_next_random() % count];
+            aws_radix_heap_remove(&heap, &cancelled->radix_node);
+            cancelled->deadline = now + s_next_delay();
+            aws_radix_heap_push(&heap, &cancelled->radix_node, cancelled->deadline);
+        }
+    }
+    snprintf(name, sizeof(name), "radix_heap/timers/%zu", count);
+    aws_benchmark_report(name, aws_benchmark_now() - start, operations, 0);
+}
+
+int main(void) {
+    struct aws_allocator *alloc = aws_default_allocator();
+    const size_t counts[] = {100000, 1000000, 10000000};
+    const size_t operations = 2000000;
+
+    for (size_t c = 0; c < AWS_ARRAY_SIZE(counts); ++c) {
+        struct bench_timer *timers = aws_mem_acquire(alloc, counts[c] * sizeof(*timers));
+        if (!timers) {
+            return 1;
+        }
+
+        s_bench_priority_queue(alloc, timers, counts[c], operations);
+        s_bench_radix_heap(timers, counts[c], operations);
+
+        aws_mem_release(alloc, timers);
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/device_random.h>
+#include <aws/common/prng.h>
+#include <aws/common/uuid.h>
+
+#include "benchmark_harness.h"
+
+/*
+ * Per-call cost of random numbers from the operating system, from the per-thread buffer, and from the PRNG.
+ */
+
+#define ITERATIONS 1000000
+
+static void s_bench_device_random_u32(const char *name) {
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        uint32_t value = 0;
+        aws_device_random_u32(&value);
+        AWS_BENCHMARK_CONSUME(value);
+    }
+    aws_benchmark_report(name, aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_uuid_init(const char *name) {
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        struct aws_uuid uuid;
+        aws_uuid_init(&uuid);
+        AWS_BENCHMARK_CONSUME(uuid.uuid_data[0]);
+    }
+    aws_benchmark_report(name, aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_prng(void) {
+    struct aws_prng prng;
+    aws_prng_init(&prng);
+
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        AWS_BENCHMARK_CONSUME(aws_prng_next_u64(&prng));
+    }
+    aws_benchmark_report("prng_next_u64", aws_benchmark_now() - start, ITERATIONS, 0);
+
+    start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        AWS_BENCHMARK_CONSUME(aws_prng_next_bounded(aws_prng_thread_local(), 1000));
+    }
+    aws_benchmark_report("prng_thread_local+next_bounded", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+int main(void) {
+    s_bench_device_random_u32("device_random_u32");
+    s_bench_uuid_init("uuid_init");
+
+    aws_device_random_set_buffered(true);
+    s_bench_device_random_u32("device_random_u32/buffered");
+    s_bench_uuid_init("uuid_init/buffered");
+    aws_device_random_set_buffered(false);
+
+    s_bench_prng();
+    return 0;
+}
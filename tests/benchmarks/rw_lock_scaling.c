@@ -0,0 +1,118 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/rw_lock.h>
+#include <aws/common/scalable_rw_lock.h>
+#include <aws/common/thread.h>
+
+#include "benchmark_harness.h"
+
+/*
+ * Benchmarks aws_rw_lock against aws_scalable_rw_lock guarding a small read-mostly cache with 1 to 64 threads. One
+ * operation in 1000 is a write. Reported time is wall clock divided by the total number of operations, so a lock that
+ * scales keeps the per-operation time falling as threads are added, up to the number of cores.
+ */
+
+#define MAX_THREADS 64
+#define OPS_PER_THREAD 200000
+#define WRITE_EVERY 1000
+
+struct bench_state {
+    struct aws_rw_lock rw_lock;
+    struct aws_scalable_rw_lock scalable_rw_lock;
+    volatile uint64_t cached[4];
+};
+
+static void s_read(struct bench_state *state) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(state->cached); ++i) {
+        sum += state->cached[i];
+    }
+    AWS_BENCHMARK_CONSUME(sum);
+}
+
+static void s_write(struct bench_state *state) {
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(state->cached); ++i) {
+        state->cached[i]++;
+    }
+}
+
+static void s_rw_lock_thread_fn(void *arg) {
+    struct bench_state *state = arg;
+    for (size_t i = 1; i <= OPS_PER_THREAD; ++i) {
+        if (i % WRITE_EVERY == 0) {
+            aws_rw_lock_wlock(&state->rw_lock);
+            s_write(state);
+            aws_rw_lock_wunlock(&state->rw_lock);
+        } else {
+            aws_rw_lock_rlock(&state->rw_lock);
+            s_read(state);
+            aws_rw_lock_runlock(&state->rw_lock);
+        }
+    }
+}
+
+static void s_scalable_rw_lock_thread_fn(void *arg) {
+    struct bench_state *state = arg;
+    for (size_t i = 1; i <= OPS_PER_THREAD; ++i) {
+        if (i % WRITE_EVERY == 0) {
+            aws_scalable_rw_lock_wlock(&state->scalable_rw_lock);
+            s_write(state);
+            aws_scalable_rw_lock_wunlock(&state->scalable_rw_lock);
+        } else {
+            aws_scalable_rw_lock_rlock(&state->scalable_rw_lock);
+            s_read(state);
+            aws_scalable_rw_lock_runlock(&state->scalable_rw_lock);
+        }
+    }
+}
+
+static void s_run(const char *label, void (*thread_fn)(void *), struct bench_state *state, size_t thread_count) {
+    struct aws_allocator *alloc = aws_default_allocator();
+    struct aws_thread threads[MAX_THREADS];
+    char name[96];
+
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < thread_count; ++i) {
+        aws_thread_init(&threads[i], alloc);
+        aws_thread_launch(&threads[i], thread_fn, state, NULL);
+    }
+    for (size_t i = 0; i < thread_count; ++i) {
+        aws_thread_join(&threads[i]);
+        aws_thread_clean_up(&threads[i]);
+    }
+    uint64_t elapsed = aws_benchmark_now() - start;
+
+    snprintf(name, sizeof(name), "%s/threads/%zu", label, thread_count);
+    aws_benchmark_report(name, elapsed, (uint64_t)thread_count * OPS_PER_THREAD, 0);
+}
+
+int main(void) {
+    struct bench_state state;
+    AWS_ZERO_STRUCT(state);
+    aws_rw_lock_init(&state.rw_lock);
+    if (aws_scalable_rw_lock_init(&state.scalable_rw_lock, aws_default_allocator())) {
+        return 1;
+    }
+
+    for (size_t thread_count = 1; thread_count <= MAX_THREADS; thread_count *= 2) {
+        s_run("rw_lock", s_rw_lock_thread_fn, &state, thread_count);
+        s_run("scalable_rw_lock", s_scalable_rw_lock_thread_fn, &state, thread_count);
+    }
+
+    aws_scalable_rw_lock_clean_up(&state.scalable_rw_lock);
+    aws_rw_lock_clean_up(&state.rw_lock);
+    return 0;
+}
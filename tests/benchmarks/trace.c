@@ -0,0 +1,58 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/trace.h>
+
+#include "benchmark_harness.h"
+
+/*
+ * Per-event cost of a trace point with tracing disabled and enabled, and of dumping a full ring as JSON.
+ */
+
+#define ITERATIONS 10000000
+#define RING_SIZE 65536
+
+static void s_bench_trace_point(const char *name) {
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        AWS_TRACE_EVENT(AWS_TRACE_EVENT_USER_FIRST, i, 0);
+    }
+    aws_benchmark_report(name, aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+int main(void) {
+    struct aws_allocator *alloc = aws_default_allocator();
+    if (aws_trace_init(alloc, RING_SIZE) ||
+        aws_trace_register_event(AWS_TRACE_EVENT_USER_FIRST, "bench", AWS_TRACE_PHASE_INSTANT)) {
+        return 1;
+    }
+
+    s_bench_trace_point("trace_point_disabled");
+
+    aws_trace_set_enabled(true);
+    s_bench_trace_point("trace_point_enabled");
+    aws_trace_set_enabled(false);
+
+    struct aws_byte_buf json;
+    uint64_t start = aws_benchmark_now();
+    if (aws_trace_dump_json(&json, alloc)) {
+        return 1;
+    }
+    aws_benchmark_report("trace_dump_json (per event)", aws_benchmark_now() - start, RING_SIZE, 0);
+    aws_byte_buf_clean_up(&json);
+
+    aws_trace_clean_up();
+    return 0;
+}
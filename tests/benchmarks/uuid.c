@@ -0,0 +1,118 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/byte_buf.h>
+#include <aws/common/uuid.h>
+
+#include "benchmark_harness.h"
+
+/*
+ * Per-UUID cost of formatting and parsing UUID strings, and of making time-ordered UUIDs and ULIDs.
+ */
+
+#define ITERATIONS 2000000
+#define BATCH_SIZE 64
+
+static void s_bench_to_str(const struct aws_uuid *uuid) {
+    uint8_t storage[AWS_UUID_STR_LEN] = {0};
+    struct aws_byte_buf output = aws_byte_buf_from_empty_array(storage, sizeof(storage));
+
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        output.len = 0;
+        aws_uuid_to_str(uuid, &output);
+        AWS_BENCHMARK_CONSUME(output.buffer[i % AWS_UUID_STR_LEN]);
+    }
+    aws_benchmark_report("uuid_to_str", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_init_from_str(const struct aws_uuid *uuid) {
+    uint8_t storage[AWS_UUID_STR_LEN] = {0};
+    struct aws_byte_buf str = aws_byte_buf_from_empty_array(storage, sizeof(storage));
+    aws_uuid_to_str(uuid, &str);
+    struct aws_byte_cursor cursor = aws_byte_cursor_from_buf(&str);
+
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        struct aws_uuid parsed;
+        aws_uuid_init_from_str(&parsed, &cursor);
+        AWS_BENCHMARK_CONSUME(parsed.uuid_data[i % sizeof(parsed.uuid_data)]);
+    }
+    aws_benchmark_report("uuid_init_from_str", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_array_to_str(void) {
+    struct aws_uuid uuids[BATCH_SIZE];
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        aws_uuid_init(&uuids[i]);
+    }
+    static uint8_t s_storage[BATCH_SIZE * (AWS_UUID_STR_LEN - 1)];
+    struct aws_byte_buf output = aws_byte_buf_from_empty_array(s_storage, sizeof(s_storage));
+
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS / BATCH_SIZE; ++i) {
+        output.len = 0;
+        aws_uuid_array_to_str(uuids, BATCH_SIZE, &output);
+        AWS_BENCHMARK_CONSUME(s_storage[i % sizeof(s_storage)]);
+    }
+    aws_benchmark_report("uuid_array_to_str (per uuid)", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_init_v7(void) {
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        struct aws_uuid uuid;
+        aws_uuid_init_v7(&uuid);
+        AWS_BENCHMARK_CONSUME(uuid.uuid_data[15]);
+    }
+    aws_benchmark_report("uuid_init_v7", aws_benchmark_now() - start, ITERATIONS, 0);
+
+    struct aws_uuid uuids[BATCH_SIZE];
+    start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS / BATCH_SIZE; ++i) {
+        aws_uuid_init_v7_batch(uuids, BATCH_SIZE);
+        AWS_BENCHMARK_CONSUME(uuids[i % BATCH_SIZE].uuid_data[15]);
+    }
+    aws_benchmark_report("uuid_init_v7_batch (per uuid)", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+static void s_bench_ulid(void) {
+    uint8_t storage[AWS_ULID_STR_LEN] = {0};
+    struct aws_byte_buf output = aws_byte_buf_from_empty_array(storage, sizeof(storage));
+
+    uint64_t start = aws_benchmark_now();
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        struct aws_ulid ulid;
+        aws_ulid_init(&ulid);
+        output.len = 0;
+        aws_ulid_to_str(&ulid, &output);
+        AWS_BENCHMARK_CONSUME(storage[i % AWS_ULID_STR_LEN]);
+    }
+    aws_benchmark_report("ulid_init+to_str", aws_benchmark_now() - start, ITERATIONS, 0);
+}
+
+int main(void) {
+    struct aws_uuid uuid;
+    if (aws_uuid_init(&uuid)) {
+        return 1;
+    }
+
+    s_bench_to_str(&uuid);
+    s_bench_init_from_str(&uuid);
+    s_bench_array_to_str();
+    s_bench_init_v7();
+    s_bench_ulid();
+    return 0;
+}
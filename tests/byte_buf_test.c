@@ -17,6 +17,8 @@
 
 #include <aws/testing/aws_test_harness.h>
 
+#include <ctype.h>
+
 AWS_TEST_CASE(test_buffer_cat, s_test_buffer_cat_fn)
 static int s_test_buffer_cat_fn(struct aws_allocator *allocator, void *ctx) {
     (void)ctx;
@@ -256,7 +258,7 @@ static int s_test_buffer_advance(struct aws_allocator *allocator, void *ctx) {
     (void)ctx;
     (void)allocator;
 
-    uint8_t arr[16];
+    uint8_t arr[16] = {0};
     struct aws_byte_buf src_buf = aws_byte_buf_from_array(arr, sizeof(arr));
 
     struct aws_byte_buf dst_buf;
@@ -415,3 +417,55 @@ static int s_test_cursor_hash_case_insensitive(struct aws_allocator *allocator,
 
     return 0;
 }
+
+static uint64_t s_reference_hash_case_insensitive(const uint8_t *ptr, size_t len) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= (uint8_t)tolower(ptr[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+AWS_TEST_CASE(test_cursor_case_insensitive_all_lengths, s_test_cursor_case_insensitive_all_lengths)
+static int s_test_cursor_case_insensitive_all_lengths(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    (void)allocator;
+
+    /*
+     * Exercise every length through the vectorized, word-at-a-time, and per-byte paths, using every byte value
+     * so that bytes next to the letter ranges ('@', '[', '`', '{') and high bytes are covered too.
+     */
+    uint8_t a_src[300];
+    uint8_t b_src[300];
+    for (size_t i = 0; i < sizeof(a_src); ++i) {
+        a_src[i] = (uint8_t)(i * 7);
+        b_src[i] = (uint8_t)toupper(a_src[i]);
+    }
+
+    for (size_t len = 0; len <= sizeof(a_src); ++len) {
+        struct aws_byte_cursor a = aws_byte_cursor_from_array(a_src, len);
+        struct aws_byte_cursor b = aws_byte_cursor_from_array(b_src, len);
+        ASSERT_TRUE(aws_byte_cursor_eq_case_insensitive(&a, &b));
+
+        uint64_t expected_hash = s_reference_hash_case_insensitive(a_src, len);
+        ASSERT_UINT_EQUALS(expected_hash, aws_hash_byte_cursor_ptr_case_insensitive(&a));
+        ASSERT_UINT_EQUALS(expected_hash, aws_hash_byte_cursor_ptr_case_insensitive(&b));
+    }
+
+    /* A single differing byte anywhere must be detected */
+    for (size_t len = 1; len <= 100; ++len) {
+        for (size_t diff = 0; diff < len; ++diff) {
+            uint8_t saved = b_src[diff];
+            b_src[diff] = (uint8_t)(b_src[diff] ^ 0x01);
+
+            struct aws_byte_cursor a = aws_byte_cursor_from_array(a_src, len);
+            struct aws_byte_cursor b = aws_byte_cursor_from_array(b_src, len);
+            ASSERT_FALSE(aws_byte_cursor_eq_case_insensitive(&a, &b));
+
+            b_src[diff] = saved;
+        }
+    }
+
+    return 0;
+}
@@ -159,6 +159,118 @@ static int s_test_overflow_conversion(struct aws_allocator *allocator, void *ctx
     return 0;
 }
 
+static int s_test_fast_clock_increments(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    uint64_t prev = aws_fast_clock_get_ticks();
+    for (unsigned i = 0; i < 100000; ++i) {
+        uint64_t ticks = aws_fast_clock_get_ticks();
+        ASSERT_TRUE(ticks >= prev);
+        prev = ticks;
+    }
+
+    return 0;
+}
+
+static int s_test_fast_clock_conversion(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    uint64_t frequency = aws_fast_clock_get_frequency();
+    ASSERT_TRUE(frequency >= 1000000);
+    if (!aws_fast_clock_is_hardware_counter()) {
+        ASSERT_UINT_EQUALS(1000000000, frequency);
+    }
+
+    ASSERT_UINT_EQUALS(0, aws_fast_clock_ticks_to_ns(0));
+    ASSERT_UINT_EQUALS(1000000000, aws_fast_clock_ticks_to_ns(frequency));
+    ASSERT_UINT_EQUALS(3600000000000, aws_fast_clock_ticks_to_ns(frequency * 3600));
+    /* a calibrated frequency can be odd, so half of it may round down by a nanosecond */
+    uint64_t half_second = aws_fast_clock_ticks_to_ns(frequency / 2);
+    ASSERT_TRUE(half_second == 500000000 || half_second == 499999999);
+    /* large readings, as after a long uptime, must not overflow on the way */
+    ASSERT_TRUE(aws_fast_clock_ticks_to_ns(UINT64_MAX / 2) < aws_fast_clock_ticks_to_ns(UINT64_MAX));
+
+    return 0;
+}
+
+/* Times a sleep with both clocks. The tolerance covers calibration error and the gap between the paired reads. */
+static int s_test_fast_clock_accuracy(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    /* calibrate before timing anything */
+    aws_fast_clock_get_ticks();
+
+    uint64_t high_res_start = 0;
+    uint64_t high_res_end = 0;
+    ASSERT_SUCCESS(aws_high_res_clock_get_ticks(&high_res_start));
+    uint64_t fast_start = aws_fast_clock_get_ticks();
+
+    aws_thread_current_sleep(100000000);
+
+    ASSERT_SUCCESS(aws_high_res_clock_get_ticks(&high_res_end));
+    uint64_t fast_end = aws_fast_clock_get_ticks();
+
+    uint64_t high_res_elapsed = high_res_end - high_res_start;
+    uint64_t fast_elapsed = aws_fast_clock_ticks_to_ns(fast_end - fast_start);
+    uint64_t difference =
+        fast_elapsed > high_res_elapsed ? fast_elapsed - high_res_elapsed : high_res_elapsed - fast_elapsed;
+
+    ASSERT_TRUE(
+        difference <= high_res_elapsed / 50 + 1000000,
+        "fast clock measured %llu ns, high res clock %llu ns",
+        (long long unsigned int)fast_elapsed,
+        (long long unsigned int)high_res_elapsed);
+
+    return 0;
+}
+
+static int s_test_sys_clock_coarse(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    uint64_t before = 0;
+    uint64_t coarse = 0;
+    uint64_t after = 0;
+    ASSERT_SUCCESS(aws_sys_clock_get_ticks(&before));
+    ASSERT_SUCCESS(aws_sys_clock_get_ticks_coarse(&coarse));
+    ASSERT_SUCCESS(aws_sys_clock_get_ticks(&after));
+
+    /* the coarse clock lags by up to one timer tick, which is at most 16ms on any platform we run on */
+    const uint64_t max_lag = 20000000;
+    ASSERT_TRUE(coarse + max_lag >= before);
+    ASSERT_TRUE(coarse <= after);
+
+    return 0;
+}
+
+static int s_test_sys_clock_cache(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    ASSERT_SUCCESS(aws_sys_clock_cache_refresh());
+    uint64_t first = 0;
+    uint64_t second = 0;
+    ASSERT_SUCCESS(aws_sys_clock_get_ticks_cached(&first));
+    aws_thread_current_sleep(2000000);
+    ASSERT_SUCCESS(aws_sys_clock_get_ticks_cached(&second));
+    ASSERT_UINT_EQUALS(first, second);
+
+    ASSERT_SUCCESS(aws_sys_clock_cache_refresh());
+    ASSERT_SUCCESS(aws_sys_clock_get_ticks_cached(&second));
+    ASSERT_TRUE(second > first);
+
+    /* once cleared, reads go to the clock again */
+    aws_sys_clock_cache_clear();
+    aws_thread_current_sleep(30000000);
+    ASSERT_SUCCESS(aws_sys_clock_get_ticks_cached(&first));
+    ASSERT_TRUE(first > second);
+
+    return 0;
+}
+
 AWS_TEST_CASE(high_res_clock_increments_test, s_test_high_res_clock_increments)
 AWS_TEST_CASE(sys_clock_increments_test, s_test_sys_clock_increments)
 AWS_TEST_CASE(test_sec_and_millis_conversions, s_test_sec_and_millis_conversion)
@@ -169,3 +281,8 @@ AWS_TEST_CASE(test_milli_and_nanos_conversion, s_test_milli_and_nanos_conversion
 AWS_TEST_CASE(test_micro_and_nanos_conversion, s_test_micro_and_nanos_conversion)
 AWS_TEST_CASE(test_precision_loss_remainders_conversion, s_test_precision_loss_remainders_conversion)
 AWS_TEST_CASE(test_overflow_conversion, s_test_overflow_conversion)
+AWS_TEST_CASE(fast_clock_increments_test, s_test_fast_clock_increments)
+AWS_TEST_CASE(fast_clock_conversion_test, s_test_fast_clock_conversion)
+AWS_TEST_CASE(fast_clock_accuracy_test, s_test_fast_clock_accuracy)
+AWS_TEST_CASE(sys_clock_coarse_test, s_test_sys_clock_coarse)
+AWS_TEST_CASE(sys_clock_cache_test, s_test_sys_clock_cache)
@@ -240,6 +240,160 @@ static int s_byte_cursor_limit_tests_fn(struct aws_allocator *allocator, void *c
     return 0;
 }
 
+AWS_TEST_CASE(byte_cursor_le_and_float_tests, s_byte_cursor_le_and_float_tests_fn);
+static int s_byte_cursor_le_and_float_tests_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    static const uint8_t expected[] = {
+        0x34, 0x12,                                     /* le16 */
+        0xab, 0x89, 0x67, 0x45,                         /* le32 */
+        0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, /* le64 */
+        0x10, 0x20, 0x30,                               /* be24 */
+        0x3f, 0xc0, 0x00, 0x00,                         /* float be32: 1.5 */
+        0x00, 0x00, 0xc0, 0x3f,                         /* float le32: 1.5 */
+        0xc0, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, /* float be64: -2.5 */
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0xc0, /* float le64: -2.5 */
+    };
+
+    uint8_t storage[sizeof(expected)] = {0};
+    struct aws_byte_buf buf = aws_byte_buf_from_empty_array(storage, sizeof(storage));
+
+    ASSERT_TRUE(aws_byte_buf_write_le16(&buf, 0x1234));
+    ASSERT_TRUE(aws_byte_buf_write_le32(&buf, 0x456789ab));
+    ASSERT_TRUE(aws_byte_buf_write_le64(&buf, (uint64_t)0x1122334455667788ULL));
+    ASSERT_FALSE(aws_byte_buf_write_be24(&buf, 0x1000000));
+    ASSERT_TRUE(aws_byte_buf_write_be24(&buf, 0x102030));
+    ASSERT_TRUE(aws_byte_buf_write_float_be32(&buf, 1.5f));
+    ASSERT_TRUE(aws_byte_buf_write_float_le32(&buf, 1.5f));
+    ASSERT_TRUE(aws_byte_buf_write_float_be64(&buf, -2.5));
+    ASSERT_TRUE(aws_byte_buf_write_float_le64(&buf, -2.5));
+    ASSERT_FALSE(aws_byte_buf_write_le16(&buf, 0));
+    ASSERT_BIN_ARRAYS_EQUALS(expected, sizeof(expected), buf.buffer, buf.len);
+
+    struct aws_byte_cursor cur = aws_byte_cursor_from_buf(&buf);
+    uint16_t u16 = 0;
+    uint32_t u32 = 0;
+    uint64_t u64 = 0;
+    float f32 = 0;
+    double f64 = 0;
+
+    ASSERT_TRUE(aws_byte_cursor_read_le16(&cur, &u16));
+    ASSERT_UINT_EQUALS(0x1234, u16);
+    ASSERT_TRUE(aws_byte_cursor_read_le32(&cur, &u32));
+    ASSERT_UINT_EQUALS(0x456789ab, u32);
+    ASSERT_TRUE(aws_byte_cursor_read_le64(&cur, &u64));
+    ASSERT_UINT_EQUALS((uint64_t)0x1122334455667788ULL, u64);
+    ASSERT_TRUE(aws_byte_cursor_read_be24(&cur, &u32));
+    ASSERT_UINT_EQUALS(0x102030, u32);
+    ASSERT_TRUE(aws_byte_cursor_read_float_be32(&cur, &f32));
+    ASSERT_TRUE(f32 == 1.5f);
+    ASSERT_TRUE(aws_byte_cursor_read_float_le32(&cur, &f32));
+    ASSERT_TRUE(f32 == 1.5f);
+    ASSERT_TRUE(aws_byte_cursor_read_float_be64(&cur, &f64));
+    ASSERT_TRUE(f64 == -2.5);
+    ASSERT_TRUE(aws_byte_cursor_read_float_le64(&cur, &f64));
+    ASSERT_TRUE(f64 == -2.5);
+
+    ASSERT_UINT_EQUALS(0, cur.len);
+    ASSERT_FALSE(aws_byte_cursor_read_be24(&cur, &u32));
+    ASSERT_FALSE(aws_byte_cursor_read_le16(&cur, &u16));
+
+    return 0;
+}
+
+AWS_TEST_CASE(byte_cursor_varint_tests, s_byte_cursor_varint_tests_fn);
+static int s_byte_cursor_varint_tests_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    /* Known encodings */
+    {
+        uint8_t storage[AWS_VARINT_U64_MAX_LEN] = {0};
+        struct aws_byte_buf buf = aws_byte_buf_from_empty_array(storage, sizeof(storage));
+
+        ASSERT_TRUE(aws_byte_buf_write_varint_u64(&buf, 300));
+        uint8_t expected_300[] = {0xac, 0x02};
+        ASSERT_BIN_ARRAYS_EQUALS(expected_300, sizeof(expected_300), buf.buffer, buf.len);
+
+        buf.len = 0;
+        ASSERT_TRUE(aws_byte_buf_write_varint_u64(&buf, UINT64_MAX));
+        uint8_t expected_max[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01};
+        ASSERT_BIN_ARRAYS_EQUALS(expected_max, sizeof(expected_max), buf.buffer, buf.len);
+
+        ASSERT_FALSE(aws_byte_buf_write_varint_u64(&buf, 1));
+    }
+
+    /* Round trip across every encoded length */
+    {
+        uint8_t storage[64 * AWS_VARINT_U64_MAX_LEN] = {0};
+        struct aws_byte_buf buf = aws_byte_buf_from_empty_array(storage, sizeof(storage));
+        uint64_t values[64];
+        for (size_t i = 0; i < AWS_ARRAY_SIZE(values); ++i) {
+            values[i] = ((uint64_t)1 << i) | (i & 1);
+            ASSERT_TRUE(aws_byte_buf_write_varint_u64(&buf, values[i]));
+        }
+
+        struct aws_byte_cursor cur = aws_byte_cursor_from_buf(&buf);
+        for (size_t i = 0; i < AWS_ARRAY_SIZE(values); ++i) {
+            uint64_t value = 0;
+            ASSERT_TRUE(aws_byte_cursor_read_varint_u64(&cur, &value));
+            ASSERT_UINT_EQUALS(values[i], value);
+        }
+        ASSERT_UINT_EQUALS(0, cur.len);
+
+        uint64_t bulk[64];
+        cur = aws_byte_cursor_from_buf(&buf);
+        ASSERT_UINT_EQUALS(AWS_ARRAY_SIZE(values), aws_byte_cursor_read_varint_u64_n(&cur, bulk, AWS_ARRAY_SIZE(bulk)));
+        ASSERT_BIN_ARRAYS_EQUALS(values, sizeof(values), bulk, sizeof(bulk));
+        ASSERT_UINT_EQUALS(0, cur.len);
+    }
+
+    /* Bulk decode of single byte runs mixed with longer values, stopping at a truncated value */
+    {
+        uint8_t encoded[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 0x80, 0x01, 10, 11, 12, 13, 14, 15, 16, 17, 0x80};
+        uint64_t expected[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 128, 10, 11, 12, 13, 14, 15, 16, 17};
+        uint64_t bulk[32];
+        struct aws_byte_cursor cur = aws_byte_cursor_from_array(encoded, sizeof(encoded));
+
+        ASSERT_UINT_EQUALS(
+            AWS_ARRAY_SIZE(expected), aws_byte_cursor_read_varint_u64_n(&cur, bulk, AWS_ARRAY_SIZE(bulk)));
+        ASSERT_BIN_ARRAYS_EQUALS(expected, sizeof(expected), bulk, sizeof(expected));
+        ASSERT_UINT_EQUALS(1, cur.len);
+
+        /* count limits the number of values read, even inside a run */
+        cur = aws_byte_cursor_from_array(encoded, sizeof(encoded));
+        ASSERT_UINT_EQUALS(3, aws_byte_cursor_read_varint_u64_n(&cur, bulk, 3));
+        ASSERT_PTR_EQUALS(encoded + 3, cur.ptr);
+    }
+
+    /* Malformed and truncated inputs leave the cursor unchanged */
+    {
+        uint64_t value = 42;
+
+        uint8_t truncated[] = {0x80, 0x80};
+        struct aws_byte_cursor cur = aws_byte_cursor_from_array(truncated, sizeof(truncated));
+        ASSERT_FALSE(aws_byte_cursor_read_varint_u64(&cur, &value));
+        ASSERT_UINT_EQUALS(sizeof(truncated), cur.len);
+
+        uint8_t overflow[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02};
+        cur = aws_byte_cursor_from_array(overflow, sizeof(overflow));
+        ASSERT_FALSE(aws_byte_cursor_read_varint_u64(&cur, &value));
+        ASSERT_UINT_EQUALS(sizeof(overflow), cur.len);
+
+        uint8_t too_long[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00};
+        cur = aws_byte_cursor_from_array(too_long, sizeof(too_long));
+        ASSERT_FALSE(aws_byte_cursor_read_varint_u64(&cur, &value));
+        ASSERT_UINT_EQUALS(sizeof(too_long), cur.len);
+
+        cur.len = 0;
+        ASSERT_FALSE(aws_byte_cursor_read_varint_u64(&cur, &value));
+        ASSERT_UINT_EQUALS(42, value);
+    }
+
+    return 0;
+}
+
 #define TEST_STRING "hello"
 
 static const char *s_empty = "";
@@ -353,4 +507,226 @@ static int s_test_byte_cursor_trim_basic(struct aws_allocator *allocator, void *
 
     return 0;
 }
-AWS_TEST_CASE(test_byte_cursor_trim_basic, s_test_byte_cursor_trim_basic)
\ No newline at end of file
+AWS_TEST_CASE(test_byte_cursor_trim_basic, s_test_byte_cursor_trim_basic)
+
+static int s_test_byte_cursor_find_byte(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    (void)allocator;
+
+    struct aws_byte_cursor input = aws_byte_cursor_from_c_str("x-amz-date: 20181018T000000Z");
+    struct aws_byte_cursor result;
+
+    ASSERT_TRUE(aws_byte_cursor_find_byte(&input, ':', &result));
+    ASSERT_PTR_EQUALS(input.ptr + 10, result.ptr);
+    ASSERT_UINT_EQUALS(input.len - 10, result.len);
+
+    ASSERT_TRUE(aws_byte_cursor_find_byte(&input, 'x', &result));
+    ASSERT_PTR_EQUALS(input.ptr, result.ptr);
+    ASSERT_UINT_EQUALS(input.len, result.len);
+
+    ASSERT_FALSE(aws_byte_cursor_find_byte(&input, ';', &result));
+    ASSERT_NULL(result.ptr);
+    ASSERT_UINT_EQUALS(0, result.len);
+
+    struct aws_byte_cursor empty = aws_byte_cursor_from_c_str(s_empty);
+    ASSERT_FALSE(aws_byte_cursor_find_byte(&empty, 'x', &result));
+
+    return 0;
+}
+AWS_TEST_CASE(test_byte_cursor_find_byte, s_test_byte_cursor_find_byte)
+
+static int s_test_byte_cursor_find_any_of(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    (void)allocator;
+
+    struct aws_byte_cursor input = aws_byte_cursor_from_c_str("key=value;other=thing");
+    struct aws_byte_cursor delimiters = aws_byte_cursor_from_c_str(";=");
+    struct aws_byte_cursor result;
+
+    ASSERT_TRUE(aws_byte_cursor_find_any_of(&input, &delimiters, &result));
+    ASSERT_PTR_EQUALS(input.ptr + 3, result.ptr);
+
+    struct aws_byte_cursor absent = aws_byte_cursor_from_c_str(",&");
+    ASSERT_FALSE(aws_byte_cursor_find_any_of(&input, &absent, &result));
+    ASSERT_NULL(result.ptr);
+
+    struct aws_byte_cursor empty = aws_byte_cursor_from_c_str(s_empty);
+    ASSERT_FALSE(aws_byte_cursor_find_any_of(&input, &empty, &result));
+    ASSERT_FALSE(aws_byte_cursor_find_any_of(&empty, &delimiters, &result));
+
+    /* Sweep a match across every position of an input long enough to hit the vectorized path and its tail. */
+    uint8_t haystack[100];
+    struct aws_byte_cursor small_set = aws_byte_cursor_from_c_str(" \t;=");
+    struct aws_byte_cursor large_set = aws_byte_cursor_from_c_str(" \t;=,&?#/:");
+    for (size_t match = 0; match < sizeof(haystack); ++match) {
+        memset(haystack, 'a', sizeof(haystack));
+        haystack[match] = '=';
+        for (size_t len = match + 1; len <= sizeof(haystack); len += 7) {
+            struct aws_byte_cursor sweep = aws_byte_cursor_from_array(haystack, len);
+
+            ASSERT_TRUE(aws_byte_cursor_find_any_of(&sweep, &small_set, &result));
+            ASSERT_PTR_EQUALS(haystack + match, result.ptr);
+            ASSERT_UINT_EQUALS(len - match, result.len);
+
+            ASSERT_TRUE(aws_byte_cursor_find_any_of(&sweep, &large_set, &result));
+            ASSERT_PTR_EQUALS(haystack + match, result.ptr);
+        }
+
+        struct aws_byte_cursor before_match = aws_byte_cursor_from_array(haystack, match);
+        ASSERT_FALSE(aws_byte_cursor_find_any_of(&before_match, &small_set, &result));
+        ASSERT_FALSE(aws_byte_cursor_find_any_of(&before_match, &large_set, &result));
+    }
+
+    return 0;
+}
+AWS_TEST_CASE(test_byte_cursor_find_any_of, s_test_byte_cursor_find_any_of)
+
+static int s_test_byte_cursor_find_substring(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    (void)allocator;
+
+    struct aws_byte_cursor input = aws_byte_cursor_from_c_str("<Contents><Key>a</Key></Contents>");
+    struct aws_byte_cursor result;
+
+    struct aws_byte_cursor to_find = aws_byte_cursor_from_c_str("</Key>");
+    ASSERT_TRUE(aws_byte_cursor_find_substring(&input, &to_find, &result));
+    ASSERT_PTR_EQUALS(input.ptr + 16, result.ptr);
+    ASSERT_UINT_EQUALS(input.len - 16, result.len);
+
+    to_find = aws_byte_cursor_from_c_str("<Contents>");
+    ASSERT_TRUE(aws_byte_cursor_find_substring(&input, &to_find, &result));
+    ASSERT_PTR_EQUALS(input.ptr, result.ptr);
+
+    to_find = aws_byte_cursor_from_c_str("</Contents>");
+    ASSERT_TRUE(aws_byte_cursor_find_substring(&input, &to_find, &result));
+    ASSERT_UINT_EQUALS(to_find.len, result.len);
+
+    to_find = aws_byte_cursor_from_c_str("<Size>");
+    ASSERT_FALSE(aws_byte_cursor_find_substring(&input, &to_find, &result));
+    ASSERT_NULL(result.ptr);
+
+    /* An empty needle matches at the start */
+    to_find = aws_byte_cursor_from_c_str(s_empty);
+    ASSERT_TRUE(aws_byte_cursor_find_substring(&input, &to_find, &result));
+    ASSERT_PTR_EQUALS(input.ptr, result.ptr);
+
+    /* A needle longer than the input never matches */
+    ASSERT_FALSE(aws_byte_cursor_find_substring(&to_find, &input, &result));
+
+    /*
+     * Sweep a needle across every position of a long input. The input is seeded with near-misses that share the first
+     * and last byte of the needle, which the vectorized path has to reject with the full compare.
+     */
+    const char *needle = "ab0123456789zb";
+    struct aws_byte_cursor needle_cur = aws_byte_cursor_from_c_str(needle);
+    uint8_t haystack[100];
+    for (size_t match = 0; match + needle_cur.len <= sizeof(haystack); ++match) {
+        for (size_t i = 0; i < sizeof(haystack); ++i) {
+            haystack[i] = (i % needle_cur.len == 0) ? 'a' : 'b';
+        }
+        memcpy(haystack + match, needle, needle_cur.len);
+
+        struct aws_byte_cursor sweep = aws_byte_cursor_from_array(haystack, sizeof(haystack));
+        ASSERT_TRUE(aws_byte_cursor_find_substring(&sweep, &needle_cur, &result));
+        ASSERT_PTR_EQUALS(haystack + match, result.ptr);
+
+        struct aws_byte_cursor truncated = aws_byte_cursor_from_array(haystack, match + needle_cur.len - 1);
+        ASSERT_FALSE(aws_byte_cursor_find_substring(&truncated, &needle_cur, &result));
+    }
+
+    return 0;
+}
+AWS_TEST_CASE(test_byte_cursor_find_substring, s_test_byte_cursor_find_substring)
+
+static int s_test_byte_class_predefined(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    (void)allocator;
+
+    const char *token_symbols = "!#$%&'*+-.^_`|~";
+
+    for (size_t i = 0; i < 256; ++i) {
+        uint8_t value = (uint8_t)i;
+        bool is_token = isalnum(value) || (value != 0 && strchr(token_symbols, value) != NULL);
+
+        ASSERT_TRUE(aws_byte_class_contains(&aws_byte_class_whitespace, value) == (isspace(value) != 0));
+        ASSERT_TRUE(aws_byte_class_contains(&aws_byte_class_digit, value) == (isdigit(value) != 0));
+        ASSERT_TRUE(aws_byte_class_contains(&aws_byte_class_alnum, value) == (isalnum(value) != 0));
+        ASSERT_TRUE(aws_byte_class_contains(&aws_byte_class_token, value) == is_token);
+    }
+
+    return 0;
+}
+AWS_TEST_CASE(test_byte_class_predefined, s_test_byte_class_predefined)
+
+static int s_test_byte_class_init(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    (void)allocator;
+
+    struct aws_byte_class from_pred;
+    aws_byte_class_init_from_pred(&from_pred, s_is_whitespace);
+    ASSERT_BIN_ARRAYS_EQUALS(
+        aws_byte_class_whitespace.mask, sizeof(aws_byte_class_whitespace.mask), from_pred.mask, sizeof(from_pred.mask));
+
+    uint8_t members_src[] = {0, ',', ';', 0x80, 0xff};
+    struct aws_byte_cursor members = aws_byte_cursor_from_array(members_src, sizeof(members_src));
+    struct aws_byte_class from_members;
+    aws_byte_class_init(&from_members, &members);
+    for (size_t i = 0; i < 256; ++i) {
+        bool expected = memchr(members_src, (int)i, sizeof(members_src)) != NULL;
+        ASSERT_TRUE(aws_byte_class_contains(&from_members, (uint8_t)i) == expected);
+    }
+
+    return 0;
+}
+AWS_TEST_CASE(test_byte_class_init, s_test_byte_class_init)
+
+static int s_test_byte_cursor_trim_class(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    (void)allocator;
+
+    size_t expected_length = strlen(expected_non_empty_result);
+
+    struct aws_byte_cursor test_cursor = aws_byte_cursor_from_c_str(s_both_whitespace);
+    struct aws_byte_cursor result = aws_byte_cursor_trim_class(&test_cursor, &aws_byte_class_whitespace);
+    ASSERT_BIN_ARRAYS_EQUALS(expected_non_empty_result, expected_length, result.ptr, result.len);
+
+    test_cursor = aws_byte_cursor_from_c_str(s_left_whitespace);
+    result = aws_byte_cursor_left_trim_class(&test_cursor, &aws_byte_class_whitespace);
+    ASSERT_BIN_ARRAYS_EQUALS(expected_non_empty_result, expected_length, result.ptr, result.len);
+
+    test_cursor = aws_byte_cursor_from_c_str(s_right_whitespace);
+    result = aws_byte_cursor_right_trim_class(&test_cursor, &aws_byte_class_whitespace);
+    ASSERT_BIN_ARRAYS_EQUALS(expected_non_empty_result, expected_length, result.ptr, result.len);
+
+    test_cursor = aws_byte_cursor_from_c_str(s_all_whitespace);
+    ASSERT_UINT_EQUALS(0, aws_byte_cursor_left_trim_class(&test_cursor, &aws_byte_class_whitespace).len);
+    ASSERT_UINT_EQUALS(0, aws_byte_cursor_right_trim_class(&test_cursor, &aws_byte_class_whitespace).len);
+    ASSERT_UINT_EQUALS(0, aws_byte_cursor_trim_class(&test_cursor, &aws_byte_class_whitespace).len);
+
+    test_cursor = aws_byte_cursor_from_c_str(s_empty);
+    ASSERT_UINT_EQUALS(0, aws_byte_cursor_trim_class(&test_cursor, &aws_byte_class_whitespace).len);
+
+    return 0;
+}
+AWS_TEST_CASE(test_byte_cursor_trim_class, s_test_byte_cursor_trim_class)
+
+static int s_test_byte_cursor_satisfies_class(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    (void)allocator;
+
+    struct aws_byte_cursor header_name = aws_byte_cursor_from_c_str("x-amz-content-sha256");
+    ASSERT_TRUE(aws_byte_cursor_satisfies_class(&header_name, &aws_byte_class_token));
+    ASSERT_FALSE(aws_byte_cursor_satisfies_class(&header_name, &aws_byte_class_alnum));
+
+    struct aws_byte_cursor bad_header_name = aws_byte_cursor_from_c_str("x-amz-date:");
+    ASSERT_FALSE(aws_byte_cursor_satisfies_class(&bad_header_name, &aws_byte_class_token));
+
+    struct aws_byte_cursor number = aws_byte_cursor_from_c_str("1234567890");
+    ASSERT_TRUE(aws_byte_cursor_satisfies_class(&number, &aws_byte_class_digit));
+
+    struct aws_byte_cursor empty = aws_byte_cursor_from_c_str(s_empty);
+    ASSERT_TRUE(aws_byte_cursor_satisfies_class(&empty, &aws_byte_class_digit));
+
+    return 0;
+}
+AWS_TEST_CASE(test_byte_cursor_satisfies_class, s_test_byte_cursor_satisfies_class)
@@ -15,6 +15,8 @@
 #include <aws/common/date_time.h>
 
 #include <aws/common/byte_buf.h>
+#include <aws/common/clock.h>
+#include <aws/common/time.h>
 
 #include <aws/testing/aws_test_harness.h>
 
@@ -526,3 +528,386 @@ static int s_test_millis_parsing_fn(struct aws_allocator *allocator, void *ctx)
 }
 
 AWS_TEST_CASE(millis_parsing, s_test_millis_parsing_fn)
+
+static int s_test_init_now_cached_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    ASSERT_SUCCESS(aws_sys_clock_cache_refresh());
+    uint64_t cached = 0;
+    ASSERT_SUCCESS(aws_sys_clock_get_ticks_cached(&cached));
+
+    struct aws_date_time date_time;
+    aws_date_time_init_now_cached(&date_time);
+    uint64_t cached_secs = aws_timestamp_convert(cached, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_SECS, NULL);
+    ASSERT_UINT_EQUALS(cached_secs, date_time.timestamp);
+
+    aws_sys_clock_cache_clear();
+
+    /* without a cache the time is read from the coarse clock */
+    struct aws_date_time now;
+    aws_date_time_init_now(&now);
+    aws_date_time_init_now_cached(&date_time);
+    ASSERT_TRUE(aws_date_time_diff(&now, &date_time) <= 1 && aws_date_time_diff(&date_time, &now) <= 1);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(init_now_cached, s_test_init_now_cached_fn)
+
+/* GMT is computed arithmetically; it must agree with the C library everywhere, including before the epoch. */
+static int s_test_gmt_matches_libc_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    const int64_t interesting[] = {
+        0,
+        -1,
+        -86400,
+        68169600,   /* 1972-02-29, a leap day */
+        951782400,  /* 2000-02-29, a leap day in a year divisible by 400 */
+        951868800,  /* 2000-03-01 */
+        4107456000, /* 2100-03-01, after the non-leap 2100-02-28 */
+        1540000000,
+    };
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(interesting) + 2000; ++i) {
+        /* a sweep of pseudo-random instants between 1901 and 2099 */
+        int64_t timestamp = i < AWS_ARRAY_SIZE(interesting)
+                                ? interesting[i]
+                                : -2145916800 + (int64_t)((i * 2654435761u) % 6311433600u);
+        if (sizeof(time_t) < sizeof(int64_t) && (timestamp > INT32_MAX || timestamp < INT32_MIN)) {
+            continue;
+        }
+
+        struct aws_date_time date_time;
+        aws_date_time_init_epoch_secs(&date_time, (double)timestamp);
+        struct tm expected;
+        AWS_ZERO_STRUCT(expected);
+        aws_gmtime((time_t)timestamp, &expected);
+
+        ASSERT_INT_EQUALS(expected.tm_year, date_time.gmt_time.tm_year);
+        ASSERT_INT_EQUALS(expected.tm_mon, date_time.gmt_time.tm_mon);
+        ASSERT_INT_EQUALS(expected.tm_mday, date_time.gmt_time.tm_mday);
+        ASSERT_INT_EQUALS(expected.tm_yday, date_time.gmt_time.tm_yday);
+        ASSERT_INT_EQUALS(expected.tm_wday, date_time.gmt_time.tm_wday);
+        ASSERT_INT_EQUALS(expected.tm_hour, date_time.gmt_time.tm_hour);
+        ASSERT_INT_EQUALS(expected.tm_min, date_time.gmt_time.tm_min);
+        ASSERT_INT_EQUALS(expected.tm_sec, date_time.gmt_time.tm_sec);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(gmt_matches_libc, s_test_gmt_matches_libc_fn)
+
+static int s_test_local_time_on_demand_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    struct aws_date_time date_time;
+    aws_date_time_init_epoch_secs(&date_time, 1540000000.0);
+    ASSERT_FALSE(date_time.local_time_set);
+
+    struct tm expected;
+    AWS_ZERO_STRUCT(expected);
+    aws_localtime(date_time.timestamp, &expected);
+
+    /* computed on demand without touching dt */
+    ASSERT_UINT_EQUALS(expected.tm_hour, aws_date_time_hour(&date_time, true));
+    ASSERT_UINT_EQUALS(expected.tm_mday, aws_date_time_month_day(&date_time, true));
+    ASSERT_FALSE(date_time.local_time_set);
+
+    aws_date_time_compute_local_time(&date_time);
+    ASSERT_TRUE(date_time.local_time_set);
+    ASSERT_UINT_EQUALS(expected.tm_hour, aws_date_time_hour(&date_time, true));
+    ASSERT_UINT_EQUALS(expected.tm_min, aws_date_time_minute(&date_time, true));
+    ASSERT_UINT_EQUALS(expected.tm_year + 1900, aws_date_time_year(&date_time, true));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(local_time_on_demand, s_test_local_time_on_demand_fn)
+
+/* The UTC formatters are hand-written; strftime is the reference. */
+static int s_test_utc_str_matches_strftime_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    static const struct {
+        enum aws_date_format fmt;
+        bool short_form;
+        const char *strftime_format;
+    } s_cases[] = {
+        {AWS_DATE_FORMAT_RFC822, false, "%a, %d %b %Y %H:%M:%S GMT"},
+        {AWS_DATE_FORMAT_RFC822, true, "%a, %d %b %Y"},
+        {AWS_DATE_FORMAT_ISO_8601, false, "%Y-%m-%dT%H:%M:%SZ"},
+        {AWS_DATE_FORMAT_ISO_8601, true, "%Y-%m-%d"},
+        {AWS_DATE_FORMAT_ISO_8601_BASIC, false, "%Y%m%dT%H%M%SZ"},
+        {AWS_DATE_FORMAT_ISO_8601_BASIC, true, "%Y%m%d"},
+    };
+
+    uint8_t output[AWS_DATE_TIME_STR_MAX_LEN];
+    char expected[AWS_DATE_TIME_STR_MAX_LEN];
+    for (size_t i = 0; i < 500; ++i) {
+        time_t timestamp = (time_t)((i * 2654435761u) % 2000000000u);
+        struct aws_date_time date_time;
+        aws_date_time_init_epoch_secs(&date_time, (double)timestamp);
+        struct tm gmt;
+        aws_gmtime(timestamp, &gmt);
+
+        for (size_t j = 0; j < AWS_ARRAY_SIZE(s_cases); ++j) {
+            struct aws_byte_buf str_output = aws_byte_buf_from_empty_array(output, sizeof(output));
+            if (s_cases[j].short_form) {
+                ASSERT_SUCCESS(aws_date_time_to_utc_time_short_str(&date_time, s_cases[j].fmt, &str_output));
+            } else {
+                ASSERT_SUCCESS(aws_date_time_to_utc_time_str(&date_time, s_cases[j].fmt, &str_output));
+            }
+
+            size_t expected_len = strftime(expected, sizeof(expected), s_cases[j].strftime_format, &gmt);
+            ASSERT_BIN_ARRAYS_EQUALS(expected, expected_len, str_output.buffer, str_output.len);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(utc_str_matches_strftime, s_test_utc_str_matches_strftime_fn)
+
+static int s_test_iso8601_basic_round_trip_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    struct aws_byte_buf date_buf = aws_byte_buf_from_c_str("20021002T080509Z");
+    struct aws_date_time date_time;
+    ASSERT_SUCCESS(aws_date_time_init_from_str(&date_time, &date_buf, AWS_DATE_FORMAT_ISO_8601_BASIC));
+    ASSERT_INT_EQUALS(1033545909, date_time.timestamp);
+
+    ASSERT_SUCCESS(aws_date_time_init_from_str(&date_time, &date_buf, AWS_DATE_FORMAT_AUTO_DETECT));
+    ASSERT_INT_EQUALS(1033545909, date_time.timestamp);
+
+    uint8_t output[AWS_DATE_TIME_STR_MAX_LEN];
+    struct aws_byte_buf str_output = aws_byte_buf_from_empty_array(output, sizeof(output));
+    ASSERT_SUCCESS(aws_date_time_to_utc_time_str(&date_time, AWS_DATE_FORMAT_ISO_8601_BASIC, &str_output));
+    ASSERT_BIN_ARRAYS_EQUALS(date_buf.buffer, date_buf.len, str_output.buffer, str_output.len);
+
+    date_buf = aws_byte_buf_from_c_str("20021002");
+    ASSERT_SUCCESS(aws_date_time_init_from_str(&date_time, &date_buf, AWS_DATE_FORMAT_ISO_8601_BASIC));
+    ASSERT_INT_EQUALS(1033516800, date_time.timestamp);
+
+    date_buf = aws_byte_buf_from_c_str("20021002T0805Z");
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_DATE_STR,
+        aws_date_time_init_from_str(&date_time, &date_buf, AWS_DATE_FORMAT_ISO_8601_BASIC));
+    date_buf = aws_byte_buf_from_c_str("2002100xT080509Z");
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_DATE_STR,
+        aws_date_time_init_from_str(&date_time, &date_buf, AWS_DATE_FORMAT_ISO_8601_BASIC));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(iso8601_basic_round_trip, s_test_iso8601_basic_round_trip_fn)
+
+static int s_test_date_time_str_cache_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    struct aws_date_time_str_cache cache;
+    aws_date_time_str_cache_init(&cache, AWS_DATE_FORMAT_RFC822, false);
+
+    struct aws_date_time date_time;
+    struct aws_byte_cursor output;
+    aws_date_time_init_epoch_millis(&date_time, 1033545909000);
+    ASSERT_SUCCESS(aws_date_time_str_cache_get_utc(&cache, &date_time, &output));
+    ASSERT_BIN_ARRAYS_EQUALS("Wed, 02 Oct 2002 08:05:09 GMT", 29, output.ptr, output.len);
+
+    /* same second: served from the cache */
+    cache.str[0] = 'X';
+    aws_date_time_init_epoch_millis(&date_time, 1033545909999);
+    ASSERT_SUCCESS(aws_date_time_str_cache_get_utc(&cache, &date_time, &output));
+    ASSERT_BIN_ARRAYS_EQUALS("Xed, 02 Oct 2002 08:05:09 GMT", 29, output.ptr, output.len);
+
+    aws_date_time_init_epoch_millis(&date_time, 1033545910000);
+    ASSERT_SUCCESS(aws_date_time_str_cache_get_utc(&cache, &date_time, &output));
+    ASSERT_BIN_ARRAYS_EQUALS("Wed, 02 Oct 2002 08:05:10 GMT", 29, output.ptr, output.len);
+
+    aws_date_time_str_cache_init(&cache, AWS_DATE_FORMAT_ISO_8601_BASIC, true);
+    ASSERT_SUCCESS(aws_date_time_str_cache_get_utc(&cache, &date_time, &output));
+    ASSERT_BIN_ARRAYS_EQUALS("20021002", 8, output.ptr, output.len);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(date_time_str_cache, s_test_date_time_str_cache_fn)
+
+static int s_test_fixed_layout_parsing_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    static const struct {
+        enum aws_date_format fmt;
+        const char *strftime_format;
+    } s_cases[] = {
+        {AWS_DATE_FORMAT_RFC822, "%a, %d %b %Y %H:%M:%S GMT"},
+        {AWS_DATE_FORMAT_ISO_8601, "%Y-%m-%dT%H:%M:%SZ"},
+        {AWS_DATE_FORMAT_ISO_8601_BASIC, "%Y%m%dT%H%M%SZ"},
+    };
+
+    char date_str[AWS_DATE_TIME_STR_MAX_LEN];
+    for (size_t i = 0; i < 500; ++i) {
+        time_t timestamp = (time_t)((i * 2654435761u) % 2000000000u);
+        struct tm gmt;
+        aws_gmtime(timestamp, &gmt);
+
+        for (size_t j = 0; j < AWS_ARRAY_SIZE(s_cases); ++j) {
+            strftime(date_str, sizeof(date_str), s_cases[j].strftime_format, &gmt);
+            struct aws_byte_buf date_buf = aws_byte_buf_from_c_str(date_str);
+
+            struct aws_date_time date_time;
+            ASSERT_SUCCESS(aws_date_time_init_from_str(&date_time, &date_buf, s_cases[j].fmt));
+            ASSERT_INT_EQUALS(timestamp, date_time.timestamp);
+            ASSERT_TRUE(date_time.utc_assumed);
+            ASSERT_SUCCESS(aws_date_time_init_from_str(&date_time, &date_buf, AWS_DATE_FORMAT_AUTO_DETECT));
+            ASSERT_INT_EQUALS(timestamp, date_time.timestamp);
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(fixed_layout_parsing, s_test_fixed_layout_parsing_fn)
+
+/* Dates the fixed layout parser hands back to the general parsers must come out as they did before. */
+static int s_test_fixed_layout_edge_cases_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    static const struct {
+        const char *date_str;
+        enum aws_date_format fmt;
+        int64_t timestamp;
+    } s_cases[] = {
+        {"1969-12-31T23:59:59Z", AWS_DATE_FORMAT_ISO_8601, -1},
+        {"2000-02-29T00:00:00Z", AWS_DATE_FORMAT_ISO_8601, 951782400},
+        /* out of range fields are normalized like timegm does */
+        {"2002-02-30T00:00:00Z", AWS_DATE_FORMAT_ISO_8601, 1015027200},
+        {"2016-12-31T23:59:60Z", AWS_DATE_FORMAT_ISO_8601, 1483228800},
+        /* names in other cases only match the general parser */
+        {"wed, 02 OCT 2002 08:05:09 GMT", AWS_DATE_FORMAT_RFC822, 1033545909},
+        {"Wed, 02 Oct 2002 08:05:09 UTC", AWS_DATE_FORMAT_RFC822, 1033545909},
+    };
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_cases); ++i) {
+        struct aws_byte_buf date_buf = aws_byte_buf_from_c_str(s_cases[i].date_str);
+        struct aws_date_time date_time;
+        ASSERT_SUCCESS(aws_date_time_init_from_str(&date_time, &date_buf, s_cases[i].fmt));
+        ASSERT_INT_EQUALS(s_cases[i].timestamp, date_time.timestamp);
+    }
+
+    struct aws_byte_buf date_buf = aws_byte_buf_from_c_str("Wed, 02 Xyz 2002 08:05:09 GMT");
+    struct aws_date_time date_time;
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_DATE_STR, aws_date_time_init_from_str(&date_time, &date_buf, AWS_DATE_FORMAT_RFC822));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(fixed_layout_edge_cases, s_test_fixed_layout_edge_cases_fn)
+
+static int s_test_sub_second_precision_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    struct aws_date_time date_time;
+    aws_date_time_init_epoch_nanos(&date_time, 1033545909123456789ULL);
+    ASSERT_UINT_EQUALS(9, aws_date_time_second(&date_time, false));
+    ASSERT_UINT_EQUALS(123456789, aws_date_time_nanosecond(&date_time));
+    ASSERT_UINT_EQUALS(1033545909123456789ULL, aws_date_time_as_nanos(&date_time));
+    ASSERT_UINT_EQUALS(1033545909123456ULL, aws_date_time_as_micros(&date_time));
+    ASSERT_UINT_EQUALS(1033545909123ULL, aws_date_time_as_millis(&date_time));
+
+    struct aws_date_time earlier;
+    aws_date_time_init_epoch_millis(&earlier, 1033545908999);
+    ASSERT_UINT_EQUALS(999000000, aws_date_time_nanosecond(&earlier));
+    ASSERT_UINT_EQUALS(1033545908999ULL, aws_date_time_as_millis(&earlier));
+    ASSERT_INT_EQUALS(124456789, aws_date_time_diff_nanos(&date_time, &earlier));
+    ASSERT_INT_EQUALS(-124456789, aws_date_time_diff_nanos(&earlier, &date_time));
+
+    aws_date_time_init_epoch_secs(&date_time, 1033545909.25);
+    ASSERT_UINT_EQUALS(250000000, aws_date_time_nanosecond(&date_time));
+    ASSERT_TRUE(aws_date_time_as_epoch_secs(&date_time) == 1033545909.25);
+
+    /* the fraction of a time before the epoch counts forward from the second before it */
+    aws_date_time_init_epoch_secs(&date_time, -1.5);
+    ASSERT_INT_EQUALS(-2, (int64_t)date_time.timestamp);
+    ASSERT_UINT_EQUALS(500000000, aws_date_time_nanosecond(&date_time));
+    ASSERT_UINT_EQUALS(58, aws_date_time_second(&date_time, false));
+
+    static const struct {
+        const char *str;
+        enum aws_date_format fmt;
+        uint32_t nanoseconds;
+    } s_cases[] = {
+        {"2002-10-02T08:05:09.123Z", AWS_DATE_FORMAT_ISO_8601, 123000000},
+        {"2002-10-02T08:05:09.123456789Z", AWS_DATE_FORMAT_AUTO_DETECT, 123456789},
+        {"2002-10-02T08:05:09.1234567891234Z", AWS_DATE_FORMAT_ISO_8601, 123456789},
+        {"2002-10-02T080509.5Z", AWS_DATE_FORMAT_ISO_8601, 500000000},
+        {"20021002T080509.000001Z", AWS_DATE_FORMAT_ISO_8601_BASIC, 1000},
+        {"20021002T080509.000001Z", AWS_DATE_FORMAT_AUTO_DETECT, 1000},
+        {"2002-10-02T08:05:09Z", AWS_DATE_FORMAT_ISO_8601, 0},
+    };
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_cases); ++i) {
+        struct aws_byte_buf date_buf = aws_byte_buf_from_c_str(s_cases[i].str);
+        ASSERT_SUCCESS(aws_date_time_init_from_str(&date_time, &date_buf, s_cases[i].fmt));
+        ASSERT_INT_EQUALS(1033545909, (int64_t)date_time.timestamp);
+        ASSERT_UINT_EQUALS(s_cases[i].nanoseconds, aws_date_time_nanosecond(&date_time));
+    }
+
+    struct aws_byte_buf date_buf = aws_byte_buf_from_c_str("2002-10-02T08:05:09.12x4Z");
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_DATE_STR, aws_date_time_init_from_str(&date_time, &date_buf, AWS_DATE_FORMAT_ISO_8601));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(sub_second_precision, s_test_sub_second_precision_fn)
+
+static int s_test_utc_str_with_fraction_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    uint8_t output[AWS_DATE_TIME_STR_MAX_LEN];
+    AWS_ZERO_ARRAY(output);
+    struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output, sizeof(output));
+
+    struct aws_date_time date_time;
+    aws_date_time_init_epoch_nanos(&date_time, 1033545909012345678ULL);
+
+    ASSERT_SUCCESS(aws_date_time_to_utc_time_str_with_fraction(&date_time, AWS_DATE_FORMAT_ISO_8601, 3, &output_buf));
+    ASSERT_BIN_ARRAYS_EQUALS("2002-10-02T08:05:09.012Z", 24, output_buf.buffer, output_buf.len);
+
+    ASSERT_SUCCESS(
+        aws_date_time_to_utc_time_str_with_fraction(&date_time, AWS_DATE_FORMAT_ISO_8601_BASIC, 9, &output_buf));
+    ASSERT_BIN_ARRAYS_EQUALS("20021002T080509.012345678Z", 26, output_buf.buffer, output_buf.len);
+
+    /* parsing what was written gives the same time back */
+    struct aws_date_time parsed;
+    ASSERT_SUCCESS(aws_date_time_init_from_str(&parsed, &output_buf, AWS_DATE_FORMAT_AUTO_DETECT));
+    ASSERT_INT_EQUALS(0, aws_date_time_diff_nanos(&parsed, &date_time));
+
+    /* the formats without a fraction are unchanged */
+    ASSERT_SUCCESS(aws_date_time_to_utc_time_str(&date_time, AWS_DATE_FORMAT_ISO_8601, &output_buf));
+    ASSERT_BIN_ARRAYS_EQUALS("2002-10-02T08:05:09Z", 20, output_buf.buffer, output_buf.len);
+
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT,
+        aws_date_time_to_utc_time_str_with_fraction(&date_time, AWS_DATE_FORMAT_RFC822, 3, &output_buf));
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT,
+        aws_date_time_to_utc_time_str_with_fraction(&date_time, AWS_DATE_FORMAT_ISO_8601, 10, &output_buf));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(utc_str_with_fraction, s_test_utc_str_with_fraction_fn)
@@ -15,6 +15,7 @@
 #include <aws/common/device_random.h>
 
 #include <aws/common/byte_buf.h>
+#include <aws/common/thread.h>
 
 #include <aws/testing/aws_test_harness.h>
 
@@ -105,3 +106,133 @@ static int s_device_rand_buffer_fn(struct aws_allocator *allocator, void *ctx) {
 }
 
 AWS_TEST_CASE(device_rand_buffer, s_device_rand_buffer_fn)
+
+static int s_device_rand_buffered_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    aws_device_random_set_buffered(true);
+
+    /* enough requests to go through several refills, and sizes that don't divide the buffer evenly */
+    uint8_t last_value[23] = {0};
+    for (size_t i = 0; i < 10000; ++i) {
+        uint8_t next_value[23] = {0};
+        struct aws_byte_buf buf = aws_byte_buf_from_empty_array(next_value, sizeof(next_value));
+
+        ASSERT_SUCCESS(aws_device_random_buffer(&buf));
+        ASSERT_UINT_EQUALS(buf.capacity, buf.len);
+        ASSERT_FALSE(0 == memcmp(last_value, next_value, sizeof(next_value)));
+        memcpy(last_value, next_value, sizeof(next_value));
+
+        uint64_t value = 0;
+        ASSERT_SUCCESS(aws_device_random_u64(&value));
+        ASSERT_TRUE(value != 0);
+    }
+
+    /* larger requests bypass the buffer */
+    uint8_t large[AWS_DEVICE_RANDOM_BUFFER_SIZE + 1] = {0};
+    uint8_t zeroes[sizeof(large)] = {0};
+    struct aws_byte_buf large_buf = aws_byte_buf_from_empty_array(large, sizeof(large));
+    ASSERT_SUCCESS(aws_device_random_buffer(&large_buf));
+    ASSERT_UINT_EQUALS(sizeof(large), large_buf.len);
+    ASSERT_FALSE(0 == memcmp(zeroes, large, sizeof(large)));
+
+    aws_device_random_set_buffered(false);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(device_rand_buffered, s_device_rand_buffered_fn)
+
+#define BUFFERED_THREAD_COUNT 8
+
+static void s_device_rand_buffered_thread_fn(void *arg) {
+    int *result = arg;
+    for (size_t i = 0; i < 1000; ++i) {
+        uint64_t value = 0;
+        if (aws_device_random_u64(&value)) {
+            *result = AWS_OP_ERR;
+        }
+    }
+}
+
+static int s_device_rand_buffered_threads_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    /* each thread allocates a buffer on first use, and frees it when it exits */
+    aws_device_random_set_buffered(true);
+    for (size_t round = 0; round < 3; ++round) {
+        struct aws_thread threads[BUFFERED_THREAD_COUNT];
+        int results[BUFFERED_THREAD_COUNT] = {0};
+        for (size_t i = 0; i < BUFFERED_THREAD_COUNT; ++i) {
+            ASSERT_SUCCESS(aws_thread_init(&threads[i], allocator));
+            ASSERT_SUCCESS(aws_thread_launch(&threads[i], s_device_rand_buffered_thread_fn, &results[i], NULL));
+        }
+        for (size_t i = 0; i < BUFFERED_THREAD_COUNT; ++i) {
+            ASSERT_SUCCESS(aws_thread_join(&threads[i]));
+            aws_thread_clean_up(&threads[i]);
+            ASSERT_SUCCESS(results[i]);
+        }
+    }
+
+    /* turning buffered mode off frees this thread's buffer, and it is allocated again once turned back on */
+    uint64_t value = 0;
+    ASSERT_SUCCESS(aws_device_random_u64(&value));
+    aws_device_random_set_buffered(false);
+    ASSERT_SUCCESS(aws_device_random_u64(&value));
+    aws_device_random_set_buffered(true);
+    ASSERT_SUCCESS(aws_device_random_u64(&value));
+    aws_device_random_set_buffered(false);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(device_rand_buffered_threads, s_device_rand_buffered_threads_fn)
+
+#ifndef _WIN32
+#    include <sys/wait.h>
+#    include <unistd.h>
+
+static int s_device_rand_buffered_fork_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    aws_device_random_set_buffered(true);
+
+    /* fill this thread's buffer before forking, so that the child starts with a copy of it */
+    uint64_t value = 0;
+    ASSERT_SUCCESS(aws_device_random_u64(&value));
+
+    int pipe_fds[2];
+    ASSERT_SUCCESS(pipe(pipe_fds));
+
+    pid_t pid = fork();
+    ASSERT_TRUE(pid >= 0);
+    if (pid == 0) {
+        uint64_t child_value = 0;
+        int result = aws_device_random_u64(&child_value);
+        ssize_t written = write(pipe_fds[1], &child_value, sizeof(child_value));
+        _exit(result == AWS_OP_SUCCESS && written == sizeof(child_value) ? 0 : 1);
+    }
+
+    uint64_t parent_value = 0;
+    ASSERT_SUCCESS(aws_device_random_u64(&parent_value));
+
+    uint64_t child_value = 0;
+    ASSERT_INT_EQUALS(sizeof(child_value), read(pipe_fds[0], &child_value, sizeof(child_value)));
+    int status = 0;
+    ASSERT_INT_EQUALS(pid, waitpid(pid, &status, 0));
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+
+    /* without the fork check both would have taken the same next 8 bytes from the buffer */
+    ASSERT_FALSE(parent_value == child_value);
+
+    aws_device_random_set_buffered(false);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(device_rand_buffered_fork, s_device_rand_buffered_fork_fn)
+#endif /* _WIN32 */
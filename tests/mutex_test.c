@@ -15,6 +15,8 @@
 
 #include <aws/common/mutex.h>
 
+#include <aws/common/adaptive_mutex.h>
+#include <aws/common/condition_variable.h>
 #include <aws/common/thread.h>
 #include <aws/testing/aws_test_harness.h>
 
@@ -112,4 +114,187 @@ static int s_test_mutex_is_actually_mutex(struct aws_allocator *allocator, void
 }
 
 AWS_TEST_CASE(mutex_aquire_release_test, s_test_mutex_acquire_release)
-AWS_TEST_CASE(mutex_is_actually_mutex_test, s_test_mutex_is_actually_mutex)
\ No newline at end of file
+AWS_TEST_CASE(mutex_is_actually_mutex_test, s_test_mutex_is_actually_mutex)
+
+static int s_test_adaptive_mutex_acquire_release(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    struct aws_adaptive_mutex mutex;
+    ASSERT_SUCCESS(aws_adaptive_mutex_init(&mutex));
+
+    ASSERT_SUCCESS(aws_adaptive_mutex_lock(&mutex));
+    ASSERT_ERROR(AWS_ERROR_MUTEX_TIMEOUT, aws_adaptive_mutex_try_lock(&mutex));
+    ASSERT_SUCCESS(aws_adaptive_mutex_unlock(&mutex));
+    ASSERT_ERROR(AWS_ERROR_MUTEX_CALLER_NOT_OWNER, aws_adaptive_mutex_unlock(&mutex));
+
+    ASSERT_SUCCESS(aws_adaptive_mutex_try_lock(&mutex));
+    ASSERT_SUCCESS(aws_adaptive_mutex_unlock(&mutex));
+
+    aws_adaptive_mutex_clean_up(&mutex);
+
+    return 0;
+}
+
+#define ADAPTIVE_MUTEX_THREAD_COUNT 4
+#define ADAPTIVE_MUTEX_INCREMENTS 200000
+
+struct adaptive_mutex_data {
+    struct aws_adaptive_mutex mutex;
+    /* deliberately not atomic: the mutex is the only thing keeping increments from being lost */
+    volatile size_t counter;
+    /* 1 while a thread holds the lock across a sleep, so the others have to park */
+    volatile int sleeping_holder;
+};
+
+static void s_adaptive_mutex_thread_fn(void *arg) {
+    struct adaptive_mutex_data *data = arg;
+
+    for (size_t i = 0; i < ADAPTIVE_MUTEX_INCREMENTS; ++i) {
+        aws_adaptive_mutex_lock(&data->mutex);
+        size_t counter = data->counter;
+        if (i == ADAPTIVE_MUTEX_INCREMENTS / 2 && !data->sleeping_holder) {
+            data->sleeping_holder = 1;
+            aws_thread_current_sleep(10 * 1000 * 1000);
+        }
+        data->counter = counter + 1;
+        aws_adaptive_mutex_unlock(&data->mutex);
+    }
+}
+
+static int s_test_adaptive_mutex_is_actually_mutex(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct adaptive_mutex_data data;
+    AWS_ZERO_STRUCT(data);
+    ASSERT_SUCCESS(aws_adaptive_mutex_init(&data.mutex));
+
+    struct aws_thread threads[ADAPTIVE_MUTEX_THREAD_COUNT];
+    for (size_t i = 0; i < ADAPTIVE_MUTEX_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_init(&threads[i], allocator));
+        ASSERT_SUCCESS(aws_thread_launch(&threads[i], s_adaptive_mutex_thread_fn, &data, NULL));
+    }
+
+    for (size_t i = 0; i < ADAPTIVE_MUTEX_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_join(&threads[i]));
+        aws_thread_clean_up(&threads[i]);
+    }
+
+    ASSERT_UINT_EQUALS(ADAPTIVE_MUTEX_THREAD_COUNT * ADAPTIVE_MUTEX_INCREMENTS, data.counter);
+    ASSERT_INT_EQUALS(1, data.sleeping_holder);
+
+    /* the lock is free again after all that */
+    ASSERT_SUCCESS(aws_adaptive_mutex_try_lock(&data.mutex));
+    ASSERT_SUCCESS(aws_adaptive_mutex_unlock(&data.mutex));
+
+    aws_adaptive_mutex_clean_up(&data.mutex);
+
+    return 0;
+}
+
+AWS_TEST_CASE(adaptive_mutex_acquire_release_test, s_test_adaptive_mutex_acquire_release)
+AWS_TEST_CASE(adaptive_mutex_is_actually_mutex_test, s_test_adaptive_mutex_is_actually_mutex)
+
+#define PROFILED_HOLD_NS (20 * 1000 * 1000)
+
+static void s_profiled_mutex_thread_fn(void *arg) {
+    struct aws_mutex *mutex = arg;
+    aws_mutex_lock(mutex);
+    aws_mutex_unlock(mutex);
+}
+
+static int s_test_mutex_profiling(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_mutex mutex;
+    ASSERT_SUCCESS(aws_mutex_init(&mutex));
+
+    struct aws_lock_stats stats;
+    ASSERT_ERROR(AWS_ERROR_INVALID_STATE, aws_mutex_get_lock_stats(&mutex, &stats));
+    ASSERT_SUCCESS(aws_mutex_enable_profiling(&mutex, allocator, NULL));
+    ASSERT_ERROR(AWS_ERROR_INVALID_STATE, aws_mutex_enable_profiling(&mutex, allocator, NULL));
+
+    for (size_t i = 0; i < 10; ++i) {
+        ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+        ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+    }
+    ASSERT_SUCCESS(aws_mutex_try_lock(&mutex));
+    ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+
+    ASSERT_SUCCESS(aws_mutex_get_lock_stats(&mutex, &stats));
+    ASSERT_UINT_EQUALS(11, stats.acquisitions);
+    ASSERT_UINT_EQUALS(0, stats.contended_acquisitions);
+    ASSERT_UINT_EQUALS(0, stats.total_wait_ns);
+
+    /* hold the lock across a sleep while another thread tries to take it */
+    ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+    struct aws_thread thread;
+    ASSERT_SUCCESS(aws_thread_init(&thread, allocator));
+    ASSERT_SUCCESS(aws_thread_launch(&thread, s_profiled_mutex_thread_fn, &mutex, NULL));
+    aws_thread_current_sleep(PROFILED_HOLD_NS);
+    ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+    ASSERT_SUCCESS(aws_thread_join(&thread));
+    aws_thread_clean_up(&thread);
+
+    ASSERT_SUCCESS(aws_mutex_get_lock_stats(&mutex, &stats));
+    ASSERT_UINT_EQUALS(13, stats.acquisitions);
+    ASSERT_UINT_EQUALS(1, stats.contended_acquisitions);
+    ASSERT_TRUE(stats.total_wait_ns > 0);
+    ASSERT_TRUE(stats.max_hold_ns >= PROFILED_HOLD_NS);
+
+    aws_mutex_clean_up(&mutex);
+
+    return 0;
+}
+AWS_TEST_CASE(mutex_profiling_test, s_test_mutex_profiling)
+
+static int s_test_mutex_profiling_by_name(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    const char *name = "mutex_profiling_by_name_test";
+    struct aws_lock_stats stats;
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_lock_stats_get_by_name(name, &stats));
+
+    struct aws_mutex mutexes[2];
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(mutexes); ++i) {
+        ASSERT_SUCCESS(aws_mutex_init(&mutexes[i]));
+        ASSERT_SUCCESS(aws_mutex_enable_profiling(&mutexes[i], allocator, name));
+    }
+
+    struct aws_condition_variable condition_variable;
+    ASSERT_SUCCESS(aws_condition_variable_init(&condition_variable));
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(mutexes); ++i) {
+        for (size_t j = 0; j <= i; ++j) {
+            ASSERT_SUCCESS(aws_mutex_lock(&mutexes[i]));
+            /* time spent waiting on a condition variable does not count as holding the lock */
+            aws_condition_variable_wait_for(&condition_variable, &mutexes[i], PROFILED_HOLD_NS);
+            ASSERT_SUCCESS(aws_mutex_unlock(&mutexes[i]));
+        }
+    }
+
+    ASSERT_SUCCESS(aws_lock_stats_get_by_name(name, &stats));
+    ASSERT_UINT_EQUALS(3, stats.acquisitions);
+    ASSERT_UINT_EQUALS(0, stats.contended_acquisitions);
+    ASSERT_TRUE(stats.max_hold_ns < PROFILED_HOLD_NS);
+
+    /* counters of cleaned up locks are kept */
+    aws_mutex_clean_up(&mutexes[1]);
+    ASSERT_SUCCESS(aws_lock_stats_get_by_name(name, &stats));
+    ASSERT_UINT_EQUALS(3, stats.acquisitions);
+    aws_mutex_clean_up(&mutexes[0]);
+    ASSERT_SUCCESS(aws_lock_stats_get_by_name(name, &stats));
+    ASSERT_UINT_EQUALS(3, stats.acquisitions);
+
+    char long_name[AWS_LOCK_STATS_MAX_NAME_LEN + 2];
+    memset(long_name, 'a', sizeof(long_name) - 1);
+    long_name[sizeof(long_name) - 1] = '\0';
+    struct aws_mutex mutex;
+    ASSERT_SUCCESS(aws_mutex_init(&mutex));
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_mutex_enable_profiling(&mutex, allocator, long_name));
+    aws_mutex_clean_up(&mutex);
+
+    aws_condition_variable_clean_up(&condition_variable);
+
+    return 0;
+}
+AWS_TEST_CASE(mutex_profiling_by_name_test, s_test_mutex_profiling_by_name)
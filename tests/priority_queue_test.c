@@ -14,6 +14,7 @@
  */
 
 #include <aws/common/priority_queue.h>
+#include <aws/common/typed_heap.h>
 
 #include <aws/testing/aws_test_harness.h>
 
@@ -461,6 +462,209 @@ static int s_test_remove_interior_sift_down(struct aws_allocator *allocator, voi
     return 0;
 }
 
+static int s_test_priority_queue_push_batch(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_priority_queue queue;
+    ASSERT_SUCCESS(aws_priority_queue_init_dynamic(&queue, allocator, 4, sizeof(int), s_compare_ints));
+
+    /* bulk build into an empty queue */
+    int bulk[] = {9, 3, 7, 1, 8, 2, 6, 4, 5, 0};
+    ASSERT_SUCCESS(aws_priority_queue_push_batch(&queue, bulk, AWS_ARRAY_SIZE(bulk)));
+    ASSERT_SUCCESS(aws_priority_queue_push_batch(&queue, NULL, 0));
+    ASSERT_UINT_EQUALS(AWS_ARRAY_SIZE(bulk), aws_priority_queue_size(&queue));
+
+    /* a small batch onto a larger queue takes the sift-up path */
+    int small[] = {15, 11};
+    ASSERT_SUCCESS(aws_priority_queue_push_batch(&queue, small, AWS_ARRAY_SIZE(small)));
+
+    CHECK_ORDER(queue, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 15);
+
+    /* batches onto a queue with backpointers keep existing nodes trackable */
+    struct aws_priority_queue_node node = {12345};
+    int val = 10;
+    ASSERT_SUCCESS(aws_priority_queue_push_ref(&queue, &val, &node));
+    ADD_ELEMS(queue, 30, 20);
+    ASSERT_SUCCESS(aws_priority_queue_push_batch(&queue, bulk, AWS_ARRAY_SIZE(bulk)));
+
+    val = -1;
+    ASSERT_SUCCESS(aws_priority_queue_remove(&queue, &val, &node));
+    ASSERT_INT_EQUALS(10, val);
+    CHECK_ORDER(queue, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 20, 30);
+
+    aws_priority_queue_clean_up(&queue);
+
+    /* a static queue that cannot fit the batch is left unchanged */
+    int storage[4] = {0};
+    aws_priority_queue_init_static(&queue, storage, AWS_ARRAY_SIZE(storage), sizeof(int), s_compare_ints);
+    ADD_ELEMS(queue, 3, 1);
+    ASSERT_FAILS(aws_priority_queue_push_batch(&queue, bulk, 3));
+    ASSERT_SUCCESS(aws_priority_queue_push_batch(&queue, small, AWS_ARRAY_SIZE(small)));
+    CHECK_ORDER(queue, 1, 3, 11, 15);
+    aws_priority_queue_clean_up(&queue);
+
+    return 0;
+}
+AWS_TEST_CASE(priority_queue_push_batch_test, s_test_priority_queue_push_batch);
+
+static int s_test_priority_queue_pop_up_to(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_priority_queue queue;
+    ASSERT_SUCCESS(aws_priority_queue_init_dynamic(&queue, allocator, 4, sizeof(int), s_compare_ints));
+
+    struct aws_array_list out;
+    ASSERT_SUCCESS(aws_array_list_init_dynamic(&out, allocator, 2, sizeof(int)));
+
+    struct aws_priority_queue_node node = {12345};
+    int val = 5;
+    ASSERT_SUCCESS(aws_priority_queue_push_ref(&queue, &val, &node));
+    ADD_ELEMS(queue, 12, 3, 7, 5, 1, 9, 14, 10);
+
+    int threshold = 0;
+    ASSERT_SUCCESS(aws_priority_queue_pop_up_to(&queue, &threshold, &out));
+    ASSERT_UINT_EQUALS(0, aws_array_list_length(&out));
+
+    threshold = 7;
+    ASSERT_SUCCESS(aws_priority_queue_pop_up_to(&queue, &threshold, &out));
+    int expected[] = {1, 3, 5, 5, 7};
+    ASSERT_UINT_EQUALS(AWS_ARRAY_SIZE(expected), aws_array_list_length(&out));
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(expected); ++i) {
+        ASSERT_SUCCESS(aws_array_list_get_at(&out, &val, i));
+        ASSERT_INT_EQUALS(expected[i], val);
+    }
+
+    /* the backpointer was cleared when its node was drained */
+    ASSERT_UINT_EQUALS(SIZE_MAX, node.current_index);
+
+    aws_array_list_clear(&out);
+    threshold = 100;
+    ASSERT_SUCCESS(aws_priority_queue_pop_up_to(&queue, &threshold, &out));
+    ASSERT_UINT_EQUALS(4, aws_array_list_length(&out));
+    ASSERT_UINT_EQUALS(0, aws_priority_queue_size(&queue));
+
+    aws_array_list_clean_up(&out);
+    aws_priority_queue_clean_up(&queue);
+    return 0;
+}
+AWS_TEST_CASE(priority_queue_pop_up_to_test, s_test_priority_queue_pop_up_to);
+
+static bool s_int_less(const int *a, const int *b) {
+    return *a < *b;
+}
+
+AWS_TYPED_HEAP_DEFINE(s_int_heap, int, s_int_less)
+
+static int s_test_typed_heap_random_values(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    enum { SIZE = 1000 };
+    struct s_int_heap heap;
+    ASSERT_SUCCESS(s_int_heap_init(&heap, allocator, 0));
+
+    int *top = NULL;
+    int value = 0;
+    ASSERT_ERROR(AWS_ERROR_PRIORITY_QUEUE_EMPTY, s_int_heap_top(&heap, &top));
+    ASSERT_ERROR(AWS_ERROR_PRIORITY_QUEUE_EMPTY, s_int_heap_pop(&heap, &value));
+
+    int values[SIZE];
+    srand((unsigned)(uintptr_t)&heap);
+    for (int i = 0; i < SIZE; i++) {
+        values[i] = rand() % 1000;
+        ASSERT_SUCCESS(s_int_heap_push(&heap, values[i]));
+    }
+    ASSERT_UINT_EQUALS(SIZE, s_int_heap_size(&heap));
+    ASSERT_TRUE(s_int_heap_capacity(&heap) >= SIZE);
+
+    qsort(values, SIZE, sizeof(int), s_compare_ints);
+
+    /* pop half, refill with new values, then drain everything */
+    for (int i = 0; i < SIZE / 2; i++) {
+        ASSERT_SUCCESS(s_int_heap_top(&heap, &top));
+        ASSERT_INT_EQUALS(values[i], *top);
+        ASSERT_SUCCESS(s_int_heap_pop(&heap, &value));
+        ASSERT_INT_EQUALS(values[i], value);
+    }
+
+    for (int i = 0; i < SIZE / 2; i++) {
+        values[i] = rand() % 1000;
+        ASSERT_SUCCESS(s_int_heap_push(&heap, values[i]));
+    }
+
+    qsort(values, SIZE, sizeof(int), s_compare_ints);
+    for (int i = 0; i < SIZE; i++) {
+        ASSERT_SUCCESS(s_int_heap_pop(&heap, &value));
+        ASSERT_INT_EQUALS(values[i], value);
+    }
+    ASSERT_UINT_EQUALS(0, s_int_heap_size(&heap));
+
+    s_int_heap_clean_up(&heap);
+    return 0;
+}
+AWS_TEST_CASE(typed_heap_random_values_test, s_test_typed_heap_random_values);
+
+static int s_test_typed_heap_remove_backpointers(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    enum { SIZE = 257 };
+    struct s_int_heap heap;
+    ASSERT_SUCCESS(s_int_heap_init(&heap, allocator, 4));
+
+    /* mix plain pushes and backpointer pushes so the backpointer array is created mid-stream */
+    struct aws_priority_queue_node nodes[SIZE];
+    bool removed[SIZE] = {0};
+    for (int i = 0; i < SIZE; i++) {
+        int value = (i * 7919) % SIZE;
+        if (i < 10) {
+            nodes[i].current_index = SIZE_MAX;
+            ASSERT_SUCCESS(s_int_heap_push(&heap, value));
+        } else {
+            ASSERT_SUCCESS(s_int_heap_push_ref(&heap, value, &nodes[i]));
+        }
+    }
+
+    /* backpointers always point at the slot holding their element */
+    for (int i = 10; i < SIZE; i++) {
+        ASSERT_INT_EQUALS((i * 7919) % SIZE, heap.items[nodes[i].current_index]);
+    }
+
+    /* remove every third node with a backpointer */
+    for (int i = 10; i < SIZE; i += 3) {
+        int value = -1;
+        ASSERT_SUCCESS(s_int_heap_remove(&heap, &value, &nodes[i]));
+        ASSERT_INT_EQUALS((i * 7919) % SIZE, value);
+        ASSERT_UINT_EQUALS(SIZE_MAX, nodes[i].current_index);
+        ASSERT_ERROR(AWS_ERROR_PRIORITY_QUEUE_BAD_NODE, s_int_heap_remove(&heap, &value, &nodes[i]));
+        removed[(i * 7919) % SIZE] = true;
+    }
+
+    for (int i = 10; i < SIZE; i++) {
+        if (nodes[i].current_index != SIZE_MAX) {
+            ASSERT_INT_EQUALS((i * 7919) % SIZE, heap.items[nodes[i].current_index]);
+        }
+    }
+
+    int expected = 0;
+    while (s_int_heap_size(&heap)) {
+        while (removed[expected]) {
+            expected++;
+        }
+        int value = -1;
+        ASSERT_SUCCESS(s_int_heap_pop(&heap, &value));
+        ASSERT_INT_EQUALS(expected, value);
+        expected++;
+    }
+
+    /* popping clears backpointers as well */
+    for (int i = 0; i < SIZE; i++) {
+        ASSERT_UINT_EQUALS(SIZE_MAX, nodes[i].current_index);
+    }
+
+    s_int_heap_clean_up(&heap);
+    return 0;
+}
+AWS_TEST_CASE(typed_heap_remove_backpointers_test, s_test_typed_heap_remove_backpointers);
+
 AWS_TEST_CASE(priority_queue_remove_interior_sift_down_test, s_test_remove_interior_sift_down);
 AWS_TEST_CASE(priority_queue_remove_interior_sift_up_test, s_test_remove_interior_sift_up);
 AWS_TEST_CASE(priority_queue_remove_leaf_test, s_test_remove_leaf);
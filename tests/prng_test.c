@@ -0,0 +1,88 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/prng.h>
+
+#include <aws/testing/aws_test_harness.h>
+
+static int s_prng_known_answers_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    /* the first outputs of the xoshiro256** reference implementation from this state */
+    struct aws_prng prng = {.state = {1, 2, 3, 4}};
+    ASSERT_UINT_EQUALS(11520ULL, aws_prng_next_u64(&prng));
+    ASSERT_UINT_EQUALS(0ULL, aws_prng_next_u64(&prng));
+    ASSERT_UINT_EQUALS(1509978240ULL, aws_prng_next_u64(&prng));
+    ASSERT_UINT_EQUALS(1215971899390074240ULL, aws_prng_next_u64(&prng));
+
+    /* seeding expands the seed with splitmix64, whose first output from 0 is well known */
+    aws_prng_init_from_seed(&prng, 0);
+    ASSERT_UINT_EQUALS(0xE220A8397B1DCDAFULL, prng.state[0]);
+
+    struct aws_prng same_seed;
+    aws_prng_init_from_seed(&same_seed, 0);
+    for (size_t i = 0; i < 100; ++i) {
+        ASSERT_UINT_EQUALS(aws_prng_next_u64(&same_seed), aws_prng_next_u64(&prng));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(prng_known_answers, s_prng_known_answers_fn)
+
+static int s_prng_ranges_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    struct aws_prng prng;
+    ASSERT_SUCCESS(aws_prng_init(&prng));
+
+    size_t counts[10] = {0};
+    for (size_t i = 0; i < 100000; ++i) {
+        uint64_t value = aws_prng_next_bounded(&prng, AWS_ARRAY_SIZE(counts));
+        ASSERT_TRUE(value < AWS_ARRAY_SIZE(counts));
+        counts[value]++;
+
+        double fraction = aws_prng_next_double(&prng);
+        ASSERT_TRUE(fraction >= 0.0 && fraction < 1.0);
+    }
+
+    /* each bucket expects 10000; 9000 is more than 10 standard deviations away */
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(counts); ++i) {
+        ASSERT_TRUE(counts[i] > 9000 && counts[i] < 11000);
+    }
+
+    ASSERT_UINT_EQUALS(0, aws_prng_next_bounded(&prng, 1));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(prng_ranges, s_prng_ranges_fn)
+
+static int s_prng_thread_local_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    struct aws_prng *prng = aws_prng_thread_local();
+    ASSERT_PTR_EQUALS(prng, aws_prng_thread_local());
+
+    uint64_t first = aws_prng_next_u64(prng);
+    ASSERT_FALSE(first == aws_prng_next_u64(aws_prng_thread_local()));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(prng_thread_local, s_prng_thread_local_fn)
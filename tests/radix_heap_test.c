@@ -0,0 +1,164 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/radix_heap.h>
+
+#include <aws/testing/aws_test_harness.h>
+
+#include <stdlib.h>
+
+static int s_compare_u64(const void *a, const void *b) {
+    uint64_t arg1 = *(const uint64_t *)a;
+    uint64_t arg2 = *(const uint64_t *)b;
+
+    if (arg1 < arg2) {
+        return -1;
+    }
+    if (arg1 > arg2) {
+        return 1;
+    }
+    return 0;
+}
+
+static int s_test_radix_heap_order(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    enum { SIZE = 512 };
+    struct aws_radix_heap heap;
+    aws_radix_heap_init(&heap, 100);
+
+    struct aws_radix_heap_node *node = NULL;
+    ASSERT_ERROR(AWS_ERROR_PRIORITY_QUEUE_EMPTY, aws_radix_heap_top(&heap, &node));
+    ASSERT_ERROR(AWS_ERROR_PRIORITY_QUEUE_EMPTY, aws_radix_heap_pop(&heap, &node));
+
+    struct aws_radix_heap_node nodes[SIZE];
+    uint64_t keys[SIZE];
+    srand((unsigned)(uintptr_t)&heap);
+    /* spread keys across every bucket, including duplicates and both extremes */
+    keys[0] = 100;
+    keys[1] = UINT64_MAX;
+    for (size_t i = 2; i < SIZE; ++i) {
+        int shift = rand() % 64;
+        keys[i] = 100 + (((uint64_t)rand() << 32 | (uint64_t)rand()) >> shift);
+        if (i % 16 == 0) {
+            keys[i] = keys[i / 2];
+        }
+    }
+    for (size_t i = 0; i < SIZE; ++i) {
+        ASSERT_SUCCESS(aws_radix_heap_push(&heap, &nodes[i], keys[i]));
+    }
+    ASSERT_UINT_EQUALS(SIZE, aws_radix_heap_size(&heap));
+
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_radix_heap_push(&heap, &nodes[0], 99));
+
+    qsort(keys, SIZE, sizeof(uint64_t), s_compare_u64);
+
+    for (size_t i = 0; i < SIZE; ++i) {
+        ASSERT_SUCCESS(aws_radix_heap_top(&heap, &node));
+        ASSERT_UINT_EQUALS(keys[i], node->key);
+        ASSERT_SUCCESS(aws_radix_heap_pop(&heap, &node));
+        ASSERT_UINT_EQUALS(keys[i], node->key);
+        ASSERT_UINT_EQUALS(keys[i], aws_radix_heap_min_key(&heap));
+        ASSERT_NULL(node->node.next);
+    }
+    ASSERT_UINT_EQUALS(0, aws_radix_heap_size(&heap));
+
+    return 0;
+}
+AWS_TEST_CASE(radix_heap_order_test, s_test_radix_heap_order);
+
+/* Simulates a timer wheel: pop the earliest timer, then schedule new ones relative to it. */
+static int s_test_radix_heap_monotone_interleaved(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    enum { SIZE = 256, ROUNDS = 4096 };
+    struct aws_radix_heap heap;
+    aws_radix_heap_init(&heap, 0);
+
+    struct aws_radix_heap_node nodes[SIZE];
+    srand((unsigned)(uintptr_t)&heap);
+    for (size_t i = 0; i < SIZE; ++i) {
+        ASSERT_SUCCESS(aws_radix_heap_push(&heap, &nodes[i], (uint64_t)(rand() % 100000)));
+    }
+
+    uint64_t now = 0;
+    for (size_t round = 0; round < ROUNDS; ++round) {
+        struct aws_radix_heap_node *node = NULL;
+        ASSERT_SUCCESS(aws_radix_heap_pop(&heap, &node));
+        ASSERT_TRUE(node->key >= now);
+
+        /* no remaining node may be earlier than the one just popped */
+        for (size_t i = 0; i < SIZE; ++i) {
+            if (nodes[i].node.next) {
+                ASSERT_TRUE(nodes[i].key >= node->key);
+            }
+        }
+
+        now = node->key;
+        ASSERT_SUCCESS(aws_radix_heap_push(&heap, node, now + (uint64_t)(rand() % 100000)));
+    }
+
+    return 0;
+}
+AWS_TEST_CASE(radix_heap_monotone_interleaved_test, s_test_radix_heap_monotone_interleaved);
+
+static int s_test_radix_heap_remove(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    enum { SIZE = 300 };
+    struct aws_radix_heap heap;
+    aws_radix_heap_init(&heap, 0);
+
+    struct aws_radix_heap_node nodes[SIZE];
+    for (size_t i = 0; i < SIZE; ++i) {
+        ASSERT_SUCCESS(aws_radix_heap_push(&heap, &nodes[i], (uint64_t)((i * 7919) % SIZE) * 1000));
+    }
+
+    /* pop a few so that later removals happen from redistributed buckets */
+    struct aws_radix_heap_node *node = NULL;
+    for (size_t i = 0; i < 3; ++i) {
+        ASSERT_SUCCESS(aws_radix_heap_pop(&heap, &node));
+        ASSERT_UINT_EQUALS(i * 1000, node->key);
+        ASSERT_ERROR(AWS_ERROR_PRIORITY_QUEUE_BAD_NODE, aws_radix_heap_remove(&heap, node));
+    }
+
+    bool removed[SIZE] = {0};
+    removed[0] = removed[1] = removed[2] = true;
+    for (size_t i = 0; i < SIZE; i += 3) {
+        size_t key_index = (i * 7919) % SIZE;
+        if (removed[key_index]) {
+            continue;
+        }
+        ASSERT_SUCCESS(aws_radix_heap_remove(&heap, &nodes[i]));
+        ASSERT_ERROR(AWS_ERROR_PRIORITY_QUEUE_BAD_NODE, aws_radix_heap_remove(&heap, &nodes[i]));
+        removed[key_index] = true;
+    }
+
+    size_t expected = 0;
+    while (aws_radix_heap_size(&heap)) {
+        while (removed[expected]) {
+            expected++;
+        }
+        ASSERT_SUCCESS(aws_radix_heap_pop(&heap, &node));
+        ASSERT_UINT_EQUALS(expected * 1000, node->key);
+        expected++;
+    }
+
+    return 0;
+}
+AWS_TEST_CASE(radix_heap_remove_test, s_test_radix_heap_remove);
@@ -15,6 +15,7 @@
 
 #include <aws/common/rw_lock.h>
 
+#include <aws/common/scalable_rw_lock.h>
 #include <aws/common/thread.h>
 #include <aws/testing/aws_test_harness.h>
 
@@ -167,3 +168,186 @@ static int s_test_rw_lock_many_readers(struct aws_allocator *allocator, void *ct
     return 0;
 }
 AWS_TEST_CASE(rw_lock_many_readers_test, s_test_rw_lock_many_readers)
+
+#define PROFILED_HOLD_NS (20 * 1000 * 1000)
+
+static void s_profiled_reader_fn(void *ud) {
+    struct aws_rw_lock *lock = ud;
+    aws_rw_lock_rlock(lock);
+    aws_rw_lock_runlock(lock);
+}
+
+static int s_test_rw_lock_profiling(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    const char *name = "rw_lock_profiling_test";
+    struct aws_rw_lock lock;
+    ASSERT_SUCCESS(aws_rw_lock_init(&lock));
+
+    struct aws_lock_stats stats;
+    ASSERT_ERROR(AWS_ERROR_INVALID_STATE, aws_rw_lock_get_lock_stats(&lock, &stats));
+    ASSERT_SUCCESS(aws_rw_lock_enable_profiling(&lock, allocator, name));
+
+    /* shared holders don't contend with each other */
+    ASSERT_SUCCESS(aws_rw_lock_rlock(&lock));
+    ASSERT_SUCCESS(aws_rw_lock_rlock(&lock));
+    ASSERT_SUCCESS(aws_rw_lock_try_rlock(&lock));
+    ASSERT_ERROR(AWS_ERROR_MUTEX_TIMEOUT, aws_rw_lock_try_wlock(&lock));
+    for (size_t i = 0; i < 3; ++i) {
+        ASSERT_SUCCESS(aws_rw_lock_runlock(&lock));
+    }
+
+    ASSERT_SUCCESS(aws_rw_lock_get_lock_stats(&lock, &stats));
+    ASSERT_UINT_EQUALS(3, stats.acquisitions);
+    ASSERT_UINT_EQUALS(0, stats.contended_acquisitions);
+    ASSERT_UINT_EQUALS(0, stats.max_hold_ns);
+
+    /* a reader has to wait for a writer holding the lock across a sleep */
+    ASSERT_SUCCESS(aws_rw_lock_wlock(&lock));
+    struct aws_thread thread;
+    ASSERT_SUCCESS(aws_thread_init(&thread, allocator));
+    ASSERT_SUCCESS(aws_thread_launch(&thread, s_profiled_reader_fn, &lock, NULL));
+    aws_thread_current_sleep(PROFILED_HOLD_NS);
+    ASSERT_SUCCESS(aws_rw_lock_wunlock(&lock));
+    ASSERT_SUCCESS(aws_thread_join(&thread));
+    aws_thread_clean_up(&thread);
+
+    ASSERT_SUCCESS(aws_rw_lock_get_lock_stats(&lock, &stats));
+    ASSERT_UINT_EQUALS(5, stats.acquisitions);
+    ASSERT_UINT_EQUALS(1, stats.contended_acquisitions);
+    ASSERT_TRUE(stats.total_wait_ns > 0);
+    ASSERT_TRUE(stats.max_hold_ns >= PROFILED_HOLD_NS);
+
+    aws_rw_lock_clean_up(&lock);
+
+    ASSERT_SUCCESS(aws_lock_stats_get_by_name(name, &stats));
+    ASSERT_UINT_EQUALS(5, stats.acquisitions);
+    ASSERT_UINT_EQUALS(1, stats.contended_acquisitions);
+
+    return 0;
+}
+AWS_TEST_CASE(rw_lock_profiling_test, s_test_rw_lock_profiling)
+
+static int s_test_scalable_rw_lock_acquire_release(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_scalable_rw_lock lock;
+    ASSERT_SUCCESS(aws_scalable_rw_lock_init(&lock, allocator));
+
+    ASSERT_SUCCESS(aws_scalable_rw_lock_wlock(&lock));
+    ASSERT_ERROR(AWS_ERROR_MUTEX_TIMEOUT, aws_scalable_rw_lock_try_rlock(&lock));
+    ASSERT_ERROR(AWS_ERROR_MUTEX_TIMEOUT, aws_scalable_rw_lock_try_wlock(&lock));
+    ASSERT_SUCCESS(aws_scalable_rw_lock_wunlock(&lock));
+
+    ASSERT_SUCCESS(aws_scalable_rw_lock_rlock(&lock));
+    ASSERT_ERROR(AWS_ERROR_MUTEX_TIMEOUT, aws_scalable_rw_lock_try_wlock(&lock));
+    ASSERT_SUCCESS(aws_scalable_rw_lock_try_rlock(&lock));
+    ASSERT_SUCCESS(aws_scalable_rw_lock_runlock(&lock));
+    ASSERT_SUCCESS(aws_scalable_rw_lock_runlock(&lock));
+
+    ASSERT_SUCCESS(aws_scalable_rw_lock_try_wlock(&lock));
+    ASSERT_SUCCESS(aws_scalable_rw_lock_wunlock(&lock));
+
+    aws_scalable_rw_lock_clean_up(&lock);
+
+    return 0;
+}
+AWS_TEST_CASE(scalable_rw_lock_acquire_release_test, s_test_scalable_rw_lock_acquire_release)
+
+#define SCALABLE_RW_LOCK_THREAD_COUNT 4
+#define SCALABLE_RW_LOCK_ITERATIONS 50000
+#define SCALABLE_RW_LOCK_WRITE_EVERY 64
+
+struct scalable_rw_lock_data {
+    struct aws_scalable_rw_lock lock;
+    /* written as a pair under the write lock; a reader seeing them differ means the lock failed */
+    volatile size_t first;
+    volatile size_t second;
+    struct aws_atomic_var torn_reads;
+};
+
+static void s_scalable_rw_lock_thread_fn(void *arg) {
+    struct scalable_rw_lock_data *data = arg;
+
+    for (size_t i = 1; i <= SCALABLE_RW_LOCK_ITERATIONS; ++i) {
+        if (i % SCALABLE_RW_LOCK_WRITE_EVERY == 0) {
+            aws_scalable_rw_lock_wlock(&data->lock);
+            size_t value = data->first + 1;
+            data->first = value;
+            data->second = value;
+            aws_scalable_rw_lock_wunlock(&data->lock);
+        } else {
+            aws_scalable_rw_lock_rlock(&data->lock);
+            if (data->first != data->second) {
+                aws_atomic_fetch_add(&data->torn_reads, 1);
+            }
+            aws_scalable_rw_lock_runlock(&data->lock);
+        }
+    }
+}
+
+static int s_test_scalable_rw_lock_is_actually_rw_lock(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct scalable_rw_lock_data data;
+    AWS_ZERO_STRUCT(data);
+    aws_atomic_init_int(&data.torn_reads, 0);
+    ASSERT_SUCCESS(aws_scalable_rw_lock_init(&data.lock, allocator));
+
+    struct aws_thread threads[SCALABLE_RW_LOCK_THREAD_COUNT];
+    for (size_t i = 0; i < SCALABLE_RW_LOCK_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_init(&threads[i], allocator));
+        ASSERT_SUCCESS(aws_thread_launch(&threads[i], s_scalable_rw_lock_thread_fn, &data, NULL));
+    }
+
+    for (size_t i = 0; i < SCALABLE_RW_LOCK_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_join(&threads[i]));
+        aws_thread_clean_up(&threads[i]);
+    }
+
+    ASSERT_UINT_EQUALS(0, aws_atomic_load_int(&data.torn_reads));
+    ASSERT_UINT_EQUALS(
+        SCALABLE_RW_LOCK_THREAD_COUNT * (SCALABLE_RW_LOCK_ITERATIONS / SCALABLE_RW_LOCK_WRITE_EVERY), data.first);
+    ASSERT_UINT_EQUALS(data.first, data.second);
+
+    aws_scalable_rw_lock_clean_up(&data.lock);
+
+    return 0;
+}
+AWS_TEST_CASE(scalable_rw_lock_is_actually_rw_lock_test, s_test_scalable_rw_lock_is_actually_rw_lock)
+
+static void s_scalable_rw_lock_writer_fn(void *arg) {
+    struct aws_scalable_rw_lock *lock = arg;
+    aws_scalable_rw_lock_wlock(lock);
+    aws_scalable_rw_lock_wunlock(lock);
+}
+
+static int s_test_scalable_rw_lock_writer_preference(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_scalable_rw_lock lock;
+    ASSERT_SUCCESS(aws_scalable_rw_lock_init(&lock, allocator));
+    ASSERT_SUCCESS(aws_scalable_rw_lock_rlock(&lock));
+
+    struct aws_thread thread;
+    ASSERT_SUCCESS(aws_thread_init(&thread, allocator));
+    ASSERT_SUCCESS(aws_thread_launch(&thread, s_scalable_rw_lock_writer_fn, &lock, NULL));
+
+    /* once the writer is waiting for us to leave, new readers have to queue behind it */
+    while (!aws_atomic_load_int(&lock.writer_active)) {
+        aws_thread_current_sleep(1000);
+    }
+    ASSERT_ERROR(AWS_ERROR_MUTEX_TIMEOUT, aws_scalable_rw_lock_try_rlock(&lock));
+
+    ASSERT_SUCCESS(aws_scalable_rw_lock_runlock(&lock));
+    ASSERT_SUCCESS(aws_thread_join(&thread));
+    aws_thread_clean_up(&thread);
+
+    ASSERT_SUCCESS(aws_scalable_rw_lock_try_rlock(&lock));
+    ASSERT_SUCCESS(aws_scalable_rw_lock_runlock(&lock));
+
+    aws_scalable_rw_lock_clean_up(&lock);
+
+    return 0;
+}
+AWS_TEST_CASE(scalable_rw_lock_writer_preference_test, s_test_scalable_rw_lock_writer_preference)
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/seqlock.h>
+
+#include <aws/common/thread.h>
+#include <aws/testing/aws_test_harness.h>
+
+static int s_test_seqlock_read_retry(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    struct aws_seqlock lock;
+    ASSERT_SUCCESS(aws_seqlock_init(&lock));
+
+    size_t sequence = aws_seqlock_read_begin(&lock);
+    ASSERT_FALSE(aws_seqlock_read_retry(&lock, sequence));
+
+    /* a write that overlaps the read, even a finished one, forces a retry */
+    ASSERT_SUCCESS(aws_seqlock_write_lock(&lock));
+    ASSERT_TRUE(aws_seqlock_read_retry(&lock, sequence));
+    ASSERT_SUCCESS(aws_seqlock_write_unlock(&lock));
+    ASSERT_TRUE(aws_seqlock_read_retry(&lock, sequence));
+
+    sequence = aws_seqlock_read_begin(&lock);
+    ASSERT_FALSE(aws_seqlock_read_retry(&lock, sequence));
+
+    uint64_t shared_value = 0;
+    uint64_t new_value = 42;
+    ASSERT_SUCCESS(aws_seqlock_write_copy(&lock, &shared_value, &new_value, sizeof(shared_value)));
+    ASSERT_TRUE(aws_seqlock_read_retry(&lock, sequence));
+
+    uint64_t read_value = 0;
+    aws_seqlock_read_copy(&lock, &read_value, &shared_value, sizeof(read_value));
+    ASSERT_UINT_EQUALS(42, read_value);
+
+    aws_seqlock_clean_up(&lock);
+
+    return 0;
+}
+AWS_TEST_CASE(seqlock_read_retry_test, s_test_seqlock_read_retry)
+
+#define SEQLOCK_READER_COUNT 3
+#define SEQLOCK_WRITES 20000
+
+/* large enough that a copy is never a single store */
+struct seqlock_snapshot {
+    uint64_t values[16];
+};
+
+struct seqlock_test_data {
+    struct aws_seqlock lock;
+    struct seqlock_snapshot shared;
+    struct aws_atomic_var writer_done;
+    struct aws_atomic_var torn_copies;
+};
+
+static void s_seqlock_writer_fn(void *arg) {
+    struct seqlock_test_data *data = arg;
+
+    for (uint64_t i = 1; i <= SEQLOCK_WRITES; ++i) {
+        struct seqlock_snapshot snapshot;
+        for (size_t j = 0; j < AWS_ARRAY_SIZE(snapshot.values); ++j) {
+            snapshot.values[j] = i;
+        }
+        aws_seqlock_write_copy(&data->lock, &data->shared, &snapshot, sizeof(snapshot));
+    }
+
+    aws_atomic_store_int(&data->writer_done, 1);
+}
+
+static void s_seqlock_reader_fn(void *arg) {
+    struct seqlock_test_data *data = arg;
+
+    uint64_t last_seen = 0;
+    while (!aws_atomic_load_int(&data->writer_done)) {
+        struct seqlock_snapshot snapshot;
+        aws_seqlock_read_copy(&data->lock, &snapshot, &data->shared, sizeof(snapshot));
+
+        bool torn = snapshot.values[0] < last_seen;
+        for (size_t j = 1; j < AWS_ARRAY_SIZE(snapshot.values); ++j) {
+            torn |= snapshot.values[j] != snapshot.values[0];
+        }
+        if (torn) {
+            aws_atomic_fetch_add(&data->torn_copies, 1);
+        }
+        last_seen = snapshot.values[0];
+    }
+}
+
+static int s_test_seqlock_concurrent_copy(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct seqlock_test_data data;
+    AWS_ZERO_STRUCT(data);
+    aws_atomic_init_int(&data.writer_done, 0);
+    aws_atomic_init_int(&data.torn_copies, 0);
+    ASSERT_SUCCESS(aws_seqlock_init(&data.lock));
+
+    struct aws_thread readers[SEQLOCK_READER_COUNT];
+    for (size_t i = 0; i < SEQLOCK_READER_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_init(&readers[i], allocator));
+        ASSERT_SUCCESS(aws_thread_launch(&readers[i], s_seqlock_reader_fn, &data, NULL));
+    }
+
+    struct aws_thread writer;
+    ASSERT_SUCCESS(aws_thread_init(&writer, allocator));
+    ASSERT_SUCCESS(aws_thread_launch(&writer, s_seqlock_writer_fn, &data, NULL));
+
+    ASSERT_SUCCESS(aws_thread_join(&writer));
+    aws_thread_clean_up(&writer);
+    for (size_t i = 0; i < SEQLOCK_READER_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_join(&readers[i]));
+        aws_thread_clean_up(&readers[i]);
+    }
+
+    ASSERT_UINT_EQUALS(0, aws_atomic_load_int(&data.torn_copies));
+    for (size_t j = 0; j < AWS_ARRAY_SIZE(data.shared.values); ++j) {
+        ASSERT_UINT_EQUALS(SEQLOCK_WRITES, data.shared.values[j]);
+    }
+
+    aws_seqlock_clean_up(&data.lock);
+
+    return 0;
+}
+AWS_TEST_CASE(seqlock_concurrent_copy_test, s_test_seqlock_concurrent_copy)
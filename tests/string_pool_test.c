@@ -0,0 +1,222 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <aws/common/string_pool.h>
+#include <aws/common/thread.h>
+
+#include <aws/testing/aws_test_harness.h>
+
+#include <stdio.h>
+
+static int s_test_string_pool_intern_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_string_pool pool;
+    ASSERT_SUCCESS(aws_string_pool_init(&pool, allocator, 8));
+
+    char buf[] = "content-type";
+    const struct aws_string *a = aws_string_pool_intern_c_str(&pool, "content-type");
+    const struct aws_string *b = aws_string_pool_intern(&pool, aws_byte_cursor_from_c_str(buf));
+    const struct aws_string *c = aws_string_pool_intern_c_str(&pool, "content-length");
+    const struct aws_string *empty = aws_string_pool_intern(&pool, aws_byte_cursor_from_array(NULL, 0));
+    ASSERT_NOT_NULL(a);
+    ASSERT_NOT_NULL(c);
+    ASSERT_NOT_NULL(empty);
+
+    ASSERT_PTR_EQUALS(a, b);
+    ASSERT_FALSE(a == c);
+    ASSERT_UINT_EQUALS(3, aws_string_pool_get_entry_count(&pool));
+
+    /* the pool keeps its own copy of the bytes */
+    buf[0] = 'X';
+    ASSERT_BIN_ARRAYS_EQUALS("content-type", 12, aws_string_bytes(a), a->len);
+    ASSERT_STR_EQUALS("content-type", (const char *)aws_string_bytes(a));
+    ASSERT_UINT_EQUALS(0, empty->len);
+    ASSERT_STR_EQUALS("", (const char *)aws_string_bytes(empty));
+
+    /* interned strings are owned by the pool, so destroying one does nothing */
+    ASSERT_NULL(a->allocator);
+    aws_string_destroy((struct aws_string *)a);
+    ASSERT_STR_EQUALS("content-type", (const char *)aws_string_bytes(a));
+
+    /* nor does a secure destroy wipe the bytes every holder shares, so interning them again still finds the string */
+    aws_string_destroy_secure((struct aws_string *)a);
+    ASSERT_STR_EQUALS("content-type", (const char *)aws_string_bytes(a));
+    const struct aws_string *again = aws_string_pool_intern_c_str(&pool, "content-type");
+    ASSERT_PTR_EQUALS(a, again);
+    ASSERT_UINT_EQUALS(3, aws_string_pool_get_entry_count(&pool));
+    aws_string_pool_release(&pool, again);
+
+    aws_string_pool_release(&pool, a);
+    aws_string_pool_release(&pool, b);
+    aws_string_pool_release(&pool, c);
+    aws_string_pool_release(&pool, empty);
+    ASSERT_UINT_EQUALS(0, aws_string_pool_get_entry_count(&pool));
+
+    aws_string_pool_clean_up(&pool);
+    return 0;
+}
+AWS_TEST_CASE(string_pool_intern, s_test_string_pool_intern_fn)
+
+static int s_test_string_pool_ref_count_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_string_pool pool;
+    ASSERT_SUCCESS(aws_string_pool_init(&pool, allocator, 8));
+
+    const struct aws_string *a = aws_string_pool_intern_c_str(&pool, "host");
+    ASSERT_PTR_EQUALS(a, aws_string_pool_acquire(&pool, a));
+    ASSERT_UINT_EQUALS(1, aws_string_pool_get_entry_count(&pool));
+
+    aws_string_pool_release(&pool, a);
+    ASSERT_UINT_EQUALS(1, aws_string_pool_get_entry_count(&pool));
+    aws_string_pool_release(&pool, a);
+    ASSERT_UINT_EQUALS(0, aws_string_pool_get_entry_count(&pool));
+
+    /* releasing NULL is allowed */
+    aws_string_pool_release(&pool, NULL);
+
+    /* immortal strings survive any number of releases */
+    const struct aws_string *immortal = aws_string_pool_intern_immortal(&pool, aws_byte_cursor_from_c_str("date"));
+    const struct aws_string *counted = aws_string_pool_intern_c_str(&pool, "date");
+    ASSERT_PTR_EQUALS(immortal, counted);
+    aws_string_pool_release(&pool, counted);
+    aws_string_pool_release(&pool, counted);
+    ASSERT_UINT_EQUALS(1, aws_string_pool_get_entry_count(&pool));
+
+    /* a counted string can be promoted to immortal */
+    const struct aws_string *promoted = aws_string_pool_intern_c_str(&pool, "server");
+    ASSERT_PTR_EQUALS(promoted, aws_string_pool_intern_immortal(&pool, aws_byte_cursor_from_c_str("server")));
+    aws_string_pool_release(&pool, promoted);
+    ASSERT_UINT_EQUALS(2, aws_string_pool_get_entry_count(&pool));
+
+    /* clean up frees everything, including outstanding counted references */
+    ASSERT_NOT_NULL(aws_string_pool_intern_c_str(&pool, "leaked"));
+    aws_string_pool_clean_up(&pool);
+    return 0;
+}
+AWS_TEST_CASE(string_pool_ref_count, s_test_string_pool_ref_count_fn)
+
+static int s_test_string_pool_hash_table_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_string_pool pool;
+    ASSERT_SUCCESS(aws_string_pool_init(&pool, allocator, 8));
+
+    struct aws_hash_table table;
+    ASSERT_SUCCESS(aws_hash_table_init(
+        &table, allocator, 8, aws_hash_interned_string, aws_hash_callback_interned_string_eq, NULL, NULL));
+
+    const struct aws_string *key = aws_string_pool_intern_c_str(&pool, "accept-encoding");
+    const struct aws_string *other = aws_string_pool_intern_c_str(&pool, "accept-language");
+    int value = 42;
+    ASSERT_SUCCESS(aws_hash_table_put(&table, key, &value, NULL));
+
+    /* the interned hash matches the content hash, so it is stable across pools */
+    struct aws_byte_cursor key_cur = aws_byte_cursor_from_string(key);
+    ASSERT_UINT_EQUALS(aws_hash_byte_cursor_ptr(&key_cur), aws_hash_interned_string(key));
+
+    /* looking up through a second intern of the same bytes finds the entry */
+    const struct aws_string *lookup = aws_string_pool_intern(&pool, aws_byte_cursor_from_c_str("accept-encoding"));
+    struct aws_hash_element *elem = NULL;
+    ASSERT_SUCCESS(aws_hash_table_find(&table, lookup, &elem));
+    ASSERT_NOT_NULL(elem);
+    ASSERT_PTR_EQUALS(&value, elem->value);
+
+    ASSERT_SUCCESS(aws_hash_table_find(&table, other, &elem));
+    ASSERT_NULL(elem);
+
+    ASSERT_TRUE(aws_hash_callback_interned_string_eq(key, lookup));
+    ASSERT_FALSE(aws_hash_callback_interned_string_eq(key, other));
+
+    aws_hash_table_clean_up(&table);
+    aws_string_pool_clean_up(&pool);
+    return 0;
+}
+AWS_TEST_CASE(string_pool_hash_table, s_test_string_pool_hash_table_fn)
+
+#define STRING_POOL_THREAD_COUNT 4
+#define STRING_POOL_KEY_COUNT 64
+#define STRING_POOL_ITERATIONS 200
+
+struct string_pool_thread_data {
+    struct aws_string_pool *pool;
+    const struct aws_string *results[STRING_POOL_KEY_COUNT];
+    bool failed;
+};
+
+static void s_string_pool_thread_fn(void *arg) {
+    struct string_pool_thread_data *data = arg;
+
+    for (int iteration = 0; iteration < STRING_POOL_ITERATIONS; ++iteration) {
+        for (int i = 0; i < STRING_POOL_KEY_COUNT; ++i) {
+            char key[32] = {0};
+            snprintf(key, sizeof(key), "key-%d", i);
+            const struct aws_string *str = aws_string_pool_intern_c_str(data->pool, key);
+            if (!str || strcmp(key, (const char *)aws_string_bytes(str)) != 0) {
+                data->failed = true;
+                return;
+            }
+
+            if (iteration == STRING_POOL_ITERATIONS - 1) {
+                data->results[i] = str;
+            } else {
+                aws_string_pool_release(data->pool, str);
+            }
+        }
+    }
+}
+
+static int s_test_string_pool_threaded_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_string_pool pool;
+    ASSERT_SUCCESS(aws_string_pool_init(&pool, allocator, 8));
+
+    struct aws_thread threads[STRING_POOL_THREAD_COUNT];
+    struct string_pool_thread_data data[STRING_POOL_THREAD_COUNT];
+    AWS_ZERO_ARRAY(data);
+
+    for (size_t i = 0; i < STRING_POOL_THREAD_COUNT; ++i) {
+        data[i].pool = &pool;
+        ASSERT_SUCCESS(aws_thread_init(&threads[i], allocator));
+        ASSERT_SUCCESS(aws_thread_launch(&threads[i], s_string_pool_thread_fn, &data[i], NULL));
+    }
+
+    for (size_t i = 0; i < STRING_POOL_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_join(&threads[i]));
+        aws_thread_clean_up(&threads[i]);
+        ASSERT_FALSE(data[i].failed);
+    }
+
+    /* every thread saw the same pointer for the same key */
+    ASSERT_UINT_EQUALS(STRING_POOL_KEY_COUNT, aws_string_pool_get_entry_count(&pool));
+    for (size_t i = 0; i < STRING_POOL_KEY_COUNT; ++i) {
+        for (size_t t = 1; t < STRING_POOL_THREAD_COUNT; ++t) {
+            ASSERT_PTR_EQUALS(data[0].results[i], data[t].results[i]);
+        }
+    }
+
+    for (size_t t = 0; t < STRING_POOL_THREAD_COUNT; ++t) {
+        for (size_t i = 0; i < STRING_POOL_KEY_COUNT; ++i) {
+            aws_string_pool_release(&pool, data[t].results[i]);
+        }
+    }
+    ASSERT_UINT_EQUALS(0, aws_string_pool_get_entry_count(&pool));
+
+    aws_string_pool_clean_up(&pool);
+    return 0;
+}
+AWS_TEST_CASE(string_pool_threaded, s_test_string_pool_threaded_fn)
@@ -31,3 +31,53 @@ static int s_test_cpu_count_at_least_works_superficially_fn(struct aws_allocator
 }
 
 AWS_TEST_CASE(test_cpu_count_at_least_works_superficially, s_test_cpu_count_at_least_works_superficially_fn)
+
+static int s_test_cpu_topology_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_cpu_topology topology;
+    ASSERT_SUCCESS(aws_system_info_cpu_topology_init(&topology, allocator));
+
+    ASSERT_TRUE(topology.logical_cpu_count > 0);
+#if defined(__linux__)
+    ASSERT_UINT_EQUALS(aws_system_info_processor_count(), topology.logical_cpu_count);
+#endif
+    ASSERT_TRUE(topology.physical_core_count > 0);
+    ASSERT_TRUE(topology.physical_core_count <= topology.logical_cpu_count);
+    ASSERT_TRUE(topology.package_count > 0);
+    ASSERT_TRUE(topology.package_count <= topology.physical_core_count);
+    ASSERT_TRUE(topology.numa_node_count > 0);
+    ASSERT_TRUE(topology.max_smt_siblings > 0);
+    ASSERT_TRUE(topology.max_smt_siblings * topology.physical_core_count >= topology.logical_cpu_count);
+
+    for (size_t i = 0; i < topology.logical_cpu_count; ++i) {
+        const struct aws_cpu_info *cpu = &topology.cpus[i];
+        if (i > 0) {
+            ASSERT_TRUE(cpu->cpu_id > topology.cpus[i - 1].cpu_id);
+        }
+        ASSERT_TRUE(cpu->core_index < topology.physical_core_count);
+        ASSERT_PTR_EQUALS(cpu, aws_cpu_topology_get_cpu(&topology, cpu->cpu_id));
+    }
+    ASSERT_NULL(aws_cpu_topology_get_cpu(&topology, topology.cpus[topology.logical_cpu_count - 1].cpu_id + 1));
+
+    const struct aws_cache_info *caches[] = {
+        &topology.l1_data_cache,
+        &topology.l1_instruction_cache,
+        &topology.l2_cache,
+        &topology.l3_cache,
+    };
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(caches); ++i) {
+        /* sizes are unknown in some virtualized environments, but reported ones must be sane */
+        if (caches[i]->size) {
+            ASSERT_TRUE(caches[i]->shared_cpu_count > 0);
+            ASSERT_TRUE(caches[i]->line_size == 0 || caches[i]->size % caches[i]->line_size == 0);
+        }
+    }
+
+    aws_system_info_cpu_topology_clean_up(&topology);
+    ASSERT_NULL(topology.cpus);
+
+    return 0;
+}
+
+AWS_TEST_CASE(test_cpu_topology, s_test_cpu_topology_fn)
@@ -13,10 +13,20 @@
  *  permissions and limitations under the License.
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+/* for pthread_getname_np() and sched_getaffinity() */
+#    define _GNU_SOURCE
+#endif
+
 #include <aws/common/thread.h>
 
 #include <aws/testing/aws_test_harness.h>
 
+#if defined(__linux__)
+#    include <pthread.h>
+#    include <sched.h>
+#endif
+
 struct thread_test_data {
     uint64_t thread_id;
 };
@@ -53,3 +63,111 @@ static int s_test_thread_creation_join_fn(struct aws_allocator *allocator, void
 }
 
 AWS_TEST_CASE(thread_creation_join_test, s_test_thread_creation_join_fn)
+
+struct thread_options_test_data {
+    bool ran;
+    char name[AWS_THREAD_NAME_RECOMMENDED_MAX + 1];
+    bool pinned_to_cpu_0;
+};
+
+static void s_thread_options_fn(void *arg) {
+    struct thread_options_test_data *test_data = (struct thread_options_test_data *)arg;
+    test_data->ran = true;
+#if defined(__linux__)
+    pthread_getname_np(pthread_self(), test_data->name, sizeof(test_data->name));
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    if (!sched_getaffinity(0, sizeof(cpus), &cpus)) {
+        test_data->pinned_to_cpu_0 = CPU_COUNT(&cpus) == 1 && CPU_ISSET(0, &cpus);
+    }
+#endif
+}
+
+static int s_test_thread_launch_with_options_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    struct thread_options_test_data test_data;
+    AWS_ZERO_STRUCT(test_data);
+
+    const size_t cpus[] = {0};
+    struct aws_thread_options options = {
+        .cpu_affinity = cpus,
+        .cpu_affinity_count = AWS_ARRAY_SIZE(cpus),
+        .name = "aws-test-worker",
+        .priority = AWS_THREAD_PRIORITY_LOW,
+    };
+
+    struct aws_thread thread;
+    aws_thread_init(&thread, allocator);
+    ASSERT_SUCCESS(aws_thread_launch(&thread, s_thread_options_fn, &test_data, &options));
+    ASSERT_SUCCESS(aws_thread_join(&thread));
+    aws_thread_clean_up(&thread);
+
+    ASSERT_TRUE(test_data.ran);
+#if defined(__linux__)
+    ASSERT_STR_EQUALS("aws-test-worker", test_data.name);
+    ASSERT_TRUE(test_data.pinned_to_cpu_0);
+#endif
+
+    return 0;
+}
+
+AWS_TEST_CASE(thread_launch_with_options_test, s_test_thread_launch_with_options_fn)
+
+static int s_test_thread_launch_numa_node_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    struct thread_options_test_data test_data;
+    AWS_ZERO_STRUCT(test_data);
+
+    /* node 0 always exists, even on machines without NUMA */
+    struct aws_thread_options options = {
+        .name = "a-name-longer-than-the-platform-allows",
+        .prefer_numa_node = true,
+        .numa_node = 0,
+    };
+
+    struct aws_thread thread;
+    aws_thread_init(&thread, allocator);
+    ASSERT_SUCCESS(aws_thread_launch(&thread, s_thread_options_fn, &test_data, &options));
+    ASSERT_SUCCESS(aws_thread_join(&thread));
+    aws_thread_clean_up(&thread);
+
+    ASSERT_TRUE(test_data.ran);
+#if defined(__linux__)
+    /* names are truncated rather than rejected */
+    ASSERT_STR_EQUALS("a-name-longer-t", test_data.name);
+#endif
+
+    return 0;
+}
+
+AWS_TEST_CASE(thread_launch_numa_node_test, s_test_thread_launch_numa_node_fn)
+
+static int s_test_thread_launch_invalid_affinity_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    struct thread_options_test_data test_data;
+    AWS_ZERO_STRUCT(test_data);
+
+    const size_t cpus[] = {1 << 20};
+    struct aws_thread_options options = {
+        .cpu_affinity = cpus,
+        .cpu_affinity_count = AWS_ARRAY_SIZE(cpus),
+    };
+
+    struct aws_thread thread;
+    aws_thread_init(&thread, allocator);
+#if defined(__linux__) || defined(_WIN32)
+    ASSERT_FAILS(aws_thread_launch(&thread, s_thread_options_fn, &test_data, &options));
+    ASSERT_INT_EQUALS(AWS_ERROR_THREAD_INVALID_SETTINGS, aws_last_error());
+    ASSERT_FALSE(test_data.ran);
+#else
+    /* affinity is ignored where the platform has no way to set it */
+    ASSERT_SUCCESS(aws_thread_launch(&thread, s_thread_options_fn, &test_data, &options));
+    ASSERT_SUCCESS(aws_thread_join(&thread));
+#endif
+    aws_thread_clean_up(&thread);
+
+    return 0;
+}
+
+AWS_TEST_CASE(thread_launch_invalid_affinity_test, s_test_thread_launch_invalid_affinity_fn)
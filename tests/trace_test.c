@@ -0,0 +1,422 @@
+/*
+ * Copyright 2010-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/* these tests exercise trace points themselves, even in builds that compile them out of the library */
+#ifdef AWS_DISABLE_TRACING
+#    define LIBRARY_TRACE_POINTS_DISABLED
+#    undef AWS_DISABLE_TRACING
+#endif
+#include <aws/common/trace.h>
+
+#include <aws/common/mutex.h>
+#include <aws/common/task_scheduler.h>
+#include <aws/common/thread.h>
+
+#include <aws/testing/aws_test_harness.h>
+
+enum test_event {
+    TEST_EVENT_PING = AWS_TRACE_EVENT_USER_FIRST,
+    TEST_EVENT_QUEUE_DEPTH,
+    TEST_EVENT_UNNAMED,
+};
+
+static size_t s_count_substrings(const struct aws_byte_buf *buf, const char *substring) {
+    struct aws_byte_cursor remaining = aws_byte_cursor_from_buf(buf);
+    struct aws_byte_cursor to_find = aws_byte_cursor_from_c_str(substring);
+    struct aws_byte_cursor found;
+    size_t count = 0;
+    while (aws_byte_cursor_find_substring(&remaining, &to_find, &found)) {
+        ++count;
+        remaining = found;
+        aws_byte_cursor_advance(&remaining, to_find.len);
+    }
+    return count;
+}
+
+static int s_trace_record_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    /* rounded up to 8 */
+    ASSERT_SUCCESS(aws_trace_init(allocator, 5));
+    ASSERT_ERROR(AWS_ERROR_INVALID_STATE, aws_trace_init(allocator, 5));
+    ASSERT_SUCCESS(aws_trace_register_event(TEST_EVENT_PING, "ping", AWS_TRACE_PHASE_INSTANT));
+
+    struct aws_trace_event events[16];
+    ASSERT_FALSE(aws_trace_is_enabled());
+    AWS_TRACE_EVENT(TEST_EVENT_PING, 1, 2);
+    ASSERT_UINT_EQUALS(0, aws_trace_get_thread_events(events, AWS_ARRAY_SIZE(events)));
+
+    aws_trace_set_enabled(true);
+    ASSERT_TRUE(aws_trace_is_enabled());
+    for (uint64_t i = 0; i < 3; ++i) {
+        AWS_TRACE_EVENT(TEST_EVENT_PING, i, i * 10);
+    }
+    ASSERT_UINT_EQUALS(3, aws_trace_get_thread_events(events, AWS_ARRAY_SIZE(events)));
+    for (uint64_t i = 0; i < 3; ++i) {
+        ASSERT_UINT_EQUALS(TEST_EVENT_PING, events[i].event_id);
+        ASSERT_UINT_EQUALS(i, events[i].arg0);
+        ASSERT_UINT_EQUALS(i * 10, events[i].arg1);
+        if (i > 0) {
+            ASSERT_TRUE(events[i].timestamp >= events[i - 1].timestamp);
+        }
+    }
+
+    /* asking for fewer returns the newest */
+    ASSERT_UINT_EQUALS(2, aws_trace_get_thread_events(events, 2));
+    ASSERT_UINT_EQUALS(1, events[0].arg0);
+    ASSERT_UINT_EQUALS(2, events[1].arg0);
+
+    /* once the ring wraps only the newest 8 are kept */
+    for (uint64_t i = 3; i < 20; ++i) {
+        AWS_TRACE_EVENT(TEST_EVENT_PING, i, 0);
+    }
+    ASSERT_UINT_EQUALS(8, aws_trace_get_thread_events(events, AWS_ARRAY_SIZE(events)));
+    for (size_t i = 0; i < 8; ++i) {
+        ASSERT_UINT_EQUALS(12 + i, events[i].arg0);
+    }
+
+    /* out of range ids are dropped */
+    aws_trace_record(AWS_TRACE_MAX_EVENTS, 100, 100);
+    ASSERT_UINT_EQUALS(8, aws_trace_get_thread_events(events, AWS_ARRAY_SIZE(events)));
+    ASSERT_UINT_EQUALS(19, events[7].arg0);
+
+    aws_trace_clear();
+    ASSERT_UINT_EQUALS(0, aws_trace_get_thread_events(events, AWS_ARRAY_SIZE(events)));
+    AWS_TRACE_EVENT(TEST_EVENT_PING, 42, 0);
+    ASSERT_UINT_EQUALS(1, aws_trace_get_thread_events(events, AWS_ARRAY_SIZE(events)));
+    ASSERT_UINT_EQUALS(42, events[0].arg0);
+
+    aws_trace_set_enabled(false);
+    AWS_TRACE_EVENT(TEST_EVENT_PING, 43, 0);
+    ASSERT_UINT_EQUALS(1, aws_trace_get_thread_events(events, AWS_ARRAY_SIZE(events)));
+
+    aws_trace_clean_up();
+    ASSERT_FALSE(aws_trace_is_enabled());
+    ASSERT_UINT_EQUALS(0, aws_trace_get_thread_events(events, AWS_ARRAY_SIZE(events)));
+
+    /* a thread that recorded before a clean up gets a fresh ring after the next init */
+    ASSERT_SUCCESS(aws_trace_init(allocator, 4));
+    aws_trace_record(TEST_EVENT_PING, 7, 0);
+    ASSERT_UINT_EQUALS(1, aws_trace_get_thread_events(events, AWS_ARRAY_SIZE(events)));
+    ASSERT_UINT_EQUALS(7, events[0].arg0);
+    aws_trace_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(trace_record, s_trace_record_fn)
+
+static int s_trace_register_event_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    ASSERT_ERROR(AWS_ERROR_INVALID_STATE, aws_trace_register_event(TEST_EVENT_PING, "ping", AWS_TRACE_PHASE_INSTANT));
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_trace_init(allocator, 0));
+
+    ASSERT_SUCCESS(aws_trace_init(allocator, 16));
+    ASSERT_SUCCESS(aws_trace_register_event(TEST_EVENT_PING, "ping", AWS_TRACE_PHASE_INSTANT));
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT, aws_trace_register_event(AWS_TRACE_MAX_EVENTS, "ping", AWS_TRACE_PHASE_INSTANT));
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_trace_register_event(TEST_EVENT_PING, "", AWS_TRACE_PHASE_INSTANT));
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT, aws_trace_register_event(TEST_EVENT_PING, "a\"b", AWS_TRACE_PHASE_INSTANT));
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT, aws_trace_register_event(TEST_EVENT_PING, "a\\b", AWS_TRACE_PHASE_INSTANT));
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT, aws_trace_register_event(TEST_EVENT_PING, "a\nb", AWS_TRACE_PHASE_INSTANT));
+
+    char long_name[AWS_TRACE_MAX_EVENT_NAME_LEN + 2];
+    memset(long_name, 'x', sizeof(long_name) - 1);
+    long_name[sizeof(long_name) - 1] = '\0';
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT, aws_trace_register_event(TEST_EVENT_PING, long_name, AWS_TRACE_PHASE_INSTANT));
+    long_name[sizeof(long_name) - 2] = '\0';
+    ASSERT_SUCCESS(aws_trace_register_event(TEST_EVENT_PING, long_name, AWS_TRACE_PHASE_INSTANT));
+
+    aws_trace_clean_up();
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(trace_register_event, s_trace_register_event_fn)
+
+static void s_noop_task_fn(struct aws_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    (void)arg;
+    (void)status;
+}
+
+static int s_trace_dump_json_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    ASSERT_SUCCESS(aws_trace_init(allocator, 64));
+    ASSERT_SUCCESS(aws_trace_register_event(TEST_EVENT_PING, "ping", AWS_TRACE_PHASE_INSTANT));
+    ASSERT_SUCCESS(aws_trace_register_event(TEST_EVENT_QUEUE_DEPTH, "queue_depth", AWS_TRACE_PHASE_COUNTER));
+
+    /* nothing recorded yet is still a valid trace */
+    struct aws_byte_buf json;
+    ASSERT_SUCCESS(aws_trace_dump_json(&json, allocator));
+    ASSERT_BIN_ARRAYS_EQUALS(
+        "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n",
+        strlen("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n"),
+        json.buffer,
+        json.len);
+    aws_byte_buf_clean_up(&json);
+
+    aws_trace_set_enabled(true);
+    AWS_TRACE_EVENT(TEST_EVENT_PING, 1, 2);
+    AWS_TRACE_EVENT(TEST_EVENT_QUEUE_DEPTH, 18446744073709551615ULL, 0);
+    AWS_TRACE_EVENT(TEST_EVENT_UNNAMED, 3, 4);
+
+    struct aws_task_scheduler scheduler;
+    ASSERT_SUCCESS(aws_task_scheduler_init(&scheduler, allocator));
+    struct aws_task task;
+    aws_task_init(&task, s_noop_task_fn, NULL);
+    aws_task_scheduler_schedule_now(&scheduler, &task);
+    aws_task_scheduler_run_all(&scheduler, 0);
+    aws_task_scheduler_clean_up(&scheduler);
+    aws_trace_set_enabled(false);
+
+    ASSERT_SUCCESS(aws_trace_dump_json(&json, allocator));
+#ifdef LIBRARY_TRACE_POINTS_DISABLED
+    ASSERT_UINT_EQUALS(3, s_count_substrings(&json, "\"tid\":"));
+#else
+    ASSERT_UINT_EQUALS(5, s_count_substrings(&json, "\"tid\":"));
+    ASSERT_UINT_EQUALS(1, s_count_substrings(&json, "{\"name\":\"task_run\",\"cat\":\"aws\",\"ph\":\"B\""));
+    ASSERT_UINT_EQUALS(1, s_count_substrings(&json, "{\"name\":\"task_run\",\"cat\":\"aws\",\"ph\":\"E\""));
+#endif
+    ASSERT_UINT_EQUALS(
+        1, s_count_substrings(&json, "{\"name\":\"ping\",\"cat\":\"aws\",\"ph\":\"i\",\"s\":\"t\",\"ts\":"));
+    ASSERT_UINT_EQUALS(1, s_count_substrings(&json, "\"args\":{\"arg0\":1,\"arg1\":2}}"));
+    ASSERT_UINT_EQUALS(1, s_count_substrings(&json, "{\"name\":\"queue_depth\",\"cat\":\"aws\",\"ph\":\"C\",\"ts\":"));
+    ASSERT_UINT_EQUALS(1, s_count_substrings(&json, "\"args\":{\"arg0\":18446744073709551615,\"arg1\":0}}"));
+    ASSERT_UINT_EQUALS(1, s_count_substrings(&json, "{\"name\":\"event_18\",\"cat\":\"aws\",\"ph\":\"i\""));
+
+    /* the last line closes the array and object */
+    ASSERT_TRUE(json.len > 4);
+    ASSERT_BIN_ARRAYS_EQUALS("}\n]}\n", 5, json.buffer + json.len - 5, 5);
+    aws_byte_buf_clean_up(&json);
+
+    aws_trace_clean_up();
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(trace_dump_json, s_trace_dump_json_fn)
+
+static void s_trace_lock_waiter_fn(void *arg) {
+    struct aws_mutex *mutex = arg;
+    aws_mutex_lock(mutex);
+    aws_mutex_unlock(mutex);
+}
+
+static int s_trace_lock_and_allocation_events_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    ASSERT_SUCCESS(aws_trace_init(allocator, 64));
+    aws_trace_set_enabled(true);
+
+    /* allocations are only traced once asked for */
+    void *untraced = aws_mem_acquire(allocator, 12345);
+    ASSERT_NOT_NULL(untraced);
+    aws_mem_release(allocator, untraced);
+
+    aws_trace_set_allocations_enabled(true);
+    void *traced = aws_mem_acquire(allocator, 23456);
+    ASSERT_NOT_NULL(traced);
+    aws_mem_release(allocator, traced);
+    aws_trace_set_allocations_enabled(false);
+
+    /* another thread waits for a profiled mutex this one holds */
+    struct aws_mutex mutex;
+    ASSERT_SUCCESS(aws_mutex_init(&mutex));
+    ASSERT_SUCCESS(aws_mutex_enable_profiling(&mutex, allocator, NULL));
+    ASSERT_SUCCESS(aws_mutex_lock(&mutex));
+    struct aws_thread thread;
+    ASSERT_SUCCESS(aws_thread_init(&thread, allocator));
+    ASSERT_SUCCESS(aws_thread_launch(&thread, s_trace_lock_waiter_fn, &mutex, NULL));
+    aws_thread_current_sleep(10 * 1000 * 1000);
+    ASSERT_SUCCESS(aws_mutex_unlock(&mutex));
+    ASSERT_SUCCESS(aws_thread_join(&thread));
+    aws_thread_clean_up(&thread);
+    aws_mutex_clean_up(&mutex);
+    aws_trace_set_enabled(false);
+
+    char traced_args[64];
+    snprintf(traced_args, sizeof(traced_args), "\"args\":{\"arg0\":%llu,", (unsigned long long)(uintptr_t)traced);
+    char lock_args[64];
+    snprintf(lock_args, sizeof(lock_args), "\"args\":{\"arg0\":%llu,", (unsigned long long)(uintptr_t)&mutex);
+
+    struct aws_byte_buf json;
+    ASSERT_SUCCESS(aws_trace_dump_json(&json, allocator));
+#ifdef LIBRARY_TRACE_POINTS_DISABLED
+    ASSERT_UINT_EQUALS(0, s_count_substrings(&json, "\"tid\":"));
+#else
+    ASSERT_UINT_EQUALS(3, s_count_substrings(&json, "\"tid\":"));
+    ASSERT_UINT_EQUALS(1, s_count_substrings(&json, "{\"name\":\"mem_acquire\",\"cat\":\"aws\",\"ph\":\"i\""));
+    ASSERT_UINT_EQUALS(1, s_count_substrings(&json, ",\"arg1\":23456}}"));
+    ASSERT_UINT_EQUALS(0, s_count_substrings(&json, ",\"arg1\":12345}}"));
+    ASSERT_UINT_EQUALS(1, s_count_substrings(&json, "{\"name\":\"mem_release\",\"cat\":\"aws\",\"ph\":\"i\""));
+    ASSERT_UINT_EQUALS(2, s_count_substrings(&json, traced_args));
+    ASSERT_UINT_EQUALS(1, s_count_substrings(&json, "{\"name\":\"lock_wait\",\"cat\":\"aws\",\"ph\":\"i\""));
+    ASSERT_UINT_EQUALS(1, s_count_substrings(&json, lock_args));
+#endif
+    aws_byte_buf_clean_up(&json);
+
+    aws_trace_clean_up();
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(trace_lock_and_allocation_events, s_trace_lock_and_allocation_events_fn)
+
+#define TRACE_THREADS 4
+#define TRACE_EVENTS_PER_THREAD 5000
+
+/* set once the dumps racing the threads are done; an exited thread's events would only be in the next dump */
+static struct aws_atomic_var s_dumps_done;
+
+static void s_trace_thread_fn(void *arg) {
+    uint64_t thread_index = (uint64_t)(uintptr_t)arg;
+    for (uint64_t i = 0; i < TRACE_EVENTS_PER_THREAD; ++i) {
+        AWS_TRACE_EVENT(TEST_EVENT_PING, thread_index, i);
+    }
+    while (!aws_atomic_load_int(&s_dumps_done)) {
+        aws_thread_current_sleep(1000000);
+    }
+}
+
+static int s_trace_concurrent_dump_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    /* small rings, so threads wrap around while the dumps below are reading them */
+    ASSERT_SUCCESS(aws_trace_init(allocator, 256));
+    ASSERT_SUCCESS(aws_trace_register_event(TEST_EVENT_PING, "ping", AWS_TRACE_PHASE_INSTANT));
+    aws_trace_set_enabled(true);
+    aws_atomic_init_int(&s_dumps_done, 0);
+
+    struct aws_thread threads[TRACE_THREADS];
+    for (size_t i = 0; i < TRACE_THREADS; ++i) {
+        ASSERT_SUCCESS(aws_thread_init(&threads[i], allocator));
+        ASSERT_SUCCESS(aws_thread_launch(&threads[i], s_trace_thread_fn, (void *)(uintptr_t)i, NULL));
+    }
+
+    for (size_t i = 0; i < 20; ++i) {
+        struct aws_byte_buf json;
+        ASSERT_SUCCESS(aws_trace_dump_json(&json, allocator));
+        ASSERT_TRUE(s_count_substrings(&json, "\"tid\":") <= TRACE_THREADS * 256);
+        aws_byte_buf_clean_up(&json);
+    }
+    aws_atomic_store_int(&s_dumps_done, 1);
+
+    for (size_t i = 0; i < TRACE_THREADS; ++i) {
+        ASSERT_SUCCESS(aws_thread_join(&threads[i]));
+        aws_thread_clean_up(&threads[i]);
+    }
+    aws_trace_set_enabled(false);
+
+    /* each exited thread's ring is kept for this dump, ending with its last 256 events */
+    struct aws_byte_buf json;
+    ASSERT_SUCCESS(aws_trace_dump_json(&json, allocator));
+    ASSERT_UINT_EQUALS(TRACE_THREADS * 256, s_count_substrings(&json, "\"tid\":"));
+    ASSERT_UINT_EQUALS(TRACE_THREADS, s_count_substrings(&json, ",\"arg1\":4999}}"));
+    ASSERT_UINT_EQUALS(TRACE_THREADS, s_count_substrings(&json, ",\"arg1\":4744}}"));
+    ASSERT_UINT_EQUALS(0, s_count_substrings(&json, ",\"arg1\":4743}}"));
+    aws_byte_buf_clean_up(&json);
+
+    aws_trace_clean_up();
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(trace_concurrent_dump, s_trace_concurrent_dump_fn)
+
+/* Counts the blocks outstanding in the allocator it wraps, which is impl. */
+static size_t s_rings_outstanding;
+
+static void *s_counting_acquire(struct aws_allocator *allocator, size_t size) {
+    void *mem = aws_mem_acquire(allocator->impl, size);
+    if (mem) {
+        ++s_rings_outstanding;
+    }
+    return mem;
+}
+
+static void s_counting_release(struct aws_allocator *allocator, void *ptr) {
+    --s_rings_outstanding;
+    aws_mem_release(allocator->impl, ptr);
+}
+
+static void s_trace_one_event_fn(void *arg) {
+    AWS_TRACE_EVENT(TEST_EVENT_PING, 0, (uint64_t)(uintptr_t)arg);
+}
+
+static int s_trace_exited_thread(struct aws_allocator *allocator, uint64_t arg1) {
+    struct aws_thread thread;
+    ASSERT_SUCCESS(aws_thread_init(&thread, allocator));
+    ASSERT_SUCCESS(aws_thread_launch(&thread, s_trace_one_event_fn, (void *)(uintptr_t)arg1, NULL));
+    ASSERT_SUCCESS(aws_thread_join(&thread));
+    aws_thread_clean_up(&thread);
+    return AWS_OP_SUCCESS;
+}
+
+static int s_trace_exited_threads_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_allocator counting_allocator = {
+        .mem_acquire = s_counting_acquire,
+        .mem_release = s_counting_release,
+        .mem_realloc = NULL,
+        .impl = allocator,
+    };
+    s_rings_outstanding = 0;
+
+    ASSERT_SUCCESS(aws_trace_init(&counting_allocator, 16));
+    ASSERT_SUCCESS(aws_trace_register_event(TEST_EVENT_PING, "ping", AWS_TRACE_PHASE_INSTANT));
+    aws_trace_set_enabled(true);
+
+    /* one ring per thread, but only the newest AWS_TRACE_MAX_RETIRED_RINGS are kept once their threads exit */
+    for (uint64_t i = 0; i < 2 * AWS_TRACE_MAX_RETIRED_RINGS; ++i) {
+        ASSERT_SUCCESS(s_trace_exited_thread(allocator, i));
+        ASSERT_TRUE(s_rings_outstanding <= AWS_TRACE_MAX_RETIRED_RINGS);
+    }
+    ASSERT_UINT_EQUALS(AWS_TRACE_MAX_RETIRED_RINGS, s_rings_outstanding);
+
+    char newest[32];
+    char evicted[32];
+    snprintf(newest, sizeof(newest), ",\"arg1\":%d}}", 2 * AWS_TRACE_MAX_RETIRED_RINGS - 1);
+    snprintf(evicted, sizeof(evicted), ",\"arg1\":%d}}", AWS_TRACE_MAX_RETIRED_RINGS - 1);
+
+    struct aws_byte_buf json;
+    ASSERT_SUCCESS(aws_trace_dump_json(&json, allocator));
+    ASSERT_UINT_EQUALS(AWS_TRACE_MAX_RETIRED_RINGS, s_count_substrings(&json, "\"tid\":"));
+    ASSERT_UINT_EQUALS(1, s_count_substrings(&json, newest));
+    ASSERT_UINT_EQUALS(0, s_count_substrings(&json, evicted));
+    aws_byte_buf_clean_up(&json);
+
+    /* exited threads show up in one dump only */
+    ASSERT_SUCCESS(aws_trace_dump_json(&json, allocator));
+    ASSERT_UINT_EQUALS(0, s_count_substrings(&json, "\"tid\":"));
+    aws_byte_buf_clean_up(&json);
+
+    /* and new threads reuse their rings */
+    ASSERT_SUCCESS(s_trace_exited_thread(allocator, 1000));
+    ASSERT_UINT_EQUALS(AWS_TRACE_MAX_RETIRED_RINGS, s_rings_outstanding);
+    ASSERT_SUCCESS(aws_trace_dump_json(&json, allocator));
+    ASSERT_UINT_EQUALS(1, s_count_substrings(&json, "\"tid\":"));
+    ASSERT_UINT_EQUALS(1, s_count_substrings(&json, ",\"arg1\":1000}}"));
+    aws_byte_buf_clean_up(&json);
+
+    aws_trace_clean_up();
+    ASSERT_UINT_EQUALS(0, s_rings_outstanding);
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(trace_exited_threads, s_trace_exited_threads_fn)
@@ -15,6 +15,8 @@
 #include <aws/common/uuid.h>
 
 #include <aws/common/byte_buf.h>
+#include <aws/common/clock.h>
+#include <aws/common/hash_table.h>
 
 #include <aws/testing/aws_test_harness.h>
 
@@ -29,6 +31,9 @@ static int s_uuid_string_fn(struct aws_allocator *allocator, void *ctx) {
     struct aws_byte_buf uuid_buf = aws_byte_buf_from_array(uuid_array, sizeof(uuid_array));
     uuid_buf.len = 0;
 
+    ASSERT_UINT_EQUALS(0x40, uuid.uuid_data[6] & 0xF0);
+    ASSERT_UINT_EQUALS(0x80, uuid.uuid_data[8] & 0xC0);
+
     ASSERT_SUCCESS(aws_uuid_to_str(&uuid, &uuid_buf));
     uint8_t zerod_buf[AWS_UUID_STR_LEN] = {0};
     ASSERT_UINT_EQUALS(AWS_UUID_STR_LEN - 1, uuid_buf.len);
@@ -131,3 +136,258 @@ static int s_uuid_string_parse_malformed_fn(struct aws_allocator *allocator, voi
 }
 
 AWS_TEST_CASE(uuid_string_parse_malformed, s_uuid_string_parse_malformed_fn)
+
+static int s_uuid_string_parse_invalid_hex_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    static const char *s_invalid[] = {
+        "01020304-0506-0708-090a-0b0c0d0e0f1g",
+        "0102030g-0506-0708-090a-0b0c0d0e0f10",
+        "01020304-0506-0708-090a-0b0c0d0e0f 1",
+        "01020304-05-6-0708-090a-0b0c0d0e0f10",
+        "01020304+0506-0708-090a-0b0c0d0e0f10",
+    };
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_invalid); ++i) {
+        struct aws_byte_cursor uuid_cur = aws_byte_cursor_from_c_str(s_invalid[i]);
+        struct aws_uuid uuid;
+        ASSERT_ERROR(AWS_ERROR_MALFORMED_INPUT_STRING, aws_uuid_init_from_str(&uuid, &uuid_cur));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(uuid_string_parse_invalid_hex, s_uuid_string_parse_invalid_hex_fn)
+
+static int s_uuid_string_round_trip_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    uint8_t expected_uuid[] = {
+        0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0xFF, 0x00, 0x10, 0x9A, 0xBC};
+    struct aws_byte_cursor upper_cur = aws_byte_cursor_from_c_str("ABCDEF01-2345-6789-ABCD-EFFF00109ABC");
+
+    struct aws_uuid uuid;
+    ASSERT_SUCCESS(aws_uuid_init_from_str(&uuid, &upper_cur));
+    ASSERT_BIN_ARRAYS_EQUALS(expected_uuid, sizeof(expected_uuid), uuid.uuid_data, sizeof(uuid.uuid_data));
+
+    uint8_t uuid_array[AWS_UUID_STR_LEN] = {0};
+    struct aws_byte_buf uuid_buf = aws_byte_buf_from_empty_array(uuid_array, sizeof(uuid_array));
+    ASSERT_SUCCESS(aws_uuid_to_str(&uuid, &uuid_buf));
+    ASSERT_BIN_ARRAYS_EQUALS(
+        "abcdef01-2345-6789-abcd-efff00109abc", AWS_UUID_STR_LEN - 1, uuid_buf.buffer, uuid_buf.len);
+    ASSERT_UINT_EQUALS(0, uuid_array[AWS_UUID_STR_LEN - 1]);
+
+    for (size_t i = 0; i < 100; ++i) {
+        struct aws_uuid random_uuid;
+        struct aws_uuid parsed;
+        ASSERT_SUCCESS(aws_uuid_init(&random_uuid));
+        uuid_buf.len = 0;
+        ASSERT_SUCCESS(aws_uuid_to_str(&random_uuid, &uuid_buf));
+        struct aws_byte_cursor uuid_cur = aws_byte_cursor_from_buf(&uuid_buf);
+        ASSERT_SUCCESS(aws_uuid_init_from_str(&parsed, &uuid_cur));
+        ASSERT_TRUE(aws_uuid_equals(&random_uuid, &parsed));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(uuid_string_round_trip, s_uuid_string_round_trip_fn)
+
+static int s_uuid_array_to_str_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    struct aws_uuid uuids[3];
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(uuids); ++i) {
+        ASSERT_SUCCESS(aws_uuid_init(&uuids[i]));
+    }
+
+    uint8_t storage[1 + 3 * (AWS_UUID_STR_LEN - 1)] = {0};
+    struct aws_byte_buf output = aws_byte_buf_from_empty_array(storage, sizeof(storage) - 2);
+
+    /* one byte short: nothing is written */
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_uuid_array_to_str(uuids, 3, &output));
+    ASSERT_UINT_EQUALS(0, output.len);
+
+    output = aws_byte_buf_from_empty_array(storage, sizeof(storage));
+    output.len = 1;
+    ASSERT_SUCCESS(aws_uuid_array_to_str(uuids, 3, &output));
+    ASSERT_UINT_EQUALS(sizeof(storage), output.len);
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(uuids); ++i) {
+        uint8_t single[AWS_UUID_STR_LEN];
+        struct aws_byte_buf single_buf = aws_byte_buf_from_empty_array(single, sizeof(single));
+        ASSERT_SUCCESS(aws_uuid_to_str(&uuids[i], &single_buf));
+        ASSERT_BIN_ARRAYS_EQUALS(
+            single_buf.buffer, single_buf.len, storage + 1 + i * (AWS_UUID_STR_LEN - 1), AWS_UUID_STR_LEN - 1);
+    }
+
+    ASSERT_SUCCESS(aws_uuid_array_to_str(uuids, 0, &output));
+    ASSERT_UINT_EQUALS(sizeof(storage), output.len);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(uuid_array_to_str, s_uuid_array_to_str_fn)
+
+static uint64_t s_timestamp_ms(const uint8_t *data) {
+    uint64_t ms = 0;
+    for (size_t i = 0; i < 6; ++i) {
+        ms = ms << 8 | data[i];
+    }
+    return ms;
+}
+
+static int s_uuid_v7_layout_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    uint64_t before = 0;
+    ASSERT_SUCCESS(aws_sys_clock_get_ticks(&before));
+    struct aws_uuid uuid;
+    ASSERT_SUCCESS(aws_uuid_init_v7(&uuid));
+    uint64_t after = 0;
+    ASSERT_SUCCESS(aws_sys_clock_get_ticks(&after));
+
+    ASSERT_UINT_EQUALS(0x70, uuid.uuid_data[6] & 0xF0);
+    ASSERT_UINT_EQUALS(0x80, uuid.uuid_data[8] & 0xC0);
+
+    /* the timestamp can run ahead of the clock by the values already handed out this millisecond, but not behind */
+    uint64_t ms = s_timestamp_ms(uuid.uuid_data);
+    ASSERT_TRUE(ms >= before / 1000000);
+    ASSERT_TRUE(ms <= after / 1000000 + 1);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(uuid_v7_layout, s_uuid_v7_layout_fn)
+
+static int s_uuid_v7_monotonic_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_hash_table seen;
+    ASSERT_SUCCESS(aws_hash_table_init(&seen, allocator, 16, aws_hash_uuid, aws_hash_callback_uuid_eq, NULL, NULL));
+
+    /* far more than one millisecond's worth, so most of these share a timestamp with the one before */
+    struct aws_uuid uuids[5000];
+    for (size_t i = 0; i < 1000; ++i) {
+        ASSERT_SUCCESS(aws_uuid_init_v7(&uuids[i]));
+    }
+    ASSERT_SUCCESS(aws_uuid_init_v7_batch(uuids + 1000, 4000));
+    ASSERT_SUCCESS(aws_uuid_init_v7_batch(uuids, 0));
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(uuids); ++i) {
+        if (i > 0) {
+            ASSERT_TRUE(aws_uuid_compare(&uuids[i - 1], &uuids[i]) < 0);
+        }
+        ASSERT_UINT_EQUALS(0x70, uuids[i].uuid_data[6] & 0xF0);
+        ASSERT_UINT_EQUALS(0x80, uuids[i].uuid_data[8] & 0xC0);
+
+        int was_created = 0;
+        ASSERT_SUCCESS(aws_hash_table_put(&seen, &uuids[i], NULL, &was_created));
+        ASSERT_INT_EQUALS(1, was_created);
+    }
+
+    /* keys are found by value, not by address */
+    struct aws_uuid copy = uuids[1234];
+    struct aws_hash_element *found = NULL;
+    ASSERT_SUCCESS(aws_hash_table_find(&seen, &copy, &found));
+    ASSERT_NOT_NULL(found);
+    ASSERT_UINT_EQUALS(AWS_ARRAY_SIZE(uuids), aws_hash_table_get_entry_count(&seen));
+
+    aws_hash_table_clean_up(&seen);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(uuid_v7_monotonic, s_uuid_v7_monotonic_fn)
+
+static int s_ulid_string_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    /* the example from the ULID spec */
+    const char *ulid_str = "01ARZ3NDEKTSV4RRFFQ69G5FAV";
+    uint8_t expected_ulid[] = {
+        0x01, 0x56, 0x3e, 0x3a, 0xb5, 0xd3, 0xd6, 0x76, 0x4c, 0x61, 0xef, 0xb9, 0x93, 0x02, 0xbd, 0x5b};
+
+    struct aws_byte_cursor ulid_cur = aws_byte_cursor_from_c_str(ulid_str);
+    struct aws_ulid ulid;
+    ASSERT_SUCCESS(aws_ulid_init_from_str(&ulid, &ulid_cur));
+    ASSERT_BIN_ARRAYS_EQUALS(expected_ulid, sizeof(expected_ulid), ulid.ulid_data, sizeof(ulid.ulid_data));
+    ASSERT_UINT_EQUALS(1469922850259ULL, s_timestamp_ms(ulid.ulid_data));
+
+    uint8_t output[AWS_ULID_STR_LEN] = {0};
+    struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output, sizeof(output));
+    ASSERT_SUCCESS(aws_ulid_to_str(&ulid, &output_buf));
+    ASSERT_BIN_ARRAYS_EQUALS(ulid_str, AWS_ULID_STR_LEN - 1, output_buf.buffer, output_buf.len);
+    ASSERT_UINT_EQUALS(0, output[AWS_ULID_STR_LEN - 1]);
+
+    /* lowercase, and the letters Crockford base32 reads as digits */
+    struct aws_ulid aliased;
+    ulid_cur = aws_byte_cursor_from_c_str("oLarz3ndektsv4rrffq69g5fav");
+    ASSERT_SUCCESS(aws_ulid_init_from_str(&aliased, &ulid_cur));
+    ASSERT_TRUE(aws_ulid_equals(&ulid, &aliased));
+
+    struct aws_ulid max;
+    memset(max.ulid_data, 0xFF, sizeof(max.ulid_data));
+    output_buf.len = 0;
+    ASSERT_SUCCESS(aws_ulid_to_str(&max, &output_buf));
+    ASSERT_BIN_ARRAYS_EQUALS("7ZZZZZZZZZZZZZZZZZZZZZZZZZ", AWS_ULID_STR_LEN - 1, output_buf.buffer, output_buf.len);
+
+    static const char *s_invalid[] = {
+        "81ARZ3NDEKTSV4RRFFQ69G5FAV",
+        "01ARZ3NDEKTSV4RRFFQ69G5FAU",
+        "01ARZ3NDEKTSV4RRFFQ69G5FA-",
+    };
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_invalid); ++i) {
+        ulid_cur = aws_byte_cursor_from_c_str(s_invalid[i]);
+        ASSERT_ERROR(AWS_ERROR_MALFORMED_INPUT_STRING, aws_ulid_init_from_str(&ulid, &ulid_cur));
+    }
+    ulid_cur = aws_byte_cursor_from_c_str("01ARZ3NDEKTSV4RRFFQ69G5FA");
+    ASSERT_ERROR(AWS_ERROR_INVALID_BUFFER_SIZE, aws_ulid_init_from_str(&ulid, &ulid_cur));
+
+    output_buf = aws_byte_buf_from_empty_array(output, sizeof(output) - 1);
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_ulid_to_str(&ulid, &output_buf));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ulid_string, s_ulid_string_fn)
+
+static int s_ulid_monotonic_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    struct aws_ulid ulids[3000];
+    for (size_t i = 0; i < 1000; ++i) {
+        ASSERT_SUCCESS(aws_ulid_init(&ulids[i]));
+    }
+    ASSERT_SUCCESS(aws_ulid_init_batch(ulids + 1000, 2000));
+
+    uint8_t previous_str[AWS_ULID_STR_LEN] = {0};
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(ulids); ++i) {
+        uint8_t str[AWS_ULID_STR_LEN] = {0};
+        struct aws_byte_buf str_buf = aws_byte_buf_from_empty_array(str, sizeof(str));
+        ASSERT_SUCCESS(aws_ulid_to_str(&ulids[i], &str_buf));
+
+        /* the strings sort the same way as the bytes */
+        if (i > 0) {
+            ASSERT_TRUE(aws_ulid_compare(&ulids[i - 1], &ulids[i]) < 0);
+            ASSERT_TRUE(memcmp(previous_str, str, sizeof(str)) < 0);
+        }
+        memcpy(previous_str, str, sizeof(str));
+
+        struct aws_byte_cursor str_cur = aws_byte_cursor_from_buf(&str_buf);
+        struct aws_ulid parsed;
+        ASSERT_SUCCESS(aws_ulid_init_from_str(&parsed, &str_cur));
+        ASSERT_TRUE(aws_hash_callback_ulid_eq(&parsed, &ulids[i]));
+        ASSERT_UINT_EQUALS(aws_hash_ulid(&parsed), aws_hash_ulid(&ulids[i]));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ulid_monotonic, s_ulid_monotonic_fn)